@@ -0,0 +1,83 @@
+#include "alloc_stats.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::uint64_t> g_allocations{0};
+std::atomic<std::int64_t> g_live_bytes{0};
+
+// Each block carries its size in a header so frees can be accounted without sized delete.
+constexpr std::size_t kHeader = alignof(std::max_align_t);
+
+void* counted_alloc(std::size_t size) {
+  auto* p = static_cast<unsigned char*>(std::malloc(size + kHeader));
+  if (!p) throw std::bad_alloc();
+  *reinterpret_cast<std::size_t*>(p) = size;
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_live_bytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+  return p + kHeader;
+}
+
+void counted_free(void* ptr) noexcept {
+  if (!ptr) return;
+  auto* p = static_cast<unsigned char*>(ptr) - kHeader;
+  g_live_bytes.fetch_sub(static_cast<std::int64_t>(*reinterpret_cast<std::size_t*>(p)), std::memory_order_relaxed);
+  std::free(p);
+}
+
+// Over-aligned variant (std::pmr::new_delete_resource allocates through it): the header grows to the
+// alignment so the block after it stays aligned.
+void* counted_aligned_alloc(std::size_t size, std::size_t alignment) {
+  const std::size_t header = alignment > kHeader ? alignment : kHeader;
+  const std::size_t total = (size + header + header - 1) / header * header;
+  auto* p = static_cast<unsigned char*>(std::aligned_alloc(header, total));
+  if (!p) throw std::bad_alloc();
+  *reinterpret_cast<std::size_t*>(p) = size;
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_live_bytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+  return p + header;
+}
+
+void counted_aligned_free(void* ptr, std::size_t alignment) noexcept {
+  if (!ptr) return;
+  const std::size_t header = alignment > kHeader ? alignment : kHeader;
+  auto* p = static_cast<unsigned char*>(ptr) - header;
+  g_live_bytes.fetch_sub(static_cast<std::int64_t>(*reinterpret_cast<std::size_t*>(p)), std::memory_order_relaxed);
+  std::free(p);
+}
+
+} // namespace
+
+namespace flight::bench {
+
+AllocStats alloc_stats() noexcept {
+  return AllocStats{g_allocations.load(std::memory_order_relaxed), g_live_bytes.load(std::memory_order_relaxed)};
+}
+
+} // namespace flight::bench
+
+void* operator new(std::size_t size) { return counted_alloc(size); }
+void* operator new[](std::size_t size) { return counted_alloc(size); }
+void operator delete(void* ptr) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr) noexcept { counted_free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { counted_free(ptr); }
+void* operator new(std::size_t size, std::align_val_t al) {
+  return counted_aligned_alloc(size, static_cast<std::size_t>(al));
+}
+void* operator new[](std::size_t size, std::align_val_t al) {
+  return counted_aligned_alloc(size, static_cast<std::size_t>(al));
+}
+void operator delete(void* ptr, std::align_val_t al) noexcept { counted_aligned_free(ptr, static_cast<std::size_t>(al)); }
+void operator delete[](void* ptr, std::align_val_t al) noexcept {
+  counted_aligned_free(ptr, static_cast<std::size_t>(al));
+}
+void operator delete(void* ptr, std::size_t, std::align_val_t al) noexcept {
+  counted_aligned_free(ptr, static_cast<std::size_t>(al));
+}
+void operator delete[](void* ptr, std::size_t, std::align_val_t al) noexcept {
+  counted_aligned_free(ptr, static_cast<std::size_t>(al));
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Heap accounting for benchmarks. The benchmark binary replaces global operator new/delete
+// (see alloc_stats.cpp) so every allocation in the process is counted.
+namespace flight::bench {
+
+struct AllocStats {
+  std::uint64_t allocations{0};
+  std::int64_t live_bytes{0};
+};
+
+AllocStats alloc_stats() noexcept;
+
+} // namespace flight::bench
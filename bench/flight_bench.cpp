@@ -0,0 +1,419 @@
+#include "alloc_stats.hpp"
+
+#include "flight/application/booking_service.hpp"
+#include "flight/domain/flight.hpp"
+#include "flight/domain/reservation.hpp"
+#include "flight/infrastructure/atomic_id_generator.hpp"
+#include "flight/infrastructure/flight_repository_factory.hpp"
+#include "flight/infrastructure/in_memory_reservation_repository.hpp"
+#include "flight/infrastructure/snowflake_id_generator.hpp"
+#include "flight/infrastructure/system_clock.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Repository and service benchmark matrix: every flight repository type x catalog size x thread count x
+// contention profile (uniform flights vs. one hot flight). Each operation runs as its own timed phase on
+// all threads; results (throughput, p50/p99/p999 latency) go to stdout as JSON, progress to stderr.
+//
+//   bin/flight_bench [--repos=inmem,lockfree,sqlite,sqlite-file] [--flights=1000,10000] [--threads=1,4]
+//                    [--profiles=uniform,hot] [--ops=10000]
+//
+// --ops is per thread and per operation.
+
+namespace {
+
+using namespace flight;
+using bench_clock = std::chrono::steady_clock;
+
+constexpr int kFlightsPerRoute = 10;
+constexpr std::uint16_t kRows = 30;
+constexpr std::uint8_t kSeatsPerRow = 6;
+constexpr int kOrders = 1000;
+constexpr std::size_t kArenaBytes = 16 * 1024;
+
+enum class Profile { Uniform, Hot };
+
+struct Options {
+  std::vector<std::string> repos{"inmem", "lockfree", "sqlite", "sqlite-file"};
+  std::vector<int> flights{1000, 10000};
+  std::vector<int> threads{1, 4};
+  std::vector<Profile> profiles{Profile::Uniform, Profile::Hot};
+  int ops{10000};
+};
+
+struct OpResult {
+  std::string op;
+  std::size_t ops{0};
+  std::size_t ok{0}; // operations that succeeded (booked, found, released)
+  double seconds{0};
+  std::vector<std::int64_t> ns;
+  std::uint64_t allocations{0}; // heap allocations made by the timed calls, on all threads
+};
+
+const char* to_string(Profile p) { return p == Profile::Hot ? "hot" : "uniform"; }
+
+std::vector<std::string> split(std::string_view csv) {
+  std::vector<std::string> out;
+  while (!csv.empty()) {
+    const auto comma = csv.find(',');
+    out.emplace_back(csv.substr(0, comma));
+    if (comma == std::string_view::npos) break;
+    csv.remove_prefix(comma + 1);
+  }
+  return out;
+}
+
+std::vector<int> split_ints(std::string_view csv) {
+  std::vector<int> out;
+  for (const auto& s : split(csv)) out.push_back(std::stoi(s));
+  return out;
+}
+
+Options parse_options(int argc, char** argv) {
+  Options o;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg(argv[i]);
+    const auto eq = arg.find('=');
+    const auto name = arg.substr(0, eq);
+    const auto value = eq == std::string_view::npos ? std::string_view{} : arg.substr(eq + 1);
+    if (name == "--repos") {
+      o.repos = split(value);
+      for (const auto& r : o.repos) infrastructure::parse_flight_repo_type(r); // throws on unknown names
+    } else if (name == "--flights") {
+      o.flights = split_ints(value);
+    } else if (name == "--threads") {
+      o.threads = split_ints(value);
+    } else if (name == "--profiles") {
+      o.profiles.clear();
+      for (const auto& p : split(value)) {
+        if (p != "uniform" && p != "hot") throw std::invalid_argument("Unknown profile: " + p + " (use uniform|hot)");
+        o.profiles.push_back(p == "hot" ? Profile::Hot : Profile::Uniform);
+      }
+    } else if (name == "--ops") {
+      o.ops = std::stoi(std::string(value));
+    } else {
+      throw std::invalid_argument("Unknown option: " + std::string(arg));
+    }
+  }
+  return o;
+}
+
+domain::AirportCode route_airport(int route, int which) {
+  const int n = route * 2 + which;
+  const char code[3] = {static_cast<char>('A' + n / 676 % 26), static_cast<char>('A' + n / 26 % 26),
+                        static_cast<char>('A' + n % 26)};
+  return domain::AirportCode(std::string_view(code, 3));
+}
+
+// Per-thread choice of flights/seats/orders for the contention profile. Flight i+1 flies route i % routes;
+// the hot profile sends every flight operation to flight 1 (and every search to its route).
+class Picker {
+public:
+  Picker(Profile profile, int flights, unsigned seed)
+      : profile_(profile), flights_(flights), routes_(std::max(1, flights / kFlightsPerRoute)), rng_(seed) {}
+
+  int flight_index() { return profile_ == Profile::Hot ? 0 : uniform(flights_); }
+  domain::FlightId flight() { return domain::FlightId{static_cast<std::uint64_t>(flight_index() + 1)}; }
+  int route() { return flight_index() % routes_; }
+  domain::Seat seat() {
+    return domain::Seat{static_cast<std::uint16_t>(uniform(kRows) + 1), static_cast<char>('A' + uniform(kSeatsPerRow))};
+  }
+  domain::OrderId order() { return domain::OrderId{static_cast<std::uint64_t>(uniform(kOrders) + 1)}; }
+
+private:
+  int uniform(int n) { return static_cast<int>(rng_() % static_cast<std::uint64_t>(n)); }
+
+  Profile profile_;
+  int flights_;
+  int routes_;
+  std::mt19937_64 rng_;
+};
+
+// Runs `ops` calls of body(thread, i) -> bool on each of `threads` threads, released together, and
+// times and counts the heap allocations of every call.
+template <typename Fn>
+OpResult run_op(const char* op, int threads, int ops, Fn&& body) {
+  std::vector<std::vector<std::int64_t>> latencies(static_cast<std::size_t>(threads));
+  std::vector<std::size_t> ok(static_cast<std::size_t>(threads), 0);
+  std::atomic<int> ready{0};
+  std::atomic<bool> go{false};
+
+  std::vector<std::thread> pool;
+  for (int t = 0; t < threads; ++t) {
+    pool.emplace_back([&, t] {
+      auto& ns = latencies[static_cast<std::size_t>(t)];
+      ns.reserve(static_cast<std::size_t>(ops));
+      ready.fetch_add(1);
+      while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+      for (int i = 0; i < ops; ++i) {
+        const auto start = bench_clock::now();
+        const bool success = body(t, i);
+        ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - start).count());
+        ok[static_cast<std::size_t>(t)] += success ? 1 : 0;
+      }
+    });
+  }
+  while (ready.load() != threads) std::this_thread::yield();
+  const auto allocations_before = flight::bench::alloc_stats().allocations;
+  const auto start = bench_clock::now();
+  go.store(true, std::memory_order_release);
+  for (auto& th : pool) th.join();
+  const std::chrono::duration<double> elapsed = bench_clock::now() - start;
+
+  OpResult r{op, 0, 0, elapsed.count(), {}, flight::bench::alloc_stats().allocations - allocations_before};
+  for (std::size_t t = 0; t < latencies.size(); ++t) {
+    r.ok += ok[t];
+    r.ns.insert(r.ns.end(), latencies[t].begin(), latencies[t].end());
+  }
+  r.ops = r.ns.size();
+  return r;
+}
+
+std::int64_t percentile(const std::vector<std::int64_t>& sorted, double q) {
+  if (sorted.empty()) return 0;
+  const auto i = std::min(sorted.size() - 1, static_cast<std::size_t>(q * static_cast<double>(sorted.size())));
+  return sorted[i];
+}
+
+class JsonOut {
+public:
+  void scenario(const std::string& repo, int flights, int threads, Profile profile, OpResult& r) {
+    std::sort(r.ns.begin(), r.ns.end());
+    std::printf("%s    {\"repo\": \"%s\", \"flights\": %d, \"threads\": %d, \"profile\": \"%s\", \"op\": \"%s\", "
+                "\"ops\": %zu, \"ok\": %zu, \"throughput_ops_s\": %.0f, \"p50_ns\": %lld, \"p99_ns\": %lld, "
+                "\"p999_ns\": %lld, \"allocs_per_op\": %.2f}",
+                first_ ? "" : ",\n", repo.c_str(), flights, threads, to_string(profile), r.op.c_str(), r.ops, r.ok,
+                r.seconds > 0 ? static_cast<double>(r.ops) / r.seconds : 0.0,
+                static_cast<long long>(percentile(r.ns, 0.50)), static_cast<long long>(percentile(r.ns, 0.99)),
+                static_cast<long long>(percentile(r.ns, 0.999)),
+                r.ops > 0 ? static_cast<double>(r.allocations) / static_cast<double>(r.ops) : 0.0);
+    first_ = false;
+  }
+
+private:
+  bool first_{true};
+};
+
+infrastructure::FlightRepoConfig bench_config() {
+  infrastructure::FlightRepoConfig config;
+  config.sqlite_file.path = (std::filesystem::temp_directory_path() / "flight_bench.db").string();
+  return config;
+}
+
+void remove_database(const std::string& path) {
+  for (const char* suffix : {"", "-wal", "-shm"}) std::filesystem::remove(path + suffix);
+}
+
+void run_scenario(JsonOut& json, const std::string& repo_name, int flights, int threads, Profile profile,
+                  int ops) {
+  std::fprintf(stderr, "%-12s flights=%-6d threads=%-3d %s\n", repo_name.c_str(), flights, threads,
+               to_string(profile));
+  const auto config = bench_config();
+  remove_database(config.sqlite_file.path);
+  auto repo = infrastructure::make_flight_repository(infrastructure::parse_flight_repo_type(repo_name), config);
+  infrastructure::InMemoryReservationRepository reservations;
+  infrastructure::AtomicIdGenerator ids;
+  infrastructure::SystemClock clock;
+  application::BookingService booking{*repo, reservations, ids, clock};
+  const int routes = std::max(1, flights / kFlightsPerRoute);
+  const auto departure = std::chrono::system_clock::now();
+
+  auto emit = [&](OpResult r) { json.scenario(repo_name, flights, threads, profile, r); };
+
+  // Catalog load is single-threaded; it is reported once per catalog, with the 1-thread scenarios.
+  auto upsert = run_op("upsert", 1, flights, [&](int, int i) {
+    const int route = i % routes;
+    repo->upsert(domain::Flight(domain::FlightId{static_cast<std::uint64_t>(i + 1)}, route_airport(route, 0),
+                                route_airport(route, 1), departure + std::chrono::minutes(i), kRows, kSeatsPerRow));
+    return true;
+  });
+  if (threads == 1) emit(std::move(upsert));
+
+  std::vector<Picker> pickers;
+  for (int t = 0; t < threads; ++t) pickers.emplace_back(profile, flights, static_cast<unsigned>(t + 1));
+
+  emit(run_op("search", threads, ops, [&](int t, int) {
+    const int route = pickers[static_cast<std::size_t>(t)].route();
+    return !repo->search({route_airport(route, 0), route_airport(route, 1)}).empty();
+  }));
+
+  // The same searches with the result in a per-call arena over a per-thread buffer: no heap allocation unless
+  // a result outgrows the buffer.
+  std::vector<std::vector<std::byte>> arenas(static_cast<std::size_t>(threads), std::vector<std::byte>(kArenaBytes));
+  emit(run_op("search_in_arena", threads, ops, [&](int t, int) {
+    const int route = pickers[static_cast<std::size_t>(t)].route();
+    auto& buffer = arenas[static_cast<std::size_t>(t)];
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+    return !repo->search_in({route_airport(route, 0), route_airport(route, 1)}, &arena).empty();
+  }));
+
+  emit(run_op("search_summaries", threads, ops, [&](int t, int) {
+    const int route = pickers[static_cast<std::size_t>(t)].route();
+    return !repo->search_summaries({route_airport(route, 0), route_airport(route, 1)}).empty();
+  }));
+
+  emit(run_op("search_summaries_in_arena", threads, ops, [&](int t, int) {
+    const int route = pickers[static_cast<std::size_t>(t)].route();
+    auto& buffer = arenas[static_cast<std::size_t>(t)];
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+    return !repo->search_summaries_in({route_airport(route, 0), route_airport(route, 1)}, &arena).empty();
+  }));
+
+  emit(run_op("get", threads, ops, [&](int t, int) {
+    return repo->get(pickers[static_cast<std::size_t>(t)].flight()).has_value();
+  }));
+
+  // The searches again while a background thread books and releases seats nonstop on the same flights: search
+  // latency should not follow the booking rate.
+  {
+    std::atomic<bool> stop{false};
+    std::thread booker([&] {
+      Picker pick(profile, flights, 0);
+      while (!stop.load(std::memory_order_relaxed)) {
+        const auto id = pick.flight();
+        const auto seat = pick.seat();
+        if (repo->try_book_seat(id, seat)) repo->release_seat(id, seat);
+      }
+    });
+    emit(run_op("search_while_booking", threads, ops, [&](int t, int) {
+      const int route = pickers[static_cast<std::size_t>(t)].route();
+      return !repo->search({route_airport(route, 0), route_airport(route, 1)}).empty();
+    }));
+    stop.store(true);
+    booker.join();
+  }
+
+  // Every pick of the booking phase is released in the next one (a no-op where another thread won the seat),
+  // so the service phase starts from an empty catalog.
+  struct Pick {
+    domain::FlightId flight;
+    domain::Seat seat;
+    bool booked;
+  };
+  std::vector<std::vector<Pick>> picks(static_cast<std::size_t>(threads));
+  for (auto& p : picks) p.reserve(static_cast<std::size_t>(ops));
+  emit(run_op("try_book_seat", threads, ops, [&](int t, int) {
+    auto& pick = pickers[static_cast<std::size_t>(t)];
+    const auto id = pick.flight();
+    const auto seat = pick.seat();
+    const bool booked = repo->try_book_seat(id, seat);
+    picks[static_cast<std::size_t>(t)].push_back(Pick{id, seat, booked});
+    return booked;
+  }));
+
+  emit(run_op("release_seat", threads, ops, [&](int t, int i) {
+    const auto& p = picks[static_cast<std::size_t>(t)][static_cast<std::size_t>(i)];
+    repo->release_seat(p.flight, p.seat);
+    return p.booked;
+  }));
+
+  emit(run_op("book_seat", threads, ops, [&](int t, int) {
+    auto& pick = pickers[static_cast<std::size_t>(t)];
+    return booking.book_seat({pick.flight(), pick.order(), pick.seat()}).success;
+  }));
+
+  emit(run_op("list_by_order", threads, ops, [&](int t, int) {
+    return !reservations.list_by_order(pickers[static_cast<std::size_t>(t)].order()).empty();
+  }));
+
+  repo.reset();
+  remove_database(config.sqlite_file.path);
+}
+
+// Heap footprint of the reservation store (100k reservations: 10k orders of 10 seats over 1000 flights).
+void bench_reservation_memory() {
+  constexpr int kReservations = 100'000;
+  constexpr int kMemOrders = 10'000;
+  constexpr int kMemFlights = 1000;
+
+  const auto before = flight::bench::alloc_stats();
+  infrastructure::InMemoryReservationRepository reservations;
+  const auto created_at = std::chrono::system_clock::now();
+  for (int i = 0; i < kReservations; ++i) {
+    reservations.add(domain::Reservation(domain::ReservationId{static_cast<std::uint64_t>(i + 1)},
+                                         domain::OrderId{static_cast<std::uint64_t>(i % kMemOrders + 1)},
+                                         domain::FlightId{static_cast<std::uint64_t>(i % kMemFlights + 1)},
+                                         domain::Seat{static_cast<std::uint16_t>(i / 6 % 30 + 1),
+                                                      static_cast<char>('A' + i % 6)},
+                                         created_at));
+  }
+  const auto after = flight::bench::alloc_stats();
+  std::printf("  \"reservation_memory\": {\"reservations\": %d, \"bytes_per_reservation\": %.1f},\n", kReservations,
+              static_cast<double>(after.live_bytes - before.live_bytes) / kReservations);
+}
+
+// Id throughput per generator and thread count. Untimed per call: a clock read would cost more than an id.
+void bench_id_generators(const std::vector<int>& thread_counts) {
+  constexpr int kIdsPerThread = 1'000'000;
+  infrastructure::SystemClock clock;
+  std::printf("  \"id_generators\": [");
+  bool first = true;
+  for (const int threads : thread_counts) {
+    for (const char* kind : {"seq", "seq_block256", "snowflake"}) {
+      std::unique_ptr<application::IIdGenerator> ids;
+      if (std::string_view(kind) == "snowflake") {
+        ids = std::make_unique<infrastructure::SnowflakeIdGenerator>(1, clock);
+      } else {
+        ids = std::make_unique<infrastructure::AtomicIdGenerator>(1, 1, 1, std::string_view(kind) == "seq" ? 1 : 256);
+      }
+      std::atomic<std::uint64_t> sink{0};
+      std::vector<std::thread> pool;
+      const auto start = bench_clock::now();
+      for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&] {
+          std::uint64_t x = 0;
+          for (int i = 0; i < kIdsPerThread; ++i) x ^= ids->next_reservation_id().value();
+          sink.fetch_xor(x, std::memory_order_relaxed);
+        });
+      }
+      for (auto& th : pool) th.join();
+      const std::chrono::duration<double> elapsed = bench_clock::now() - start;
+      std::printf("%s\n    {\"generator\": \"%s\", \"threads\": %d, \"ids_per_s\": %.0f}", first ? "" : ",", kind,
+                  threads, static_cast<double>(kIdsPerThread) * threads / elapsed.count());
+      first = false;
+    }
+  }
+  std::printf("\n  ],\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  try {
+    options = parse_options(argc, argv);
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "flight_bench: %s\n", e.what());
+    return 2;
+  }
+
+  std::printf("{\n");
+  bench_reservation_memory();
+  bench_id_generators(options.threads);
+  std::printf("  \"ops_per_thread\": %d,\n  \"results\": [\n", options.ops);
+  JsonOut json;
+  for (const auto& repo : options.repos) {
+    for (const int flights : options.flights) {
+      for (const int threads : options.threads) {
+        for (const auto profile : options.profiles) run_scenario(json, repo, flights, threads, profile, options.ops);
+      }
+    }
+  }
+  std::printf("\n  ]\n}\n");
+  return 0;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "flight/application/booking_service.hpp"
+#include "flight/util/bounded_queue.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace flight::application {
+
+struct AsyncBookingOptions {
+  std::size_t workers{4};
+  // Commands accepted but not yet picked up by a worker; past it, submit() waits and try_submit() rejects.
+  std::size_t queue_capacity{4096};
+  // Commands a worker takes from the queue at once and books with one BookingService::book_seat_batch().
+  std::size_t max_batch{64};
+};
+
+// Asynchronous front end for BookingService::book_seat(). Callers enqueue commands into a bounded queue and
+// get a future (or a completion callback); a fixed pool of workers drains the queue in batches, so under a
+// burst a handful of threads take the repository locks, each holding them once per batch, instead of every
+// caller contending. Backpressure is explicit: submit() waits while the queue is full, try_submit() refuses.
+class AsyncBookingService final {
+public:
+  // Runs on a worker thread; must not throw, and should not block for long (it delays the rest of the batch).
+  using Callback = std::function<void(BookSeatResult)>;
+
+  // `booking` must outlive this service. Throws std::invalid_argument for zero workers/capacity/batch.
+  explicit AsyncBookingService(BookingService& booking, AsyncBookingOptions options = {});
+  // Stops accepting commands, completes everything already queued, then joins the workers.
+  ~AsyncBookingService();
+
+  AsyncBookingService(const AsyncBookingService&) = delete;
+  AsyncBookingService& operator=(const AsyncBookingService&) = delete;
+
+  // Waits while the queue is full.
+  std::future<BookSeatResult> submit(const BookSeatCommand& cmd);
+  void submit(const BookSeatCommand& cmd, Callback done);
+
+  // Never waits: nullopt / false when the queue is full (the command is not booked and `done` is not called).
+  std::optional<std::future<BookSeatResult>> try_submit(const BookSeatCommand& cmd);
+  bool try_submit(const BookSeatCommand& cmd, Callback done);
+
+  std::size_t queue_depth() const { return queue_.size(); }
+
+private:
+  struct Pending {
+    BookSeatCommand cmd;
+    Callback done;
+    std::chrono::steady_clock::time_point enqueued;
+  };
+
+  void run();
+
+  BookingService& booking_;
+  const AsyncBookingOptions options_;
+  flight::util::BoundedQueue<Pending> queue_;
+  std::vector<std::thread> workers_;
+};
+
+} // namespace flight::application
@@ -1,13 +1,18 @@
 #pragma once
 
+#include "flight/application/change_groups.hpp"
 #include "flight/application/clock.hpp"
 #include "flight/application/flight_repository.hpp"
 #include "flight/application/id_generator.hpp"
 #include "flight/application/reservation_repository.hpp"
 #include "flight/domain/reservation.hpp"
+#include "flight/util/metrics.hpp"
 
+#include <cstddef>
 #include <optional>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace flight::application {
 
@@ -23,18 +28,50 @@ struct BookSeatResult {
   std::string error;
 };
 
+// Books whichever seat the repository picks (the first free one).
+struct BookAnySeatCommand {
+  flight::domain::FlightId flight_id;
+  flight::domain::OrderId order_id;
+};
+
+// Group booking on one flight: all seats are reserved or none are.
+struct BookSeatsCommand {
+  flight::domain::FlightId flight_id;
+  flight::domain::OrderId order_id;
+  std::vector<flight::domain::Seat> seats;
+};
+
+// Group of `seat_count` seated together; the repository picks the seats.
+struct BookAdjacentSeatsCommand {
+  flight::domain::FlightId flight_id;
+  flight::domain::OrderId order_id;
+  std::size_t seat_count{0};
+};
+
+struct BookSeatsResult {
+  bool success{false};
+  std::vector<flight::domain::Reservation> reservations;
+  std::string error;
+};
+
 class BookingService final {
 public:
+  // With `groups`, each single-flight booking and its reservations are made durable as one unit.
   BookingService(IFlightRepository& flights,
                  IReservationRepository& reservations,
                  IIdGenerator& ids,
-                 const IClock& clock)
-      : flights_(flights), reservations_(reservations), ids_(ids), clock_(clock) {}
+                 const IClock& clock,
+                 IChangeGroups* groups = nullptr)
+      : flights_(flights), reservations_(reservations), ids_(ids), clock_(clock), groups_(groups) {}
 
   // Thread-safe as long as repositories are thread-safe.
   BookSeatResult book_seat(const BookSeatCommand& cmd) {
+    FLIGHT_METRICS_TIME(timer, "flight_booking_op_seconds", "op=\"book_seat\"", "Latency of BookingService calls.");
+    ChangeGroup group(groups_, cmd.flight_id);
     // 1) Atomically book in flight repo (prevents double booking under contention)
     if (!flights_.try_book_seat(cmd.flight_id, cmd.seat)) {
+      FLIGHT_METRICS_COUNT("flight_booking_failures_total", "op=\"book_seat\"",
+                           "Bookings rejected by the repository.");
       return BookSeatResult{false, std::nullopt, "Seat not available or invalid"};
     }
 
@@ -44,13 +81,131 @@ public:
 
     // 3) Persist reservation.
     reservations_.add(res);
+    group.commit();
+
+    return BookSeatResult{true, res, {}};
+  }
+
+  // book_seat() for many independent commands: one batched repository booking, then one add_many() for all
+  // reservations. results[i] belongs to commands[i], and each command succeeds or fails on its own. With
+  // `groups`, the whole batch (bookings and reservations) is one change group. If the reservations cannot be
+  // created, the seats this call booked are released before the exception propagates.
+  std::vector<BookSeatResult> book_seat_batch(std::span<const BookSeatCommand> commands) {
+    FLIGHT_METRICS_TIME(timer, "flight_booking_op_seconds", "op=\"book_seat_batch\"",
+                        "Latency of BookingService calls.");
+    std::vector<SeatBookingRequest> requests;
+    std::vector<flight::domain::FlightId> flight_ids;
+    requests.reserve(commands.size());
+    flight_ids.reserve(commands.size());
+    for (const auto& cmd : commands) {
+      requests.push_back(SeatBookingRequest{cmd.flight_id, cmd.seat});
+      flight_ids.push_back(cmd.flight_id);
+    }
+    ChangeGroup group(groups_, flight_ids);
+    const auto booked = flights_.try_book_seat_batch(requests);
+
+    const auto created_at = clock_.now();
+    std::vector<BookSeatResult> results;
+    results.reserve(commands.size());
+    std::vector<flight::domain::Reservation> reservations;
+    try {
+      for (std::size_t i = 0; i < commands.size(); ++i) {
+        if (!booked[i]) {
+          FLIGHT_METRICS_COUNT("flight_booking_failures_total", "op=\"book_seat\"",
+                               "Bookings rejected by the repository.");
+          results.push_back(BookSeatResult{false, std::nullopt, "Seat not available or invalid"});
+          continue;
+        }
+        const auto& cmd = commands[i];
+        reservations.emplace_back(ids_.next_reservation_id(), cmd.order_id, cmd.flight_id, cmd.seat, created_at);
+        results.push_back(BookSeatResult{true, reservations.back(), {}});
+      }
+      if (!reservations.empty()) reservations_.add_many(std::move(reservations));
+    } catch (...) {
+      for (std::size_t i = 0; i < commands.size(); ++i) {
+        if (booked[i]) flights_.release_seat(commands[i].flight_id, commands[i].seat);
+      }
+      throw;
+    }
+    group.commit();
+
+    return results;
+  }
+
+  // Server-side seat selection: the repository picks and books a free seat in one atomic step, so
+  // callers do not need to guess a seat and retry on conflict.
+  BookSeatResult book_any_seat(const BookAnySeatCommand& cmd) {
+    FLIGHT_METRICS_TIME(timer, "flight_booking_op_seconds", "op=\"book_any_seat\"",
+                        "Latency of BookingService calls.");
+    ChangeGroup group(groups_, cmd.flight_id);
+    const auto seat = flights_.book_any_seat(cmd.flight_id);
+    if (!seat) {
+      return BookSeatResult{false, std::nullopt, "Flight is full or does not exist"};
+    }
+
+    const auto res = flight::domain::Reservation(
+        ids_.next_reservation_id(), cmd.order_id, cmd.flight_id, *seat, clock_.now());
+    reservations_.add(res);
+    group.commit();
 
     return BookSeatResult{true, res, {}};
   }
 
+  // All-or-nothing: one atomic repository call books the whole group, then all reservations are
+  // persisted in one batch.
+  BookSeatsResult book_seats(const BookSeatsCommand& cmd) {
+    FLIGHT_METRICS_TIME(timer, "flight_booking_op_seconds", "op=\"book_seats\"", "Latency of BookingService calls.");
+    if (cmd.seats.empty()) {
+      return BookSeatsResult{false, {}, "No seats requested"};
+    }
+    ChangeGroup group(groups_, cmd.flight_id);
+    if (!flights_.try_book_seats(cmd.flight_id, cmd.seats)) {
+      return BookSeatsResult{false, {}, "One or more seats not available or invalid"};
+    }
+
+    const auto created_at = clock_.now();
+    std::vector<flight::domain::Reservation> reservations;
+    reservations.reserve(cmd.seats.size());
+    for (const auto& seat : cmd.seats) {
+      reservations.emplace_back(ids_.next_reservation_id(), cmd.order_id, cmd.flight_id, seat, created_at);
+    }
+
+    reservations_.add_many(reservations);
+    group.commit();
+
+    return BookSeatsResult{true, std::move(reservations), {}};
+  }
+
+  // Books a group together in one atomic repository call (adjacent in one row, else the nearest split).
+  BookSeatsResult book_adjacent_seats(const BookAdjacentSeatsCommand& cmd) {
+    FLIGHT_METRICS_TIME(timer, "flight_booking_op_seconds", "op=\"book_adjacent_seats\"",
+                        "Latency of BookingService calls.");
+    if (cmd.seat_count == 0) {
+      return BookSeatsResult{false, {}, "No seats requested"};
+    }
+    ChangeGroup group(groups_, cmd.flight_id);
+    const auto seats = flights_.book_adjacent_seats(cmd.flight_id, cmd.seat_count);
+    if (seats.empty()) {
+      return BookSeatsResult{false, {}, "Not enough free seats, flight does not exist, or seats contended (retry)"};
+    }
+
+    const auto created_at = clock_.now();
+    std::vector<flight::domain::Reservation> reservations;
+    reservations.reserve(seats.size());
+    for (const auto& seat : seats) {
+      reservations.emplace_back(ids_.next_reservation_id(), cmd.order_id, cmd.flight_id, seat, created_at);
+    }
+
+    reservations_.add_many(reservations);
+    group.commit();
+
+    return BookSeatsResult{true, std::move(reservations), {}};
+  }
+
   // Simple cancel by reservation id: releases the seat and (for v1) does not delete reservation.
   // In real systems you'd track reservation status.
   bool cancel(const flight::domain::ReservationId reservation_id) {
+    FLIGHT_METRICS_TIME(timer, "flight_booking_op_seconds", "op=\"cancel\"", "Latency of BookingService calls.");
     const auto res = reservations_.get(reservation_id);
     if (!res) return false;
     flights_.release_seat(res->flight_id(), res->seat());
@@ -62,6 +217,7 @@ private:
   IReservationRepository& reservations_;
   IIdGenerator& ids_;
   const IClock& clock_;
+  IChangeGroups* groups_;
 };
 
 } // namespace flight::application
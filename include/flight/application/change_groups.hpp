@@ -0,0 +1,53 @@
+#pragma once
+
+#include "flight/domain/ids.hpp"
+
+#include <span>
+
+namespace flight::application {
+
+// Optional port for use cases that change more than one repository for one request, e.g. a seat booking and its
+// reservation. The changes a thread makes between begin_group() and commit_group() become durable together, as
+// one unit: a crash keeps all of them or none. Backends without durability have nothing to group.
+class IChangeGroups {
+public:
+  virtual ~IChangeGroups() = default;
+
+  // Opens a group on the calling thread for changes to the flights in `flight_ids` (repeats allowed) and to
+  // reservations. Groups do not nest, and other flights must not be changed inside one.
+  virtual void begin_group(std::span<const flight::domain::FlightId> flight_ids) = 0;
+  // Closes the group (even if it throws); returns once its changes are durable.
+  virtual void commit_group() = 0;
+  // Closes the group without waiting for durability (the use case failed part way). What was applied stays
+  // applied and is still recorded as one unit.
+  virtual void end_group() noexcept = 0;
+};
+
+// Scope of one change group; does nothing without an IChangeGroups.
+class ChangeGroup final {
+public:
+  ChangeGroup(IChangeGroups* groups, flight::domain::FlightId flight_id)
+      : ChangeGroup(groups, std::span<const flight::domain::FlightId>(&flight_id, 1)) {}
+  ChangeGroup(IChangeGroups* groups, std::span<const flight::domain::FlightId> flight_ids) : groups_(groups) {
+    if (groups_) groups_->begin_group(flight_ids);
+  }
+  ~ChangeGroup() {
+    if (groups_) groups_->end_group();
+  }
+
+  ChangeGroup(const ChangeGroup&) = delete;
+  ChangeGroup& operator=(const ChangeGroup&) = delete;
+
+  void commit() {
+    if (groups_) {
+      auto* groups = groups_;
+      groups_ = nullptr;
+      groups->commit_group();
+    }
+  }
+
+private:
+  IChangeGroups* groups_;
+};
+
+} // namespace flight::application
@@ -3,17 +3,51 @@
 #include "flight/domain/flight.hpp"
 #include "flight/domain/ids.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
 #include <optional>
+#include <span>
 #include <vector>
 
 namespace flight::application {
 
+// Matches are returned ordered by departure, then flight id.
 struct FlightSearchCriteria {
   flight::domain::AirportCode origin;
   flight::domain::AirportCode destination;
-  // For v1 we ignore date range filtering, but keep it extensible.
+  // Optional departure window [departure_from, departure_to); an unset bound is open.
+  std::optional<flight::domain::Flight::time_point> departure_from{};
+  std::optional<flight::domain::Flight::time_point> departure_to{};
+  // Maximum number of matches (earliest departures first); 0 means unlimited.
+  std::size_t limit{0};
 };
 
+// Read model for search listings: everything a listing shows, without the seat map.
+struct FlightSummary {
+  flight::domain::FlightId id;
+  flight::domain::AirportCode origin;
+  flight::domain::AirportCode destination;
+  flight::domain::Flight::time_point departure;
+  std::uint32_t capacity{0};
+  std::uint32_t available{0};
+
+  static FlightSummary of(const flight::domain::Flight& f) {
+    return FlightSummary{f.id(), f.origin(), f.destination(), f.departure(), f.capacity(), f.available_count()};
+  }
+};
+
+// One independent seat booking of a try_book_seat_batch() call.
+struct SeatBookingRequest {
+  flight::domain::FlightId flight_id;
+  flight::domain::Seat seat;
+};
+
+// Invoked with a flight in place. The reference is only valid during the call, and the visitor may run
+// under the repository's read lock, so it must not retain the reference or call back into the repository.
+using FlightVisitor = std::function<void(const flight::domain::Flight&)>;
+
 class IFlightRepository {
 public:
   virtual ~IFlightRepository() = default;
@@ -21,14 +55,77 @@ public:
   virtual std::optional<flight::domain::Flight> get(flight::domain::FlightId id) const = 0;
   virtual std::vector<flight::domain::Flight> search(const FlightSearchCriteria& criteria) const = 0;
 
+  // Non-copying reads. visit() returns false if the flight does not exist.
+  // visit_matches() visits in the same order search() returns.
+  virtual bool visit(flight::domain::FlightId id, const FlightVisitor& visitor) const = 0;
+  virtual void visit_matches(const FlightSearchCriteria& criteria, const FlightVisitor& visitor) const = 0;
+  // Visits every flight, in no particular order (catalog export, checkpoints).
+  virtual void visit_all(const FlightVisitor& visitor) const = 0;
+
+  virtual std::vector<FlightSummary> search_summaries(const FlightSearchCriteria& criteria) const {
+    std::vector<FlightSummary> out;
+    visit_matches(criteria, [&out](const flight::domain::Flight& f) { out.push_back(FlightSummary::of(f)); });
+    return out;
+  }
+
+  // search() / search_summaries() with the result allocated from `mr`, seat maps included, e.g. from a
+  // per-request std::pmr::monotonic_buffer_resource so a search costs no heap allocation once the arena is warm.
+  // The result must not outlive `mr`; copying a flight out of it (not moving) gives it its own storage.
+  virtual std::pmr::vector<flight::domain::Flight> search_in(const FlightSearchCriteria& criteria,
+                                                             std::pmr::memory_resource* mr) const {
+    std::pmr::vector<flight::domain::Flight> out(mr);
+    visit_matches(criteria, [&out](const flight::domain::Flight& f) { out.push_back(f); });
+    return out;
+  }
+  virtual std::pmr::vector<FlightSummary> search_summaries_in(const FlightSearchCriteria& criteria,
+                                                              std::pmr::memory_resource* mr) const {
+    std::pmr::vector<FlightSummary> out(mr);
+    visit_matches(criteria, [&out](const flight::domain::Flight& f) { out.push_back(FlightSummary::of(f)); });
+    return out;
+  }
+
   // Modify operations.
   virtual void upsert(flight::domain::Flight flight) = 0;
+  // Upserts a batch in one operation (one lock hold in memory, one transaction in SQLite); a later flight
+  // with the same id as an earlier one wins.
+  virtual void upsert_many(std::vector<flight::domain::Flight> flights) = 0;
 
   // Atomic seat booking operation (thread-safe):
   // - returns true if booking succeeded
   // - returns false if seat invalid or already booked
   virtual bool try_book_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) = 0;
+  // All-or-nothing group booking: returns false (booking nothing) if `seats` is empty, or if any seat is
+  // invalid, repeated or already booked.
+  virtual bool try_book_seats(flight::domain::FlightId flight_id, std::span<const flight::domain::Seat> seats) = 0;
   virtual void release_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) = 0;
+  // Books each request independently, exactly as try_book_seat() would, and returns one result per request
+  // (a later request for a seat booked earlier in the batch fails). Implementations amortise their locking
+  // over the batch (one lock hold, one transaction); this default books one at a time.
+  virtual std::vector<bool> try_book_seat_batch(std::span<const SeatBookingRequest> requests) {
+    std::vector<bool> results;
+    results.reserve(requests.size());
+    for (const auto& r : requests) results.push_back(try_book_seat(r.flight_id, r.seat));
+    return results;
+  }
+
+  // Seat-map queries and server-side seat selection (replaces client-side guess-and-retry loops).
+  // available_count() is nullopt for an unknown flight; first_free_seats() returns up to `n` free seats in
+  // seat order; book_any_seat() atomically picks and books the first free seat, nullopt if full or unknown.
+  virtual std::optional<std::uint32_t> available_count(flight::domain::FlightId flight_id) const = 0;
+  virtual std::vector<flight::domain::Seat> first_free_seats(flight::domain::FlightId flight_id,
+                                                             std::size_t n) const = 0;
+  virtual std::optional<flight::domain::Seat> book_any_seat(flight::domain::FlightId flight_id) = 0;
+
+  // Atomically books `n` seats for a group that wants to sit together: n adjacent seats in one row when
+  // available, otherwise the nearest split over consecutive rows (see SeatMap::find_adjacent). Returns the
+  // booked seats, or empty (nothing booked) if the flight is unknown or has fewer than n free seats. A lock-free
+  // implementation may also give up (empty) after repeatedly losing the chosen seats to concurrent bookers.
+  virtual std::vector<flight::domain::Seat> book_adjacent_seats(flight::domain::FlightId flight_id,
+                                                                std::size_t n) = 0;
+
+  // True if changes outlive the process (a journal or a database file), so a restart brings every booked seat
+  // back, including seats taken only for state that lives in memory, such as a SeatHoldService hold.
+  virtual bool durable() const noexcept { return false; }
 };
 
 } // namespace flight::application
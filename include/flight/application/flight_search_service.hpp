@@ -8,10 +8,25 @@ class FlightSearchService final {
 public:
   explicit FlightSearchService(const IFlightRepository& flights) : flights_(flights) {}
 
-  std::vector<flight::domain::Flight> search(FlightSearchCriteria criteria) const {
+  // Listing projection; no seat state is copied.
+  std::vector<FlightSummary> search(FlightSearchCriteria criteria) const {
+    return flights_.search_summaries(criteria);
+  }
+
+  // Full flights including seat state.
+  std::vector<flight::domain::Flight> search_flights(FlightSearchCriteria criteria) const {
     return flights_.search(criteria);
   }
 
+  // The same, allocated from `mr` (typically a per-request arena); see IFlightRepository::search_in().
+  std::pmr::vector<FlightSummary> search(FlightSearchCriteria criteria, std::pmr::memory_resource* mr) const {
+    return flights_.search_summaries_in(criteria, mr);
+  }
+  std::pmr::vector<flight::domain::Flight> search_flights(FlightSearchCriteria criteria,
+                                                          std::pmr::memory_resource* mr) const {
+    return flights_.search_in(criteria, mr);
+  }
+
 private:
   const IFlightRepository& flights_;
 };
@@ -13,8 +13,12 @@ public:
   virtual ~IReservationRepository() = default;
 
   virtual void add(flight::domain::Reservation reservation) = 0;
+  // Adds a batch in one operation (e.g. one lock acquisition).
+  virtual void add_many(std::vector<flight::domain::Reservation> reservations) = 0;
   virtual std::optional<flight::domain::Reservation> get(flight::domain::ReservationId id) const = 0;
   virtual std::vector<flight::domain::Reservation> list_by_order(flight::domain::OrderId order_id) const = 0;
+  // Flight manifest: every reservation made on the flight.
+  virtual std::vector<flight::domain::Reservation> list_by_flight(flight::domain::FlightId flight_id) const = 0;
 };
 
 } // namespace flight::application
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "flight/application/booking_service.hpp"
+#include "flight/application/clock.hpp"
+#include "flight/application/flight_repository.hpp"
+#include "flight/application/id_generator.hpp"
+#include "flight/application/reservation_repository.hpp"
+#include "flight/domain/ids.hpp"
+#include "flight/domain/seat.hpp"
+#include "flight/util/timer_wheel.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace flight::application {
+
+struct SeatHoldOptions {
+  // Expiry granularity: a hold is released on the first expire_due() at least one tick past its deadline.
+  std::chrono::milliseconds resolution{100};
+};
+
+struct SeatHold {
+  flight::domain::HoldId id;
+  flight::domain::FlightId flight_id;
+  flight::domain::Seat seat;
+  std::chrono::system_clock::time_point expires_at;
+};
+
+struct HoldSeatResult {
+  bool success{false};
+  std::optional<SeatHold> hold;
+  std::string error;
+};
+
+// Temporary seat holds for checkout. hold_seat() takes the seat in the flight repository, so nobody else can
+// book it, but writes no reservation; confirm_hold() writes the reservation without touching the seat again,
+// and a hold that is neither confirmed nor released within its TTL gives the seat back. Deadlines live in a
+// hierarchical timer wheel over the injected IClock: arming and expiring a hold are O(1), with no thread or
+// scan per hold. Expiry runs inside hold_seat() and expire_due(); call the latter periodically so seats also
+// come back when no new holds arrive. Thread-safe as long as the repositories are.
+// Holds live only in memory, so the service refuses a durable flight repository: after a crash, the held seats
+// would come back booked, with neither a reservation nor a hold left to give them back.
+class SeatHoldService final {
+public:
+  // The repositories, id generator and clock must outlive the service. Throws std::invalid_argument if
+  // `flights` is durable().
+  SeatHoldService(IFlightRepository& flights, IReservationRepository& reservations, IIdGenerator& ids,
+                  const IClock& clock, SeatHoldOptions options = {});
+  // Releases the seats of all outstanding holds.
+  ~SeatHoldService() { release_all(); }
+
+  SeatHoldService(const SeatHoldService&) = delete;
+  SeatHoldService& operator=(const SeatHoldService&) = delete;
+
+  // Fails if the seat is invalid, booked or held, or `ttl` is not positive.
+  HoldSeatResult hold_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat,
+                           std::chrono::milliseconds ttl);
+  // Turns a live hold into a reservation for `order_id`. Fails for an unknown, released or expired hold (an
+  // expired hold's seat is released here if expire_due() has not got to it yet).
+  BookSeatResult confirm_hold(flight::domain::HoldId hold_id, flight::domain::OrderId order_id);
+  // Gives the seat back early; false for an unknown, confirmed or expired hold.
+  bool release_hold(flight::domain::HoldId hold_id);
+
+  // Releases every hold whose deadline has passed; returns how many.
+  std::size_t expire_due();
+  // Releases every outstanding hold (e.g. before a shutdown snapshot); returns how many.
+  std::size_t release_all();
+  std::size_t active_holds() const;
+
+private:
+  using Wheel = flight::util::TimerWheel<flight::domain::HoldId::value_type>;
+
+  struct Held {
+    flight::domain::FlightId flight_id;
+    flight::domain::Seat seat;
+    std::chrono::system_clock::time_point expires_at;
+    Wheel::Handle timer;
+  };
+
+  Wheel::Tick tick_at(std::chrono::system_clock::time_point t, bool round_up) const;
+  // Removes and returns the hold; nullopt if unknown. Caller holds mu_.
+  std::optional<Held> take_locked(flight::domain::HoldId::value_type id);
+
+  IFlightRepository& flights_;
+  IReservationRepository& reservations_;
+  IIdGenerator& ids_;
+  const IClock& clock_;
+  const SeatHoldOptions options_;
+  const std::chrono::system_clock::time_point origin_; // tick 0 of the wheel
+
+  mutable std::mutex mu_;
+  Wheel wheel_;
+  std::unordered_map<flight::domain::HoldId::value_type, Held> holds_;
+  std::uint64_t next_hold_id_{1};
+};
+
+} // namespace flight::application
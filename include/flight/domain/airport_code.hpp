@@ -1,33 +1,81 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 namespace flight::domain {
 
 // Simple 3-letter IATA-like code.
+// Stored packed as three 5-bit letters (15 bits), so equality and hashing are integer operations and
+// the type is trivially copyable. Text is produced only at the edges (CLI output, SQL binding).
 class AirportCode final {
 public:
-  explicit AirportCode(std::string code) : code_(std::move(code)) {
-    if (code_.size() != 3) {
+  using packed_type = std::uint16_t;
+
+  explicit constexpr AirportCode(std::string_view code) : packed_(pack(code)) {}
+
+  // Inverse of packed(); throws if `packed` does not encode three letters.
+  static constexpr AirportCode from_packed(packed_type packed) {
+    const AirportCode code{packed};
+    if ((packed >> 15) != 0 || code.letter(0) > 'Z' || code.letter(1) > 'Z' || code.letter(2) > 'Z') {
+      throw std::invalid_argument("Invalid packed AirportCode");
+    }
+    return code;
+  }
+
+  constexpr packed_type packed() const noexcept { return packed_; }
+
+  // NUL-terminated uppercase letters; no allocation.
+  constexpr std::array<char, 4> chars() const noexcept { return {letter(0), letter(1), letter(2), '\0'}; }
+
+  std::string value() const { return std::string(chars().data(), 3); }
+
+  friend constexpr bool operator==(AirportCode, AirportCode) noexcept = default;
+
+private:
+  explicit constexpr AirportCode(packed_type packed) noexcept : packed_(packed) {}
+
+  constexpr char letter(int i) const noexcept {
+    return static_cast<char>('A' + ((packed_ >> (10 - 5 * i)) & 0x1F));
+  }
+
+  static constexpr packed_type pack(std::string_view code) {
+    if (code.size() != 3) {
       throw std::invalid_argument("AirportCode must be exactly 3 characters");
     }
-    for (char& c : code_) {
+    packed_type packed = 0;
+    for (char c : code) {
       if (c >= 'a' && c <= 'z') {
         c = static_cast<char>(c - 'a' + 'A');
       }
       if (!(c >= 'A' && c <= 'Z')) {
         throw std::invalid_argument("AirportCode must contain only letters");
       }
+      packed = static_cast<packed_type>((packed << 5) | static_cast<packed_type>(c - 'A'));
     }
+    return packed;
   }
 
-  const std::string& value() const noexcept { return code_; }
+  packed_type packed_;
+};
 
-  friend bool operator==(const AirportCode&, const AirportCode&) = default;
+namespace literals {
 
-private:
-  std::string code_;
-};
+// Compile-time validated code: "WAW"_iata. An invalid literal fails to compile.
+consteval AirportCode operator""_iata(const char* code, std::size_t size) {
+  return AirportCode(std::string_view(code, size));
+}
+
+} // namespace literals
 
 } // namespace flight::domain
+
+template <>
+struct std::hash<flight::domain::AirportCode> {
+  std::size_t operator()(flight::domain::AirportCode code) const noexcept { return code.packed(); }
+};
@@ -3,18 +3,24 @@
 #include "flight/domain/airport_code.hpp"
 #include "flight/domain/ids.hpp"
 #include "flight/domain/seat.hpp"
+#include "flight/domain/seat_map.hpp"
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <set>
+#include <memory_resource>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace flight::domain {
 
 class Flight final {
 public:
   using time_point = std::chrono::system_clock::time_point;
+  // The seat map is the only allocation; see SeatMap for how it follows a memory resource.
+  using allocator_type = SeatMap::allocator_type;
 
   Flight(FlightId id,
          AirportCode origin,
@@ -24,14 +30,41 @@ public:
          std::uint8_t seats_per_row)
       : id_(id), origin_(std::move(origin)), destination_(std::move(destination)), departure_(departure),
         rows_(rows), seats_per_row_(seats_per_row) {
-    if (rows_ == 0 || seats_per_row_ == 0) {
-      throw std::invalid_argument("rows and seats_per_row must be > 0");
-    }
-    if (seats_per_row_ > 26) {
-      throw std::invalid_argument("seats_per_row must be <= 26 (A-Z)");
+    validate_layout();
+    seats_ = SeatMap(rows_, seats_per_row_);
+  }
+
+  // Rehydrates a flight together with its booked seats (used by repositories). Takes over the seat map's
+  // storage, memory resource included.
+  Flight(FlightId id,
+         AirportCode origin,
+         AirportCode destination,
+         time_point departure,
+         std::uint16_t rows,
+         std::uint8_t seats_per_row,
+         SeatMap booked_seats)
+      : id_(id), origin_(std::move(origin)), destination_(std::move(destination)), departure_(departure),
+        rows_(rows), seats_per_row_(seats_per_row), seats_(std::move(booked_seats)) {
+    validate_layout();
+    if (seats_.capacity() != capacity() || seats_.seats_per_row() != seats_per_row_) {
+      throw std::invalid_argument("SeatMap layout does not match flight");
     }
   }
 
+  Flight(const Flight&) = default;
+  Flight(Flight&&) noexcept = default;
+  Flight& operator=(const Flight&) = default;
+  Flight& operator=(Flight&&) = default;
+  // Allocator-extended copy/move, so std::pmr containers place the seat map in their own resource.
+  Flight(const Flight& other, allocator_type alloc)
+      : id_(other.id_), origin_(other.origin_), destination_(other.destination_), departure_(other.departure_),
+        rows_(other.rows_), seats_per_row_(other.seats_per_row_), seats_(other.seats_, alloc) {}
+  Flight(Flight&& other, allocator_type alloc)
+      : id_(other.id_), origin_(other.origin_), destination_(other.destination_), departure_(other.departure_),
+        rows_(other.rows_), seats_per_row_(other.seats_per_row_), seats_(std::move(other.seats_), alloc) {}
+
+  allocator_type get_allocator() const noexcept { return seats_.get_allocator(); }
+
   FlightId id() const noexcept { return id_; }
   const AirportCode& origin() const noexcept { return origin_; }
   const AirportCode& destination() const noexcept { return destination_; }
@@ -48,25 +81,64 @@ public:
   }
 
   // NOTE: Flight itself is NOT thread-safe. Concurrency is handled at repository/service layer.
-  bool is_booked(const Seat& seat) const {
-    return booked_seats_.contains(seat);
+  bool is_booked(const Seat& seat) const noexcept {
+    return is_seat_valid(seat) && seats_.test(seats_.index_of(seat));
   }
 
   void book_seat(const Seat& seat) {
     if (!is_seat_valid(seat)) {
       throw std::invalid_argument("Seat is not valid for this flight");
     }
-    auto [it, inserted] = booked_seats_.insert(seat);
-    if (!inserted) {
+    if (!seats_.set(seats_.index_of(seat))) {
       throw std::runtime_error("Seat already booked");
     }
   }
 
-  void release_seat(const Seat& seat) {
-    booked_seats_.erase(seat);
+  void release_seat(const Seat& seat) noexcept {
+    if (!is_seat_valid(seat)) return;
+    seats_.reset(seats_.index_of(seat));
+  }
+
+  // Up to `n` free seats in seat order (1A, 1B, ..., 2A, ...).
+  std::vector<Seat> first_free_seats(std::size_t n) const {
+    std::vector<Seat> out;
+    for (const auto index : seats_.first_free(n)) out.push_back(seats_.seat_at(index));
+    return out;
+  }
+
+  // Books the first free seat; nullopt if the flight is full.
+  std::optional<Seat> book_any_seat() {
+    const auto index = seats_.find_free();
+    if (!index) return std::nullopt;
+    seats_.set(*index);
+    return seats_.seat_at(*index);
+  }
+
+  // Books `n` seats together (see SeatMap::find_adjacent); empty and unchanged if the flight lacks n free seats.
+  std::vector<Seat> book_adjacent_seats(std::size_t n) {
+    std::vector<Seat> out;
+    for (const auto index : seats_.find_adjacent(n)) {
+      seats_.set(index);
+      out.push_back(seats_.seat_at(index));
+    }
+    return out;
   }
 
+  std::uint32_t booked_count() const noexcept { return seats_.count(); }
+  std::uint32_t available_count() const noexcept { return capacity() - booked_count(); }
+
+  const SeatMap& seat_map() const noexcept { return seats_; }
+
 private:
+  void validate_layout() const {
+    if (rows_ == 0 || seats_per_row_ == 0) {
+      throw std::invalid_argument("rows and seats_per_row must be > 0");
+    }
+    if (seats_per_row_ > 26) {
+      throw std::invalid_argument("seats_per_row must be <= 26 (A-Z)");
+    }
+  }
+
   FlightId id_;
   AirportCode origin_;
   AirportCode destination_;
@@ -74,7 +146,7 @@ private:
   std::uint16_t rows_;
   std::uint8_t seats_per_row_;
 
-  std::set<Seat> booked_seats_;
+  SeatMap seats_;
 };
 
 } // namespace flight::domain
@@ -5,10 +5,12 @@
 namespace flight::domain {
 
 struct FlightIdTag {};
+struct HoldIdTag {};
 struct OrderIdTag {};
 struct ReservationIdTag {};
 
 using FlightId = flight::util::StrongId<FlightIdTag>;
+using HoldId = flight::util::StrongId<HoldIdTag>;
 using OrderId = flight::util::StrongId<OrderIdTag>;
 using ReservationId = flight::util::StrongId<ReservationIdTag>;
 
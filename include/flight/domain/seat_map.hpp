@@ -0,0 +1,209 @@
+#pragma once
+
+#include "flight/domain/seat.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace flight::domain {
+
+// Fixed-size occupancy bitmap for a flight's seats.
+// Seat (row, letter) maps to bit (row - 1) * seats_per_row + (letter - 'A'), packed into 64-bit words,
+// so lookup/book/release are single bit operations and a copy is one contiguous buffer copy.
+// The words come from a std::pmr memory resource (the default heap unless one is given); plain copies always
+// use the default resource, the allocator-extended constructors place the copy in another one.
+class SeatMap final {
+public:
+  using word_type = std::uint64_t;
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+  static constexpr std::size_t kWordBits = 64;
+
+  SeatMap() = default;
+  SeatMap(std::uint16_t rows, std::uint8_t seats_per_row, allocator_type alloc = {})
+      : seats_per_row_(seats_per_row),
+        capacity_(static_cast<std::uint32_t>(rows) * seats_per_row),
+        words_(words_for(capacity_), 0, alloc) {}
+
+  SeatMap(const SeatMap&) = default;
+  SeatMap(SeatMap&&) noexcept = default;
+  SeatMap& operator=(const SeatMap&) = default;
+  SeatMap& operator=(SeatMap&&) = default;
+  SeatMap(const SeatMap& other, allocator_type alloc)
+      : seats_per_row_(other.seats_per_row_), capacity_(other.capacity_), words_(other.words_, alloc) {}
+  SeatMap(SeatMap&& other, allocator_type alloc)
+      : seats_per_row_(other.seats_per_row_), capacity_(other.capacity_), words_(std::move(other.words_), alloc) {}
+
+  allocator_type get_allocator() const noexcept { return words_.get_allocator(); }
+
+  static constexpr std::size_t words_for(std::uint32_t capacity) noexcept {
+    return (static_cast<std::size_t>(capacity) + kWordBits - 1) / kWordBits;
+  }
+
+  std::uint32_t capacity() const noexcept { return capacity_; }
+  std::uint8_t seats_per_row() const noexcept { return seats_per_row_; }
+
+  // Caller must ensure the seat is valid for the flight (see Flight::is_seat_valid).
+  std::size_t index_of(const Seat& seat) const noexcept {
+    return static_cast<std::size_t>(seat.row() - 1) * seats_per_row_ + static_cast<std::size_t>(seat.letter() - 'A');
+  }
+
+  // Inverse of index_of.
+  Seat seat_at(std::size_t index) const {
+    return Seat(static_cast<std::uint16_t>(index / seats_per_row_ + 1), static_cast<char>('A' + index % seats_per_row_));
+  }
+
+  // Bits of word `word_index` that map to real seats (all but the tail of the last word).
+  static constexpr word_type valid_bits(std::uint32_t capacity, std::size_t word_index) noexcept {
+    const auto first = word_index * kWordBits;
+    if (first + kWordBits <= capacity) return ~word_type{0};
+    return first >= capacity ? word_type{0} : (word_type{1} << (capacity - first)) - 1;
+  }
+
+  bool test(std::size_t index) const noexcept {
+    return (words_[index / kWordBits] >> (index % kWordBits)) & word_type{1};
+  }
+
+  // Returns false if the bit was already set.
+  bool set(std::size_t index) noexcept {
+    auto& w = words_[index / kWordBits];
+    const word_type bit = word_type{1} << (index % kWordBits);
+    if (w & bit) return false;
+    w |= bit;
+    return true;
+  }
+
+  // Returns false if the bit was not set.
+  bool reset(std::size_t index) noexcept {
+    auto& w = words_[index / kWordBits];
+    const word_type bit = word_type{1} << (index % kWordBits);
+    if (!(w & bit)) return false;
+    w &= ~bit;
+    return true;
+  }
+
+  std::uint32_t count() const noexcept {
+    std::uint32_t n = 0;
+    for (const auto w : words_) n += static_cast<std::uint32_t>(std::popcount(w));
+    return n;
+  }
+
+  // Up to `n` free seat indices in ascending order; scans a word at a time with countr_zero.
+  std::vector<std::size_t> first_free(std::size_t n) const {
+    std::vector<std::size_t> out;
+    for (std::size_t i = 0; i < words_.size() && out.size() < n; ++i) {
+      word_type free = ~words_[i] & valid_bits(capacity_, i);
+      while (free != 0 && out.size() < n) {
+        out.push_back(i * kWordBits + static_cast<std::size_t>(std::countr_zero(free)));
+        free &= free - 1; // clear lowest set bit
+      }
+    }
+    return out;
+  }
+
+  std::optional<std::size_t> find_free() const noexcept {
+    for (std::size_t i = 0; i < words_.size(); ++i) {
+      const word_type free = ~words_[i] & valid_bits(capacity_, i);
+      if (free != 0) return i * kWordBits + static_cast<std::size_t>(std::countr_zero(free));
+    }
+    return std::nullopt;
+  }
+
+  // Free seats of row `row_index` (0-based) as bits 0..seats_per_row-1; a row may straddle two words.
+  word_type row_free_bits(std::size_t row_index) const noexcept {
+    const std::size_t first = row_index * seats_per_row_;
+    const std::size_t word = first / kWordBits;
+    const std::size_t shift = first % kWordBits;
+    word_type booked = words_[word] >> shift;
+    if (shift + seats_per_row_ > kWordBits) booked |= words_[word + 1] << (kWordBits - shift);
+    return ~booked & ((word_type{1} << seats_per_row_) - 1);
+  }
+
+  // Seat indices for a group of `n` sitting together: the tightest run of n adjacent free seats in one row
+  // (lowest row, then leftmost, on ties). Failing that, the fewest consecutive rows that hold n free seats,
+  // taking each row's longest runs first. Empty if fewer than n seats are free.
+  std::vector<std::size_t> find_adjacent(std::size_t n) const {
+    std::vector<std::size_t> out;
+    if (n == 0 || seats_per_row_ == 0) return out;
+    const std::size_t rows = capacity_ / seats_per_row_;
+
+    std::size_t best_row = 0, best_start = 0, best_len = 0;
+    for (std::size_t r = 0; r < rows && best_len != n && n <= seats_per_row_; ++r) {
+      for_each_run(row_free_bits(r), [&](std::size_t start, std::size_t len) {
+        if (len >= n && (best_len == 0 || len < best_len)) {
+          best_row = r;
+          best_start = start;
+          best_len = len;
+        }
+      });
+    }
+    if (best_len != 0) {
+      for (std::size_t i = 0; i < n; ++i) out.push_back(best_row * seats_per_row_ + best_start + i);
+      return out;
+    }
+
+    // Split: shortest window of consecutive rows with at least n free seats (two pointers over free counts).
+    std::vector<std::size_t> free(rows);
+    for (std::size_t r = 0; r < rows; ++r) free[r] = static_cast<std::size_t>(std::popcount(row_free_bits(r)));
+    std::size_t lo = 0, sum = 0, window_lo = 0, window_rows = 0;
+    for (std::size_t hi = 0; hi < rows; ++hi) {
+      sum += free[hi];
+      while (sum - free[lo] >= n) sum -= free[lo++];
+      if (sum >= n && (window_rows == 0 || hi - lo + 1 < window_rows)) {
+        window_lo = lo;
+        window_rows = hi - lo + 1;
+      }
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> runs; // (start, len) within one row
+    for (std::size_t r = window_lo; r < window_lo + window_rows && out.size() < n; ++r) {
+      runs.clear();
+      for_each_run(row_free_bits(r), [&](std::size_t start, std::size_t len) { runs.emplace_back(start, len); });
+      std::stable_sort(runs.begin(), runs.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+      for (const auto& [start, len] : runs) {
+        for (std::size_t i = 0; i < len && out.size() < n; ++i) out.push_back(r * seats_per_row_ + start + i);
+      }
+    }
+    return out;
+  }
+
+  std::span<const word_type> words() const noexcept { return words_; }
+
+  // Bulk restore (e.g. from a repository's own seat storage). Bits past capacity() are dropped.
+  void assign_word(std::size_t word_index, word_type value) noexcept {
+    if (word_index + 1 == words_.size() && capacity_ % kWordBits != 0) {
+      value &= (word_type{1} << (capacity_ % kWordBits)) - 1;
+    }
+    words_[word_index] = value;
+  }
+
+  friend bool operator==(const SeatMap&, const SeatMap&) = default;
+
+private:
+  // Calls fn(start, length) for each run of set bits, lowest first.
+  template <class Fn>
+  static void for_each_run(word_type bits, Fn&& fn) {
+    std::size_t offset = 0;
+    while (bits != 0) {
+      const auto skip = static_cast<std::size_t>(std::countr_zero(bits));
+      bits >>= skip;
+      offset += skip;
+      const auto len = static_cast<std::size_t>(std::countr_one(bits));
+      fn(offset, len);
+      bits = len == kWordBits ? 0 : bits >> len;
+      offset += len;
+    }
+  }
+
+  std::uint8_t seats_per_row_{0};
+  std::uint32_t capacity_{0};
+  std::pmr::vector<word_type> words_;
+};
+
+} // namespace flight::domain
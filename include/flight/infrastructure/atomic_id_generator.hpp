@@ -2,26 +2,43 @@
 
 #include "flight/application/id_generator.hpp"
 
+#include <array>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 
 namespace flight::infrastructure {
 
+// Sequential ids from three shared counters, each on its own cache line. With block_size > 1, each thread
+// leases block_size ids at a time and hands them out locally, so the shared counter is touched once per block
+// instead of once per id. Ids then stay unique and increasing within a thread, but interleave across threads
+// and skip the unused rest of each thread's block.
 class AtomicIdGenerator final : public flight::application::IIdGenerator {
 public:
-  flight::domain::FlightId next_flight_id() override {
-    return flight::domain::FlightId{flight_id_.fetch_add(1, std::memory_order_relaxed)};
-  }
+  AtomicIdGenerator() : AtomicIdGenerator(1, 1, 1) {}
+  // Starts each sequence at the given id (e.g. past the ids restored from a journal). Throws
+  // std::invalid_argument for a zero block_size.
+  AtomicIdGenerator(std::uint64_t first_flight_id, std::uint64_t first_reservation_id, std::uint64_t first_order_id,
+                    std::uint64_t block_size = 1);
+
+  flight::domain::FlightId next_flight_id() override { return flight::domain::FlightId{next(kFlight)}; }
   flight::domain::ReservationId next_reservation_id() override {
-    return flight::domain::ReservationId{reservation_id_.fetch_add(1, std::memory_order_relaxed)};
-  }
-  flight::domain::OrderId next_order_id() override {
-    return flight::domain::OrderId{order_id_.fetch_add(1, std::memory_order_relaxed)};
+    return flight::domain::ReservationId{next(kReservation)};
   }
+  flight::domain::OrderId next_order_id() override { return flight::domain::OrderId{next(kOrder)}; }
 
 private:
-  std::atomic<std::uint64_t> flight_id_{1};
-  std::atomic<std::uint64_t> reservation_id_{1};
-  std::atomic<std::uint64_t> order_id_{1};
+  enum Sequence : std::size_t { kFlight, kReservation, kOrder, kSequences };
+
+  struct alignas(64) Counter {
+    std::atomic<std::uint64_t> next{1};
+  };
+
+  std::uint64_t next(Sequence s);
+
+  std::array<Counter, kSequences> counters_;
+  const std::uint64_t block_size_;
+  const std::uint64_t instance_; // tells this generator's per-thread leases from other instances'
 };
 
 } // namespace flight::infrastructure
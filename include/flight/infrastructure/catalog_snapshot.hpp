@@ -0,0 +1,89 @@
+#pragma once
+
+#include "flight/application/flight_repository.hpp"
+#include "flight/domain/flight.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace flight::infrastructure {
+
+// Binary catalog snapshot: flights plus seat occupancy in a fixed layout that is used in place from a
+// read-only mapping. File layout (little-endian, every section 8-byte aligned):
+//
+//   SnapshotHeader | SnapshotFlight[flight_count] | std::uint64_t seat words[word_count]
+//
+// Each SnapshotFlight points at its SeatMap::words() in the trailing word area.
+struct SnapshotHeader {
+  std::array<char, 8> magic{};
+  std::uint32_t version{0};
+  std::uint32_t header_bytes{0};
+  std::uint64_t flight_count{0};
+  std::uint64_t word_count{0};
+  std::uint64_t file_bytes{0};
+  std::uint32_t body_crc{0};   // crc32 of everything after the header
+  std::uint32_t header_crc{0}; // crc32 of the header with this field zeroed
+  std::array<std::uint8_t, 16> reserved{};
+};
+
+struct SnapshotFlight {
+  std::uint64_t id{0};
+  std::int64_t departure_ns{0}; // since the system_clock epoch
+  std::uint64_t first_word{0};  // index of this flight's first seat word
+  flight::domain::AirportCode::packed_type origin{0};
+  flight::domain::AirportCode::packed_type destination{0};
+  std::uint16_t rows{0};
+  std::uint8_t seats_per_row{0};
+  std::uint8_t reserved{0};
+};
+
+static_assert(sizeof(SnapshotHeader) == 64 && sizeof(SnapshotFlight) == 32, "snapshot layout changed");
+
+// A memory-mapped snapshot. Opening validates the header only (plus, when asked, the body checksum, which
+// reads every page); flight records are then read straight from the mapping and pages fault in on first use.
+class CatalogSnapshot final {
+public:
+  static constexpr std::uint32_t kVersion = 1;
+
+  // Writes every flight of `flights` to `path` (through a temp file renamed into place) and returns the number
+  // of flights written.
+  static std::size_t write(const std::string& path, const flight::application::IFlightRepository& flights);
+
+  // Maps `path` read-only. Throws std::runtime_error for a missing, truncated, foreign or corrupt file.
+  explicit CatalogSnapshot(const std::string& path, bool verify_checksum = true);
+  ~CatalogSnapshot();
+
+  CatalogSnapshot(const CatalogSnapshot&) = delete;
+  CatalogSnapshot& operator=(const CatalogSnapshot&) = delete;
+
+  std::size_t size() const noexcept { return flights_.size(); }
+  // The header's body checksum, which identifies the snapshot's contents.
+  std::uint32_t checksum() const noexcept { return checksum_; }
+  // Flight records in id order.
+  std::span<const SnapshotFlight> flights() const noexcept { return flights_; }
+  // The record of flight `id`, or nullptr (binary search).
+  const SnapshotFlight* find(std::uint64_t id) const noexcept;
+  // True if the snapshot has `flight` exactly as it is: same schedule and same booked seats.
+  bool holds(const flight::domain::Flight& flight) const;
+  // Throws std::runtime_error if the record points outside the word area.
+  std::span<const std::uint64_t> seat_words(const SnapshotFlight& f) const;
+
+  // Listing view straight from the mapping (availability is a popcount over the seat words).
+  flight::application::FlightSummary summary(const SnapshotFlight& f) const;
+  flight::domain::Flight flight(const SnapshotFlight& f) const;
+
+  // Upserts every flight into `repository` (upsert_many in batches); returns the highest flight id (0 for an empty snapshot).
+  std::uint64_t load_into(flight::application::IFlightRepository& repository) const;
+
+private:
+  void* base_{nullptr};
+  std::size_t length_{0};
+  std::span<const SnapshotFlight> flights_;
+  std::span<const std::uint64_t> words_;
+  std::uint32_t checksum_{0};
+};
+
+} // namespace flight::infrastructure
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <string>
+
+namespace flight::infrastructure {
+
+// POSIX helpers for crash-safe files (the journal, catalog snapshots). Failures throw std::system_error naming
+// the file.
+
+// Writes all of `data` to `fd`, retrying short writes and EINTR.
+void write_all(int fd, std::span<const std::byte> data, const std::string& path);
+// Returns once `fd`'s data is on the drive (fdatasync; F_FULLFSYNC on macOS).
+void sync_file(int fd, const std::string& path);
+// Makes a rename or create in the directory of `path` durable.
+void sync_parent_dir(const std::string& path);
+
+// Replaces `path` with `parts` (concatenated): they go to `<path>.tmp`, which is synced, renamed over `path`, and
+// the directory synced, so a crash leaves either the old file or the complete new one. With `sync` false
+// nothing is synced (tests and benchmarks only).
+void replace_file(const std::string& path, std::initializer_list<std::span<const std::byte>> parts,
+                  bool sync = true);
+
+} // namespace flight::infrastructure
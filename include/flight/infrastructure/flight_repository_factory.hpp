@@ -1,17 +1,28 @@
 #pragma once
 
 #include "flight/application/flight_repository.hpp"
+#include "flight/infrastructure/sqlite_flight_repository.hpp"
 
 #include <memory>
 #include <string>
 
 namespace flight::infrastructure {
 
-enum class FlightRepoType { InMemory, Sqlite };
+enum class FlightRepoType { InMemory, LockFree, Sqlite, SqliteFile };
+
+// Per-backend settings; each repository type reads only its own section.
+struct FlightRepoConfig {
+  // Used by SqliteFile (Sqlite is always a private :memory: database).
+  SqliteOptions sqlite_file{.path = "flight_booking.db"};
+  // Wrap the repository in InstrumentedFlightRepository (ignored when built with FLIGHT_METRICS=0).
+  bool instrumented{false};
+};
 
 FlightRepoType parse_flight_repo_type(const std::string& value);
+// Inverse of parse_flight_repo_type (also used as the metrics `repo` label).
+const char* flight_repo_type_name(FlightRepoType type) noexcept;
 
 std::unique_ptr<flight::application::IFlightRepository>
-make_flight_repository(FlightRepoType type);
+make_flight_repository(FlightRepoType type, const FlightRepoConfig& config = {});
 
 } // namespace flight::infrastructure
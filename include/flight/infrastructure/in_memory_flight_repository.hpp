@@ -1,26 +1,84 @@
 #pragma once
 
 #include "flight/application/flight_repository.hpp"
+#include "flight/infrastructure/route_index.hpp"
+#include "flight/util/epoch.hpp"
+#include "flight/util/epoch_table.hpp"
 
-#include <shared_mutex>
-#include <unordered_map>
+#include <atomic>
+#include <memory_resource>
+#include <mutex>
 
 namespace flight::infrastructure {
 
 class InMemoryFlightRepository final : public flight::application::IFlightRepository {
 public:
+  // Flight entries and their seat maps are carved from a pool over `upstream`, which must outlive the
+  // repository. Freed entries are reused by later ones; the pool returns memory upstream only on destruction.
+  explicit InMemoryFlightRepository(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+      : pool_(upstream) {}
+  ~InMemoryFlightRepository() override;
+
+  InMemoryFlightRepository(const InMemoryFlightRepository&) = delete;
+  InMemoryFlightRepository& operator=(const InMemoryFlightRepository&) = delete;
+
   std::optional<flight::domain::Flight> get(flight::domain::FlightId id) const override;
   std::vector<flight::domain::Flight> search(const flight::application::FlightSearchCriteria& criteria) const override;
+  bool visit(flight::domain::FlightId id, const flight::application::FlightVisitor& visitor) const override;
+  void visit_matches(const flight::application::FlightSearchCriteria& criteria,
+                     const flight::application::FlightVisitor& visitor) const override;
+  void visit_all(const flight::application::FlightVisitor& visitor) const override;
   void upsert(flight::domain::Flight flight) override;
+  void upsert_many(std::vector<flight::domain::Flight> flights) override;
 
   bool try_book_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) override;
+  bool try_book_seats(flight::domain::FlightId flight_id, std::span<const flight::domain::Seat> seats) override;
   void release_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) override;
+  std::vector<bool> try_book_seat_batch(
+      std::span<const flight::application::SeatBookingRequest> requests) override;
+
+  std::optional<std::uint32_t> available_count(flight::domain::FlightId flight_id) const override;
+  std::vector<flight::domain::Seat> first_free_seats(flight::domain::FlightId flight_id, std::size_t n) const override;
+  std::optional<flight::domain::Seat> book_any_seat(flight::domain::FlightId flight_id) override;
+  std::vector<flight::domain::Seat> book_adjacent_seats(flight::domain::FlightId flight_id, std::size_t n) override;
 
 private:
-  // A single repository-wide shared_mutex keeps v1 simple.
-  // It enables many concurrent readers (search/get) while serializing modifications (booking/upsert).
-  mutable std::shared_mutex mu_;
-  std::unordered_map<flight::domain::FlightId::value_type, flight::domain::Flight> flights_;
+  // Each flight is a chain of immutable versions (MVCC): readers load the current one under an EpochGuard and
+  // never lock the flight, while writers copy it, change the copy and publish that. Writers of one flight are
+  // serialized by its own mutex, so bookings on different flights never contend and readers wait on none.
+  struct Entry {
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+    Entry(flight::domain::Flight f, allocator_type alloc);
+    ~Entry();
+
+    // The published version; the caller is pinned (or holds `mu`) while it uses the reference.
+    const flight::domain::Flight& current() const noexcept { return *version.load(std::memory_order_acquire); }
+    // A private copy of the current version to change and publish(); the caller holds `mu`.
+    flight::domain::Flight draft() const;
+    // Makes `next` the current version and retires the old one; the caller holds `mu`.
+    void publish(flight::domain::Flight next);
+
+    allocator_type alloc;
+    std::mutex mu; // writers only
+    std::atomic<const flight::domain::Flight*> version;
+    flight::util::EpochRetireList retired; // guarded by `mu`
+  };
+
+  // The flight's entry, or nullptr; the caller is pinned.
+  Entry* find(flight::domain::FlightId id) const noexcept { return flights_.find(id.value()); }
+
+  // Publishes `flight` as `e`'s next version, re-indexing it if its route or departure changed. The caller holds
+  // write_mu_ and e.mu and is pinned.
+  void move(Entry& e, flight::domain::Flight flight);
+
+  // Serializes catalog changes: adding a flight or changing its route or departure. Readers never take it and
+  // bookings never take it. Lock order: write_mu_ before Entry::mu.
+  std::mutex write_mu_;
+  // Synchronized: flight versions are allocated and freed by concurrent writers of different flights.
+  std::pmr::synchronized_pool_resource pool_;
+  // Entries live in pool_ until the repository is destroyed; the table and the index are read without locks.
+  flight::util::EpochTable<Entry> flights_;
+  RouteIndex routes_;
 };
 
 } // namespace flight::infrastructure
@@ -2,6 +2,7 @@
 
 #include "flight/application/reservation_repository.hpp"
 
+#include <memory_resource>
 #include <shared_mutex>
 #include <unordered_map>
 #include <vector>
@@ -10,13 +11,29 @@ namespace flight::infrastructure {
 
 class InMemoryReservationRepository final : public flight::application::IReservationRepository {
 public:
+  // Reservation and index nodes are carved from a pool over `upstream`, which must outlive the repository.
+  explicit InMemoryReservationRepository(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+      : pool_(upstream), reservations_(&pool_), by_order_(&pool_), by_flight_(&pool_) {}
+
   void add(flight::domain::Reservation reservation) override;
+  void add_many(std::vector<flight::domain::Reservation> reservations) override;
   std::optional<flight::domain::Reservation> get(flight::domain::ReservationId id) const override;
   std::vector<flight::domain::Reservation> list_by_order(flight::domain::OrderId order_id) const override;
+  std::vector<flight::domain::Reservation> list_by_flight(flight::domain::FlightId flight_id) const override;
 
 private:
+  using IdList = std::pmr::vector<flight::domain::ReservationId::value_type>;
+
+  void add_locked(flight::domain::Reservation reservation);
+  std::vector<flight::domain::Reservation> collect_locked(const IdList* ids) const;
+
   mutable std::shared_mutex mu_;
-  std::unordered_map<flight::domain::ReservationId::value_type, flight::domain::Reservation> reservations_;
+  // Unsynchronized: the containers only allocate under the exclusive lock.
+  std::pmr::unsynchronized_pool_resource pool_;
+  std::pmr::unordered_map<flight::domain::ReservationId::value_type, flight::domain::Reservation> reservations_;
+  // Secondary indexes maintained by add(): reservation ids per order / per flight, in insertion order.
+  std::pmr::unordered_map<flight::domain::OrderId::value_type, IdList> by_order_;
+  std::pmr::unordered_map<flight::domain::FlightId::value_type, IdList> by_flight_;
 };
 
 } // namespace flight::infrastructure
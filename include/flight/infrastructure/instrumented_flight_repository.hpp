@@ -0,0 +1,73 @@
+#pragma once
+
+#include "flight/application/flight_repository.hpp"
+#include "flight/util/metrics.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace flight::infrastructure {
+
+// Decorator that times every call of the wrapped repository into
+// flight_repository_op_seconds{repo="<label>",op="<method>"}.
+class InstrumentedFlightRepository final : public flight::application::IFlightRepository {
+public:
+  InstrumentedFlightRepository(std::unique_ptr<flight::application::IFlightRepository> inner, std::string_view label);
+
+  std::optional<flight::domain::Flight> get(flight::domain::FlightId id) const override;
+  std::vector<flight::domain::Flight> search(const flight::application::FlightSearchCriteria& criteria) const override;
+  bool visit(flight::domain::FlightId id, const flight::application::FlightVisitor& visitor) const override;
+  void visit_matches(const flight::application::FlightSearchCriteria& criteria,
+                     const flight::application::FlightVisitor& visitor) const override;
+  void visit_all(const flight::application::FlightVisitor& visitor) const override;
+  std::vector<flight::application::FlightSummary> search_summaries(
+      const flight::application::FlightSearchCriteria& criteria) const override;
+  std::pmr::vector<flight::domain::Flight> search_in(const flight::application::FlightSearchCriteria& criteria,
+                                                     std::pmr::memory_resource* mr) const override;
+  std::pmr::vector<flight::application::FlightSummary> search_summaries_in(
+      const flight::application::FlightSearchCriteria& criteria, std::pmr::memory_resource* mr) const override;
+  void upsert(flight::domain::Flight flight) override;
+  void upsert_many(std::vector<flight::domain::Flight> flights) override;
+
+  bool try_book_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) override;
+  bool try_book_seats(flight::domain::FlightId flight_id, std::span<const flight::domain::Seat> seats) override;
+  void release_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) override;
+  std::vector<bool> try_book_seat_batch(
+      std::span<const flight::application::SeatBookingRequest> requests) override;
+
+  std::optional<std::uint32_t> available_count(flight::domain::FlightId flight_id) const override;
+  std::vector<flight::domain::Seat> first_free_seats(flight::domain::FlightId flight_id, std::size_t n) const override;
+  std::optional<flight::domain::Seat> book_any_seat(flight::domain::FlightId flight_id) override;
+  std::vector<flight::domain::Seat> book_adjacent_seats(flight::domain::FlightId flight_id, std::size_t n) override;
+  bool durable() const noexcept override { return inner_->durable(); }
+
+private:
+  enum Op : std::size_t {
+    kGet,
+    kSearch,
+    kVisit,
+    kVisitMatches,
+    kVisitAll,
+    kSearchSummaries,
+    kSearchIn,
+    kSearchSummariesIn,
+    kUpsert,
+    kUpsertMany,
+    kTryBookSeat,
+    kTryBookSeats,
+    kReleaseSeat,
+    kTryBookSeatBatch,
+    kAvailableCount,
+    kFirstFreeSeats,
+    kBookAnySeat,
+    kBookAdjacentSeats,
+    kOpCount
+  };
+
+  std::unique_ptr<flight::application::IFlightRepository> inner_;
+  std::array<flight::util::HistogramId, kOpCount> ops_{};
+};
+
+} // namespace flight::infrastructure
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "flight/application/reservation_repository.hpp"
+#include "flight/util/metrics.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace flight::infrastructure {
+
+// Decorator that times every call of the wrapped repository into
+// flight_reservation_repository_op_seconds{repo="<label>",op="<method>"}.
+class InstrumentedReservationRepository final : public flight::application::IReservationRepository {
+public:
+  InstrumentedReservationRepository(std::unique_ptr<flight::application::IReservationRepository> inner,
+                                    std::string_view label);
+
+  void add(flight::domain::Reservation reservation) override;
+  void add_many(std::vector<flight::domain::Reservation> reservations) override;
+  std::optional<flight::domain::Reservation> get(flight::domain::ReservationId id) const override;
+  std::vector<flight::domain::Reservation> list_by_order(flight::domain::OrderId order_id) const override;
+  std::vector<flight::domain::Reservation> list_by_flight(flight::domain::FlightId flight_id) const override;
+
+private:
+  enum Op : std::size_t { kAdd, kAddMany, kGet, kListByOrder, kListByFlight, kOpCount };
+
+  std::unique_ptr<flight::application::IReservationRepository> inner_;
+  std::array<flight::util::HistogramId, kOpCount> ops_{};
+};
+
+} // namespace flight::infrastructure
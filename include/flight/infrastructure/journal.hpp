@@ -0,0 +1,70 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace flight::infrastructure {
+
+// Append-only log of opaque records with group commit (POSIX). Each record is framed as
+// [u32 length][u32 crc32][payload], little-endian. append() only copies into a buffer; a background flusher
+// writes everything appended since its previous flush with one write + fdatasync, so concurrent writers
+// share the cost of one sync instead of paying one each.
+class Journal final {
+public:
+  // Sequence number of an appended record, starting at 1.
+  using Lsn = std::uint64_t;
+  using RecordVisitor = std::function<void(std::span<const std::byte>)>;
+
+  // Opens `path` for appending, creating it if needed. With `sync` false records are written but never
+  // synced (tests and benchmarks only).
+  explicit Journal(std::string path, bool sync = true);
+  // Flushes everything appended so far, then stops the flusher.
+  ~Journal();
+
+  Journal(const Journal&) = delete;
+  Journal& operator=(const Journal&) = delete;
+
+  // Calls `visit` for every intact record of `path` in order and returns how many there were. A torn or
+  // corrupt tail (a crash mid-write) ends the log and is truncated away. A missing file has no records.
+  static std::size_t replay(const std::string& path, const RecordVisitor& visit);
+
+  Lsn append(std::span<const std::byte> record);
+  // Blocks until record `lsn` is on disk. Throws std::system_error if the journal could not be written.
+  void wait_durable(Lsn lsn);
+
+  // Bytes on disk plus bytes waiting for the flusher.
+  std::uint64_t size_bytes() const;
+
+  // Replaces the journal with the records `write` emits (a checkpoint). They go to `<path>.tmp`, which is
+  // synced and renamed over `path`, so a crash leaves either the old or the new journal. Waits for pending
+  // records first; the caller must make sure nothing is appended while it runs.
+  void rewrite(const std::function<void(const RecordVisitor& emit)>& write);
+
+private:
+  void run_flusher();
+
+  const std::string path_;
+  const bool sync_;
+  int fd_{-1};
+
+  mutable std::mutex mu_;
+  std::condition_variable work_cv_;    // flusher: records pending or stopping
+  std::condition_variable durable_cv_; // waiters: durable_ advanced or error_ set
+  std::vector<std::byte> pending_;
+  Lsn appended_{0};
+  Lsn durable_{0};
+  std::uint64_t file_bytes_{0};
+  bool stopping_{false};
+  std::exception_ptr error_;
+  std::thread flusher_;
+};
+
+} // namespace flight::infrastructure
@@ -0,0 +1,216 @@
+#pragma once
+
+#include "flight/application/change_groups.hpp"
+#include "flight/application/flight_repository.hpp"
+#include "flight/application/reservation_repository.hpp"
+#include "flight/infrastructure/journal.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace flight::infrastructure {
+
+class CatalogSnapshot;
+
+struct JournalOptions {
+  std::string path{"flight_booking.journal"};
+  // Journal size that triggers a background checkpoint (live state rewritten as a fresh, compact journal);
+  // 0 disables automatic checkpoints.
+  std::uint64_t checkpoint_bytes{64ull << 20};
+  // fdatasync every group commit. false keeps the journal but gives up durability (tests, benchmarks).
+  bool sync{true};
+  // The catalog snapshot the flights were loaded from before the journal is opened, if any. Checkpoints then
+  // record it as their base and write only the flights that differ from it; a journal with a base refuses to
+  // replay on top of any other snapshot.
+  std::shared_ptr<const CatalogSnapshot> snapshot;
+};
+
+// What startup replay restored. Id generators must start past the max ids so new ids do not collide.
+struct JournalRecovery {
+  std::size_t records{0};
+  std::size_t flights{0};
+  std::size_t reservations{0};
+  std::uint64_t max_flight_id{0};
+  std::uint64_t max_reservation_id{0};
+  std::uint64_t max_order_id{0};
+};
+
+// Write-ahead journal shared by JournaledFlightRepository and JournaledReservationRepository. Owns the wrapped
+// in-memory repositories: replays the journal into them on construction, then every successful change is
+// appended as a compact binary record and the call returns once the record is durable (group commit, see
+// Journal). Changes to one flight are journaled in the order they were applied. A change whose record cannot
+// be appended is not applied (or is undone). If a sync fails, the journal fails: that call and every later
+// one, reads included, throw, since memory may hold changes the disk does not; a restart recovers.
+// As IChangeGroups, it journals a group's changes as one record with one sync: the group holds the locks its
+// changes would take (change_mu_ shared and its flights' stripes, in stripe order) from begin_group() until it is
+// appended.
+class BookingJournal final : public flight::application::IChangeGroups {
+public:
+  // `flights` and `reservations` should be empty; they receive the replayed state.
+  BookingJournal(std::unique_ptr<flight::application::IFlightRepository> flights,
+                 std::unique_ptr<flight::application::IReservationRepository> reservations, JournalOptions options);
+  ~BookingJournal() override;
+
+  BookingJournal(const BookingJournal&) = delete;
+  BookingJournal& operator=(const BookingJournal&) = delete;
+
+  const JournalRecovery& recovery() const noexcept { return recovery_; }
+  std::uint64_t size_bytes() const { return journal_->size_bytes(); }
+
+  // Rewrites the journal as one upsert per flight plus its reservations, dropping the history. Changes
+  // wait while it runs.
+  void checkpoint();
+
+  // Writes a CatalogSnapshot of the flights to `path` and makes it the journal's base: the journal is then
+  // checkpointed down to the base's checksum, the flights that changed since, and the reservations, so a start
+  // with that snapshot replays only what the snapshot lacks. A full checkpoint runs first, so a crash at any
+  // point leaves a journal that replays correctly over whichever snapshot is on disk. Returns the flights
+  // written.
+  std::size_t write_snapshot(const std::string& path);
+
+  void begin_group(std::span<const flight::domain::FlightId> flight_ids) override;
+  void commit_group() override;
+  void end_group() noexcept override;
+
+private:
+  friend class JournaledFlightRepository;
+  friend class JournaledReservationRepository;
+
+  static constexpr std::size_t kStripes = 64;
+
+  // The change group open on this thread.
+  struct Group {
+    void add(std::span<const std::byte> record);
+
+    bool covers(flight::domain::FlightId flight_id) const;
+
+    BookingJournal* journal{nullptr};
+    std::vector<flight::domain::FlightId> flight_ids; // sorted, unique
+    std::shared_lock<std::shared_mutex> changes;
+    std::vector<std::unique_lock<std::mutex>> stripes;
+    std::vector<std::byte> records; // count x (u32 length, record)
+    std::uint32_t count{0};
+    std::size_t last{0};                                        // length of the last record
+    std::vector<flight::application::SeatBookingRequest> booked; // released if the group cannot be appended
+  };
+
+  template <typename Apply>
+  auto change(std::optional<flight::domain::FlightId> flight_id, Apply&& apply);
+  void commit(Journal::Lsn lsn);
+  // True if a change group on this journal is open on the calling thread.
+  bool in_group() const noexcept;
+  std::unique_ptr<Group> close_group() noexcept;
+  Journal::Lsn append_group(Group& group);
+  void release(flight::domain::FlightId flight_id, std::span<const flight::domain::Seat> seats);
+  void replay_record(std::span<const std::byte> bytes, std::set<std::uint64_t>& replayed_flights);
+  // Throws once a sync has failed.
+  void check() const;
+  template <typename Apply>
+  void change_all(Apply&& apply);
+  void remember_flight(flight::domain::FlightId flight_id);
+  void request_checkpoint_if_due();
+  // checkpoint() with change_mu_ already held exclusively: base_'s checksum, then every flight base_ does not
+  // hold as it is (all of them without a base), then the reservations.
+  void rewrite();
+  void run_checkpointer();
+
+  std::unique_ptr<flight::application::IFlightRepository> flights_;
+  std::unique_ptr<flight::application::IReservationRepository> reservations_;
+  const JournalOptions options_;
+  JournalRecovery recovery_;
+  std::unique_ptr<Journal> journal_;
+  std::atomic<bool> failed_{false};
+  std::shared_ptr<const CatalogSnapshot> base_; // guarded by change_mu_ (exclusive)
+
+  // Changes hold it shared (plus their flight's stripe, so records of one flight are appended in the order
+  // they were applied); checkpoint() holds it exclusive to see a quiescent state.
+  std::shared_mutex change_mu_;
+  std::array<std::mutex, kStripes> stripes_;
+  static thread_local Group* open_group_;
+
+  std::mutex ids_mu_;
+  std::set<std::uint64_t> flight_ids_; // flights with reservations, whose manifests checkpoints write
+
+  std::mutex checkpoint_mu_;
+  std::condition_variable checkpoint_cv_;
+  bool checkpoint_due_{false};
+  bool stopping_{false};
+  std::thread checkpointer_;
+};
+
+class JournaledFlightRepository final : public flight::application::IFlightRepository {
+public:
+  explicit JournaledFlightRepository(std::shared_ptr<BookingJournal> journal);
+
+  std::optional<flight::domain::Flight> get(flight::domain::FlightId id) const override;
+  std::vector<flight::domain::Flight> search(const flight::application::FlightSearchCriteria& criteria) const override;
+  bool visit(flight::domain::FlightId id, const flight::application::FlightVisitor& visitor) const override;
+  void visit_matches(const flight::application::FlightSearchCriteria& criteria,
+                     const flight::application::FlightVisitor& visitor) const override;
+  void visit_all(const flight::application::FlightVisitor& visitor) const override;
+  std::vector<flight::application::FlightSummary> search_summaries(
+      const flight::application::FlightSearchCriteria& criteria) const override;
+  std::pmr::vector<flight::domain::Flight> search_in(const flight::application::FlightSearchCriteria& criteria,
+                                                     std::pmr::memory_resource* mr) const override;
+  std::pmr::vector<flight::application::FlightSummary> search_summaries_in(
+      const flight::application::FlightSearchCriteria& criteria, std::pmr::memory_resource* mr) const override;
+
+  void upsert(flight::domain::Flight flight) override;
+  void upsert_many(std::vector<flight::domain::Flight> flights) override;
+  bool try_book_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) override;
+  bool try_book_seats(flight::domain::FlightId flight_id, std::span<const flight::domain::Seat> seats) override;
+  void release_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) override;
+  std::vector<bool> try_book_seat_batch(
+      std::span<const flight::application::SeatBookingRequest> requests) override;
+
+  std::optional<std::uint32_t> available_count(flight::domain::FlightId flight_id) const override;
+  std::vector<flight::domain::Seat> first_free_seats(flight::domain::FlightId flight_id, std::size_t n) const override;
+  std::optional<flight::domain::Seat> book_any_seat(flight::domain::FlightId flight_id) override;
+  std::vector<flight::domain::Seat> book_adjacent_seats(flight::domain::FlightId flight_id, std::size_t n) override;
+  bool durable() const noexcept override { return true; }
+
+private:
+  std::shared_ptr<BookingJournal> journal_;
+  flight::application::IFlightRepository& inner_;
+};
+
+class JournaledReservationRepository final : public flight::application::IReservationRepository {
+public:
+  explicit JournaledReservationRepository(std::shared_ptr<BookingJournal> journal);
+
+  void add(flight::domain::Reservation reservation) override;
+  void add_many(std::vector<flight::domain::Reservation> reservations) override;
+  std::optional<flight::domain::Reservation> get(flight::domain::ReservationId id) const override;
+  std::vector<flight::domain::Reservation> list_by_order(flight::domain::OrderId order_id) const override;
+  std::vector<flight::domain::Reservation> list_by_flight(flight::domain::FlightId flight_id) const override;
+
+private:
+  std::shared_ptr<BookingJournal> journal_;
+  flight::application::IReservationRepository& inner_;
+};
+
+struct JournaledRepositories {
+  std::shared_ptr<BookingJournal> journal;
+  std::unique_ptr<flight::application::IFlightRepository> flights;
+  std::unique_ptr<flight::application::IReservationRepository> reservations;
+};
+
+// Replays `options.path` into the given (empty, in-memory) repositories and wraps them in journaling
+// decorators that share one BookingJournal.
+JournaledRepositories make_journaled_repositories(
+    std::unique_ptr<flight::application::IFlightRepository> flights,
+    std::unique_ptr<flight::application::IReservationRepository> reservations, const JournalOptions& options);
+
+} // namespace flight::infrastructure
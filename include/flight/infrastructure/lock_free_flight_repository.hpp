@@ -0,0 +1,89 @@
+#pragma once
+
+#include "flight/application/flight_repository.hpp"
+#include "flight/infrastructure/route_index.hpp"
+#include "flight/util/epoch.hpp"
+#include "flight/util/epoch_table.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace flight::infrastructure {
+
+// In-memory repository whose seat state is an array of atomic 64-bit words per flight.
+// try_book_seat/release_seat are a single fetch_or/fetch_and on the seat's word: they and all readers find
+// the flight in an epoch-protected table without taking any lock, so they wait neither on other bookers nor on
+// upserts. upsert() replaces a flight's entry (seats included) wholesale; a seat operation that overlaps it
+// takes effect on the replaced entry, i.e. before the upsert.
+class LockFreeFlightRepository final : public flight::application::IFlightRepository {
+public:
+  LockFreeFlightRepository() = default;
+  ~LockFreeFlightRepository() override;
+
+  LockFreeFlightRepository(const LockFreeFlightRepository&) = delete;
+  LockFreeFlightRepository& operator=(const LockFreeFlightRepository&) = delete;
+
+  std::optional<flight::domain::Flight> get(flight::domain::FlightId id) const override;
+  std::vector<flight::domain::Flight> search(const flight::application::FlightSearchCriteria& criteria) const override;
+  bool visit(flight::domain::FlightId id, const flight::application::FlightVisitor& visitor) const override;
+  void visit_matches(const flight::application::FlightSearchCriteria& criteria,
+                     const flight::application::FlightVisitor& visitor) const override;
+  void visit_all(const flight::application::FlightVisitor& visitor) const override;
+  std::vector<flight::application::FlightSummary> search_summaries(
+      const flight::application::FlightSearchCriteria& criteria) const override;
+  std::pmr::vector<flight::domain::Flight> search_in(const flight::application::FlightSearchCriteria& criteria,
+                                                     std::pmr::memory_resource* mr) const override;
+  std::pmr::vector<flight::application::FlightSummary> search_summaries_in(
+      const flight::application::FlightSearchCriteria& criteria, std::pmr::memory_resource* mr) const override;
+  void upsert(flight::domain::Flight flight) override;
+  void upsert_many(std::vector<flight::domain::Flight> flights) override;
+
+  bool try_book_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) override;
+  bool try_book_seats(flight::domain::FlightId flight_id, std::span<const flight::domain::Seat> seats) override;
+  void release_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) override;
+  std::vector<bool> try_book_seat_batch(
+      std::span<const flight::application::SeatBookingRequest> requests) override;
+
+  std::optional<std::uint32_t> available_count(flight::domain::FlightId flight_id) const override;
+  std::vector<flight::domain::Seat> first_free_seats(flight::domain::FlightId flight_id, std::size_t n) const override;
+  std::optional<flight::domain::Seat> book_any_seat(flight::domain::FlightId flight_id) override;
+  std::vector<flight::domain::Seat> book_adjacent_seats(flight::domain::FlightId flight_id, std::size_t n) override;
+
+private:
+  struct Entry {
+    explicit Entry(const flight::domain::Flight& f);
+
+    flight::domain::Flight snapshot(flight::domain::Flight::allocator_type alloc = {}) const;
+    std::uint32_t booked_count() const noexcept;
+
+    // Immutable after construction; its own SeatMap is unused (seat state lives in `seats`).
+    flight::domain::Flight flight;
+    std::size_t word_count;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> seats;
+  };
+
+  // Appends the summaries of search_summaries() / search_summaries_in() to `out`.
+  template <typename Vector>
+  void collect_summaries(const flight::application::FlightSearchCriteria& criteria, Vector& out) const;
+
+  // Readers and seat operations call these pinned (util::EpochGuard); the entry stays valid until they unpin.
+  const Entry* find(flight::domain::FlightId id) const noexcept { return flights_.find(id.value()); }
+  // Books `seat` on `e` (false for a null entry, an invalid seat or a booked one).
+  static bool claim(const Entry* e, const flight::domain::Seat& seat);
+  // Books all of `seats` on `e` or none of them.
+  static bool claim_all(const Entry* e, std::span<const flight::domain::Seat> seats);
+
+  // Publishes `entry` for its flight id, re-indexing it if its route or departure changed, and retires the
+  // entry it replaces. The caller holds write_mu_ and is pinned. Returns false for a new id (not yet indexed).
+  bool replace(std::unique_ptr<Entry> entry);
+
+  // Serializes catalog changes (upserts); readers and seat operations never take it.
+  std::mutex write_mu_;
+  flight::util::EpochTable<const Entry> flights_;
+  flight::util::EpochRetireList retired_; // replaced entries
+  RouteIndex routes_;
+};
+
+} // namespace flight::infrastructure
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "flight/application/flight_repository.hpp"
+#include "flight/domain/airport_code.hpp"
+#include "flight/domain/flight.hpp"
+#include "flight/domain/ids.hpp"
+#include "flight/util/epoch.hpp"
+#include "flight/util/epoch_table.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace flight::infrastructure {
+
+// Secondary index (origin, destination) -> flights ordered by (departure, id), maintained incrementally on
+// upsert. A search is one hash lookup plus a binary-searched range scan over the departure window.
+// Each route's list is immutable once published: a change copies the route's list, edits the copy and swaps it
+// in, so find() needs no lock, only an EpochGuard held for as long as the returned span is used. Writers are
+// serialized by the owner (the lock that guards its flight catalog changes).
+class RouteIndex final {
+public:
+  using id_type = flight::domain::FlightId::value_type;
+
+  struct Entry {
+    flight::domain::Flight::time_point departure;
+    id_type id;
+
+    friend auto operator<=>(const Entry&, const Entry&) = default;
+  };
+
+  RouteIndex() = default;
+  ~RouteIndex();
+
+  RouteIndex(const RouteIndex&) = delete;
+  RouteIndex& operator=(const RouteIndex&) = delete;
+
+  void insert(const flight::domain::Flight& flight);
+  // Bulk insert: appends to each touched route and restores its order with one sort and merge, instead of a
+  // sorted insert (an O(route size) shift) per flight. Repeated flights are indexed once.
+  void insert_many(std::span<const flight::domain::Flight* const> flights);
+  void erase(const flight::domain::Flight& flight);
+
+  // Flights matching the criteria's route and departure window, in (departure, id) order; empty when the route
+  // has no flights. The criteria's limit is not applied: stale entries (see matches()) must not count towards it,
+  // so callers stop once limit_reached().
+  std::span<const Entry> find(const flight::application::FlightSearchCriteria& criteria) const;
+
+  // False for a stale entry: the flight's current version has another route or departure. A flight moves by
+  // inserting its new entry, publishing the new version, then erasing the old entry; lock-free readers that skip
+  // stale entries see it exactly once throughout, on one side of the move.
+  static bool matches(const Entry& entry, const flight::domain::Flight& current,
+                      const flight::application::FlightSearchCriteria& criteria) {
+    return current.departure() == entry.departure && current.origin() == criteria.origin &&
+           current.destination() == criteria.destination;
+  }
+
+  // True once `matched` entries that passed matches() fill the criteria's limit.
+  static bool limit_reached(std::size_t matched, const flight::application::FlightSearchCriteria& criteria) {
+    return criteria.limit != 0 && matched >= criteria.limit;
+  }
+
+  // Capacity to reserve for the results of a search over `entries`.
+  static std::size_t max_results(std::span<const Entry> entries,
+                                 const flight::application::FlightSearchCriteria& criteria) {
+    return criteria.limit == 0 ? entries.size() : std::min(entries.size(), criteria.limit);
+  }
+
+  // True if replacing `a` by `b` leaves the index unchanged.
+  static bool same_key(const flight::domain::Flight& a, const flight::domain::Flight& b) {
+    return a.origin() == b.origin() && a.destination() == b.destination() && a.departure() == b.departure();
+  }
+
+private:
+  // Both packed codes in one integer, so route lookup is a single integer hash/compare.
+  using RouteKey = std::uint32_t;
+
+  static RouteKey key(flight::domain::AirportCode origin, flight::domain::AirportCode destination) noexcept {
+    return (static_cast<RouteKey>(origin.packed()) << 16) | destination.packed();
+  }
+
+  using List = std::vector<Entry>;
+
+  static RouteKey key_of(const flight::domain::Flight& flight) noexcept {
+    return key(flight.origin(), flight.destination());
+  }
+  // Publishes `list` as `route`'s list and retires the previous one.
+  void publish(RouteKey route, List list);
+
+  // Emptied routes keep an empty list: keys are never removed.
+  flight::util::EpochTable<const List> routes_;
+  flight::util::EpochRetireList retired_;
+};
+
+} // namespace flight::infrastructure
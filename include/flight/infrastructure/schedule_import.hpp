@@ -0,0 +1,59 @@
+#pragma once
+
+#include "flight/application/flight_repository.hpp"
+#include "flight/domain/flight.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace flight::infrastructure {
+
+// Bulk import of flight schedules from CSV, one flight per line:
+//
+//   flight_id,origin,destination,departure,rows,seats_per_row
+//   1001,WAW,FRA,2026-11-02T06:45Z,30,6
+//
+// `departure` is UTC, YYYY-MM-DDTHH:MM[:SS][Z] (a space may replace the T), or integer seconds since the
+// epoch. A first line starting with "flight_id" is a header; blank lines are skipped. Fields are not quoted.
+struct ScheduleImportOptions {
+  // Parser threads; 0 means std::thread::hardware_concurrency().
+  std::size_t threads{0};
+  // Bytes read per chunk; each chunk is cut at its last newline and parsed as a unit.
+  std::size_t chunk_bytes{1u << 20};
+  // Flights per upsert_many() call.
+  std::size_t batch_size{16384};
+  // Malformed rows kept in ScheduleImportResult::errors (all of them are counted).
+  std::size_t max_errors{100};
+};
+
+struct ScheduleImportError {
+  std::size_t line{0}; // 1-based
+  std::string message;
+};
+
+struct ScheduleImportResult {
+  std::size_t rows{0}; // data rows, excluding the header and blank lines
+  std::size_t imported{0};
+  std::size_t malformed{0};
+  std::size_t batches{0};
+  std::uint64_t max_flight_id{0};
+  double seconds{0};
+  std::vector<ScheduleImportError> errors; // the first max_errors malformed rows, in file order
+
+  double rows_per_second() const noexcept { return seconds > 0 ? static_cast<double>(rows) / seconds : 0; }
+};
+
+// Parses one data row (without its line terminator). Throws std::invalid_argument describing the problem.
+flight::domain::Flight parse_schedule_row(std::string_view row);
+
+// Streams `in` in chunks: one reader thread, `threads` parsers and the calling thread applying parsed rows with
+// upsert_many() in file order, so a later row for the same flight id wins. Memory stays bounded by a few chunks
+// per parser. Malformed rows are counted and reported, not fatal; repository errors propagate.
+ScheduleImportResult import_schedule(std::istream& in, flight::application::IFlightRepository& flights,
+                                     const ScheduleImportOptions& options = {});
+
+} // namespace flight::infrastructure
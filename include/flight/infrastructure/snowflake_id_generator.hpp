@@ -0,0 +1,70 @@
+#pragma once
+
+#include "flight/application/clock.hpp"
+#include "flight/application/id_generator.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace flight::infrastructure {
+
+// Time-ordered 64-bit ids that need no coordination between processes: each process is given its own
+// node id and composes ids as
+//
+//   0 | 41 bits: milliseconds since kEpoch | 10 bits: node id | 12 bits: sequence within the millisecond
+//
+// so two processes with different node ids can never produce the same id. Each thread leases kLeaseSize
+// sequence numbers of the current millisecond at a time and hands them out locally, so the shared state is
+// touched once per lease instead of once per id; a new millisecond starts a new lease. Ids increase strictly
+// within a thread and across milliseconds, but interleave across threads within one. When more than 4096 ids
+// are needed within one millisecond, or the clock steps backwards, the generator runs ahead of the clock on
+// later milliseconds instead of waiting or reusing a timestamp. Nothing of that is persisted: a process
+// restarted while it was still ahead can issue ids the previous run already issued.
+// Flights, reservations and orders each have their own sequence.
+class SnowflakeIdGenerator final : public flight::application::IIdGenerator {
+public:
+  static constexpr unsigned kNodeBits = 10;
+  static constexpr unsigned kSequenceBits = 12;
+  static constexpr unsigned kTimestampBits = 41;
+  static constexpr std::uint32_t kMaxNodeId = (1u << kNodeBits) - 1;
+  static constexpr std::uint32_t kLeaseSize = 64;
+  // 2020-01-01T00:00:00Z; 41 bits of milliseconds reach into 2089.
+  static constexpr std::chrono::milliseconds kEpoch{1577836800000};
+
+  struct Parts {
+    std::chrono::system_clock::time_point time;
+    std::uint32_t node_id;
+    std::uint32_t sequence;
+  };
+
+  // `clock` must outlive the generator. Throws std::invalid_argument for a node id above kMaxNodeId.
+  SnowflakeIdGenerator(std::uint32_t node_id, const flight::application::IClock& clock);
+
+  flight::domain::FlightId next_flight_id() override { return flight::domain::FlightId{next(kFlight)}; }
+  flight::domain::ReservationId next_reservation_id() override {
+    return flight::domain::ReservationId{next(kReservation)};
+  }
+  flight::domain::OrderId next_order_id() override { return flight::domain::OrderId{next(kOrder)}; }
+
+  static Parts decode(std::uint64_t id);
+
+private:
+  enum Sequence : std::size_t { kFlight, kReservation, kOrder, kSequences };
+
+  // The last id leased from the sequence.
+  struct alignas(64) Last {
+    std::atomic<std::uint64_t> id{0};
+  };
+
+  std::uint64_t next(Sequence s);
+
+  std::array<Last, kSequences> last_;
+  const std::uint32_t node_id_;
+  const flight::application::IClock& clock_;
+  const std::uint64_t instance_; // tells this generator's per-thread leases from other instances'
+};
+
+} // namespace flight::infrastructure
@@ -1,33 +1,83 @@
 #pragma once
 
 #include "flight/application/flight_repository.hpp"
+#include "flight/infrastructure/sqlite_statement_cache.hpp"
 
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 struct sqlite3;
 
 namespace flight::infrastructure {
 
+struct SqliteOptions {
+  // ":memory:" is a private in-memory database on a single connection (reads share the writer).
+  // A file path enables WAL journaling with one writer connection plus a pool of read-only connections.
+  // The file holds flights and booked seats only; reservations live in their own (in-memory) repository.
+  std::string path{":memory:"};
+  std::size_t reader_connections{4};
+  std::string synchronous{"NORMAL"}; // PRAGMA synchronous: OFF | NORMAL | FULL | EXTRA
+  int busy_timeout_ms{5000};
+  std::int64_t mmap_size{0};         // PRAGMA mmap_size in bytes; 0 disables memory-mapped I/O
+};
+
 class SqliteFlightRepository final : public flight::application::IFlightRepository {
 public:
   explicit SqliteFlightRepository(bool in_memory = true);
+  explicit SqliteFlightRepository(SqliteOptions options);
   ~SqliteFlightRepository() override;
 
   std::optional<flight::domain::Flight> get(flight::domain::FlightId id) const override;
   std::vector<flight::domain::Flight> search(const flight::application::FlightSearchCriteria& criteria) const override;
+  bool visit(flight::domain::FlightId id, const flight::application::FlightVisitor& visitor) const override;
+  void visit_matches(const flight::application::FlightSearchCriteria& criteria,
+                     const flight::application::FlightVisitor& visitor) const override;
+  void visit_all(const flight::application::FlightVisitor& visitor) const override;
+  std::vector<flight::application::FlightSummary> search_summaries(
+      const flight::application::FlightSearchCriteria& criteria) const override;
+  std::pmr::vector<flight::application::FlightSummary> search_summaries_in(
+      const flight::application::FlightSearchCriteria& criteria, std::pmr::memory_resource* mr) const override;
   void upsert(flight::domain::Flight flight) override;
+  void upsert_many(std::vector<flight::domain::Flight> flights) override;
 
   bool try_book_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) override;
+  bool try_book_seats(flight::domain::FlightId flight_id, std::span<const flight::domain::Seat> seats) override;
   void release_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) override;
+  std::vector<bool> try_book_seat_batch(
+      std::span<const flight::application::SeatBookingRequest> requests) override;
+
+  std::optional<std::uint32_t> available_count(flight::domain::FlightId flight_id) const override;
+  std::vector<flight::domain::Seat> first_free_seats(flight::domain::FlightId flight_id, std::size_t n) const override;
+  std::optional<flight::domain::Seat> book_any_seat(flight::domain::FlightId flight_id) override;
+  std::vector<flight::domain::Seat> book_adjacent_seats(flight::domain::FlightId flight_id, std::size_t n) override;
+  bool durable() const noexcept override { return options_.path != ":memory:"; }
 
 private:
+  struct Connection;
+  class ReadLease;
+
   void prepare_schema();
   void exec(const char* sql) const;
+  // Appends the summaries of search_summaries() / search_summaries_in() to `out`.
+  template <typename Vector>
+  void collect_summaries(const flight::application::FlightSearchCriteria& criteria, Vector& out) const;
 
-  flight::domain::Flight load_flight_by_id_locked(flight::domain::FlightId id) const;
+  SqliteOptions options_;
 
-  sqlite3* db_{nullptr};
+  // Writes (and, for :memory:, reads) go through the writer connection under mu_.
+  std::unique_ptr<Connection> writer_;
   mutable std::mutex mu_;
+
+  // Idle read-only connections (file-backed only); get/search check one out for the duration of a query.
+  bool pooled_reads_{false};
+  mutable std::vector<std::unique_ptr<Connection>> idle_readers_;
+  mutable std::mutex readers_mu_;
+  mutable std::condition_variable readers_cv_;
 };
 
 } // namespace flight::infrastructure
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <unordered_map>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+namespace flight::infrastructure {
+
+// Prepared statements for one connection, compiled on first use and finalized with the cache.
+// Not thread-safe: callers serialize access to the connection.
+class SqliteStatementCache final {
+public:
+  // Borrowed statement; reset and unbound when the lease ends, so the next user starts clean and
+  // no read cursor stays open between calls.
+  class Lease final {
+  public:
+    explicit Lease(sqlite3_stmt* st) noexcept : st_(st) {}
+    ~Lease();
+
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+
+    sqlite3_stmt* get() const noexcept { return st_; }
+
+  private:
+    sqlite3_stmt* st_;
+  };
+
+  explicit SqliteStatementCache(sqlite3* db) noexcept : db_(db) {}
+  ~SqliteStatementCache();
+
+  SqliteStatementCache(const SqliteStatementCache&) = delete;
+  SqliteStatementCache& operator=(const SqliteStatementCache&) = delete;
+
+  // `sql` must have static storage duration (a string literal): it is the cache key.
+  Lease acquire(const char* sql);
+
+private:
+  sqlite3* db_;
+  std::unordered_map<const char*, sqlite3_stmt*> statements_;
+};
+
+} // namespace flight::infrastructure
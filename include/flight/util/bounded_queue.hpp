@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace flight::util {
+
+// Bounded multi-producer/multi-consumer queue. Producers choose their backpressure: try_push() rejects when
+// the queue is full, push() waits for room (optionally up to a deadline). Consumers drain in batches with
+// pop_batch(), so one lock round trip hands over many items. close() wakes everyone: pushes fail from then
+// on, while consumers still drain what is queued.
+template <typename T>
+class BoundedQueue final {
+public:
+  explicit BoundedQueue(std::size_t capacity) : capacity_(capacity) {
+    if (capacity_ == 0) throw std::invalid_argument("BoundedQueue capacity must be > 0");
+  }
+
+  BoundedQueue(const BoundedQueue&) = delete;
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+  // False (and `item` untouched) if the queue is full or closed.
+  bool try_push(T& item) {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      if (closed_ || items_.size() == capacity_) return false;
+      items_.push_back(std::move(item));
+    }
+    not_empty_.notify_one();
+    return true;
+  }
+
+  // Waits for room; false (and `item` untouched) if the queue is closed first.
+  bool push(T& item) { return push_until(item, std::chrono::steady_clock::time_point::max()); }
+
+  // Waits for room until `deadline`; false (and `item` untouched) on timeout or if the queue is closed.
+  bool push_until(T& item, std::chrono::steady_clock::time_point deadline) {
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      const auto ready = [this] { return closed_ || items_.size() < capacity_; };
+      if (deadline == std::chrono::steady_clock::time_point::max()) {
+        not_full_.wait(lk, ready);
+      } else if (!not_full_.wait_until(lk, deadline, ready)) {
+        return false;
+      }
+      if (closed_) return false;
+      items_.push_back(std::move(item));
+    }
+    not_empty_.notify_one();
+    return true;
+  }
+
+  // Waits for at least one item, then moves up to `max` items into `out` (appended) and returns how many;
+  // 0 once the queue is closed and empty.
+  std::size_t pop_batch(std::vector<T>& out, std::size_t max) {
+    std::size_t n = 0;
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      not_empty_.wait(lk, [this] { return closed_ || !items_.empty(); });
+      n = std::min(max, items_.size());
+      for (std::size_t i = 0; i < n; ++i) {
+        out.push_back(std::move(items_.front()));
+        items_.pop_front();
+      }
+    }
+    if (n > 0) not_full_.notify_all();
+    return n;
+  }
+
+  void close() {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      closed_ = true;
+    }
+    not_empty_.notify_all();
+    not_full_.notify_all();
+  }
+
+  std::size_t size() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return items_.size();
+  }
+  std::size_t capacity() const noexcept { return capacity_; }
+
+private:
+  const std::size_t capacity_;
+  mutable std::mutex mu_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::deque<T> items_;
+  bool closed_{false};
+};
+
+} // namespace flight::util
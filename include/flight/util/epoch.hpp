@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace flight::util {
+
+// Epoch-based reclamation (RCU style) for immutable versions published through an atomic pointer.
+// A reader pins the current epoch with an EpochGuard for as long as it dereferences published pointers; a
+// writer publishes a new version and hands the old one to an EpochRetireList, which frees it only once no
+// reader pinned before the swap is still pinned. Neither side ever waits for the other: a pin is a store to
+// the reader's own slot, and a slow reader only delays frees. Readers are tracked process-wide, one slot per
+// thread (slots are recycled when threads exit); pins nest.
+class EpochGuard final {
+public:
+  EpochGuard();
+  ~EpochGuard();
+
+  EpochGuard(const EpochGuard&) = delete;
+  EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+// Versions retired by the writers of one object. Not thread-safe: the owner serializes calls, typically under
+// the lock its writers already hold. The destructor frees whatever is still pending, so it must only run once
+// no reader can reach those versions.
+class EpochRetireList final {
+public:
+  using Deleter = void (*)(void* object, void* context);
+  // Pending versions that trigger a reclaim() from retire(). After a reclaim that could not free everything
+  // (a reader is still pinned), the next one waits until the list has doubled, so a long pin costs amortized
+  // O(1) per retire rather than a scan each.
+  static constexpr std::size_t kReclaimThreshold = 16;
+
+  EpochRetireList() = default;
+  ~EpochRetireList();
+
+  EpochRetireList(const EpochRetireList&) = delete;
+  EpochRetireList& operator=(const EpochRetireList&) = delete;
+
+  // Call after `object` has been replaced in its atomic pointer: deleter(object, context) runs once every
+  // reader that could have loaded it has unpinned.
+  void retire(void* object, Deleter deleter, void* context);
+  // Frees the versions no pinned reader can hold; returns how many.
+  std::size_t reclaim();
+  std::size_t pending() const noexcept { return retired_.size(); }
+
+private:
+  struct Retired {
+    void* object;
+    Deleter deleter;
+    void* context;
+    std::uint64_t epoch;
+  };
+
+  std::vector<Retired> retired_;
+  std::size_t next_reclaim_{kReclaimThreshold};
+};
+
+} // namespace flight::util
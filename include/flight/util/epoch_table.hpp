@@ -0,0 +1,120 @@
+#pragma once
+
+#include "flight/util/epoch.hpp"
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace flight::util {
+
+// Open-addressing hash map from 64-bit keys to T*, read without locks. find() and for_each() may run
+// concurrently with the writer as long as the caller holds an EpochGuard; exchange() and reserve() are for one
+// writer at a time (the owner serializes them). Keys are never removed, only re-pointed, and the table keeps at
+// most half its slots used, so a probe always ends at an empty slot. Growing publishes a doubled copy and
+// retires the old array. The table does not own the values: the owner frees them (retiring replaced ones).
+template <typename T>
+class EpochTable final {
+public:
+  EpochTable() : slots_(new Slots(kInitialCapacity)) {}
+  ~EpochTable() { delete slots_.load(std::memory_order_relaxed); }
+
+  EpochTable(const EpochTable&) = delete;
+  EpochTable& operator=(const EpochTable&) = delete;
+
+  // The value mapped to `key`, or nullptr.
+  T* find(std::uint64_t key) const noexcept {
+    const Slots* s = slots_.load(std::memory_order_acquire);
+    for (std::size_t i = s->home(key);; i = (i + 1) & s->mask) {
+      T* value = s->slots[i].value.load(std::memory_order_acquire);
+      if (value == nullptr) return nullptr;
+      if (s->slots[i].key.load(std::memory_order_relaxed) == key) return value;
+    }
+  }
+
+  // Calls fn(T&) for every mapped value, in table order.
+  template <typename Fn>
+  void for_each(Fn&& fn) const {
+    const Slots* s = slots_.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i <= s->mask; ++i) {
+      if (T* value = s->slots[i].value.load(std::memory_order_acquire)) fn(*value);
+    }
+  }
+
+  std::size_t size() const noexcept { return size_.load(std::memory_order_relaxed); }
+
+  // Writer: maps `key` to `value` (not null) and returns the value it replaced, or nullptr for a new key.
+  T* exchange(std::uint64_t key, T* value) {
+    if (T* old = replace(key, value)) return old;
+    reserve(size() + 1);
+    Slots* s = slots_.load(std::memory_order_relaxed);
+    std::size_t i = s->home(key);
+    while (s->slots[i].value.load(std::memory_order_relaxed) != nullptr) i = (i + 1) & s->mask;
+    // The key is in place before the value makes the slot visible.
+    s->slots[i].key.store(key, std::memory_order_relaxed);
+    s->slots[i].value.store(value, std::memory_order_release);
+    size_.store(size() + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  // Writer: grows the table so `n` keys fit without another resize.
+  void reserve(std::size_t n) {
+    const Slots* s = slots_.load(std::memory_order_relaxed);
+    if (2 * n <= s->mask + 1) return;
+    auto* grown = new Slots(std::bit_ceil(2 * n));
+    for (std::size_t i = 0; i <= s->mask; ++i) {
+      if (T* value = s->slots[i].value.load(std::memory_order_relaxed)) {
+        const auto key = s->slots[i].key.load(std::memory_order_relaxed);
+        std::size_t j = grown->home(key);
+        while (grown->slots[j].value.load(std::memory_order_relaxed) != nullptr) j = (j + 1) & grown->mask;
+        grown->slots[j].key.store(key, std::memory_order_relaxed);
+        grown->slots[j].value.store(value, std::memory_order_relaxed);
+      }
+    }
+    slots_.store(grown, std::memory_order_release);
+    retired_.retire(const_cast<Slots*>(s), [](void* old, void*) { delete static_cast<Slots*>(old); }, nullptr);
+  }
+
+private:
+  static constexpr std::size_t kInitialCapacity = 16;
+
+  struct Slot {
+    std::atomic<std::uint64_t> key{0};
+    std::atomic<T*> value{nullptr};
+  };
+
+  struct Slots {
+    explicit Slots(std::size_t capacity)
+        : mask(capacity - 1), shift(64 - static_cast<unsigned>(std::countr_zero(capacity))),
+          slots(std::make_unique<Slot[]>(capacity)) {}
+
+    // Fibonacci hashing: sequential ids spread over the whole table.
+    std::size_t home(std::uint64_t key) const noexcept {
+      return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    std::size_t mask;
+    unsigned shift;
+    std::unique_ptr<Slot[]> slots;
+  };
+
+  T* replace(std::uint64_t key, T* value) {
+    Slots* s = slots_.load(std::memory_order_relaxed);
+    for (std::size_t i = s->home(key);; i = (i + 1) & s->mask) {
+      T* current = s->slots[i].value.load(std::memory_order_relaxed);
+      if (current == nullptr) return nullptr;
+      if (s->slots[i].key.load(std::memory_order_relaxed) == key) {
+        s->slots[i].value.store(value, std::memory_order_release);
+        return current;
+      }
+    }
+  }
+
+  std::atomic<Slots*> slots_;
+  std::atomic<std::size_t> size_{0};
+  EpochRetireList retired_; // old arrays, freed once no reader can still be probing them
+};
+
+} // namespace flight::util
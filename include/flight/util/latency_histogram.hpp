@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace flight::util {
+
+// Log-linear histogram of latencies (or any non-negative integer), HDR-style: values below 16 get exact
+// buckets, larger values 8 sub-buckets per power of two (~12% relative precision) over the full 64-bit range.
+// Single writer, any number of concurrent readers: record() is a relaxed load/store on one counter, so the
+// owning thread never executes a locked instruction; readers take snapshots and diff them for intervals.
+class LatencyHistogram final {
+public:
+  static constexpr std::size_t kSubBuckets = 8;
+  static constexpr std::size_t kLinear = 16;
+  static constexpr std::size_t kBuckets = kLinear + (64 - 4) * kSubBuckets;
+
+  struct Snapshot {
+    std::array<std::uint64_t, kBuckets> counts{};
+    std::uint64_t sum{0}; // of recorded values (wraps after ~584 years of nanoseconds)
+
+    std::uint64_t total() const noexcept {
+      std::uint64_t n = 0;
+      for (const auto c : counts) n += c;
+      return n;
+    }
+
+    // Upper bound of the bucket holding the q-quantile (0 <= q <= 1); 0 when empty.
+    std::uint64_t percentile(double q) const noexcept {
+      const auto n = total();
+      if (n == 0) return 0;
+      auto rank = static_cast<std::uint64_t>(q * static_cast<double>(n));
+      if (rank >= n) rank = n - 1;
+      std::uint64_t seen = 0;
+      for (std::size_t i = 0; i < kBuckets; ++i) {
+        seen += counts[i];
+        if (seen > rank) return bucket_upper(i);
+      }
+      return bucket_upper(kBuckets - 1);
+    }
+
+    Snapshot& operator+=(const Snapshot& other) noexcept {
+      for (std::size_t i = 0; i < kBuckets; ++i) counts[i] += other.counts[i];
+      sum += other.sum;
+      return *this;
+    }
+    Snapshot& operator-=(const Snapshot& other) noexcept {
+      for (std::size_t i = 0; i < kBuckets; ++i) counts[i] -= other.counts[i];
+      sum -= other.sum;
+      return *this;
+    }
+  };
+
+  static constexpr std::size_t bucket_of(std::uint64_t value) noexcept {
+    if (value < kLinear) return static_cast<std::size_t>(value);
+    const auto exponent = static_cast<std::size_t>(std::bit_width(value)) - 1; // >= 4
+    const auto sub = static_cast<std::size_t>(value >> (exponent - 3)) & (kSubBuckets - 1);
+    return kLinear + (exponent - 4) * kSubBuckets + sub;
+  }
+
+  // Largest value that maps to bucket `index`.
+  static constexpr std::uint64_t bucket_upper(std::size_t index) noexcept {
+    if (index < kLinear) return index;
+    const auto exponent = (index - kLinear) / kSubBuckets + 4;
+    const auto sub = (index - kLinear) % kSubBuckets;
+    const auto width = std::uint64_t{1} << (exponent - 3);
+    return (std::uint64_t{1} << exponent) + (sub + 1) * width - 1;
+  }
+
+  // Owning thread only.
+  void record(std::uint64_t value) noexcept {
+    auto& c = counts_[bucket_of(value)];
+    c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    sum_.store(sum_.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+
+  // Adds the current counts to `out`; safe to call while the owner records.
+  void add_to(Snapshot& out) const noexcept {
+    for (std::size_t i = 0; i < kBuckets; ++i) out.counts[i] += counts_[i].load(std::memory_order_relaxed);
+    out.sum += sum_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::array<std::atomic<std::uint64_t>, kBuckets> counts_{};
+  std::atomic<std::uint64_t> sum_{0};
+};
+
+// A latency for humans: "850ns", "12.5us" or "3.2ms".
+std::string format_ns(std::uint64_t ns);
+
+} // namespace flight::util
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "flight/util/metrics.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+namespace flight::util {
+
+// Metric ids for one lock in one mode (e.g. lock="in_memory_flights.map", mode="shared").
+struct LockMetrics {
+  HistogramId wait;       // contended acquisitions only
+  HistogramId hold;
+  CounterId acquisitions;
+  CounterId contended;
+
+  static LockMetrics named(std::string_view lock, std::string_view mode) {
+    auto& m = Metrics::global();
+    const std::string labels = "lock=\"" + std::string(lock) + "\",mode=\"" + std::string(mode) + "\"";
+    return LockMetrics{
+        m.histogram("flight_lock_wait_seconds", labels, "Time spent waiting for a contended lock."),
+        m.histogram("flight_lock_hold_seconds", labels, "Time a lock was held (sampled)."),
+        m.counter("flight_lock_acquisitions_total", labels, "Lock acquisitions."),
+        m.counter("flight_lock_contended_total", labels, "Lock acquisitions that had to wait."),
+    };
+  }
+};
+
+// std::unique_lock / std::shared_lock that records wait and hold times. Acquisition counts are exact and every
+// contended acquisition is timed for the wait histogram; hold times are sampled (1 in kHoldSampleRate
+// acquisitions per thread) so the uncontended path is a try_lock and a counter bump, with no clock reads.
+// With FLIGHT_METRICS=0 this is the plain lock.
+template <typename Lock>
+class MeteredLock final {
+public:
+  using mutex_type = typename Lock::mutex_type;
+  static constexpr std::uint32_t kHoldSampleRate = 16;
+
+  MeteredLock(mutex_type& mutex, const LockMetrics& metrics) : lock_(mutex, std::defer_lock) {
+#if FLIGHT_METRICS
+    metrics_ = &metrics;
+#else
+    static_cast<void>(metrics);
+#endif
+    lock();
+  }
+  ~MeteredLock() {
+    if (lock_.owns_lock()) unlock();
+  }
+
+  MeteredLock(const MeteredLock&) = delete;
+  MeteredLock& operator=(const MeteredLock&) = delete;
+
+  void lock() {
+#if FLIGHT_METRICS
+    auto& m = Metrics::global();
+    m.add(metrics_->acquisitions);
+    thread_local std::uint32_t acquisitions = 0;
+    timed_ = ++acquisitions % kHoldSampleRate == 0;
+    if (lock_.try_lock()) {
+      if (timed_) acquired_ = std::chrono::steady_clock::now();
+      return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    lock_.lock();
+    acquired_ = std::chrono::steady_clock::now();
+    timed_ = true;
+    m.add(metrics_->contended);
+    m.record(metrics_->wait, nanoseconds(acquired_ - start));
+#else
+    lock_.lock();
+#endif
+  }
+
+  void unlock() {
+#if FLIGHT_METRICS
+    if (!timed_) {
+      lock_.unlock();
+      return;
+    }
+    const auto held = std::chrono::steady_clock::now() - acquired_;
+    lock_.unlock();
+    Metrics::global().record(metrics_->hold, nanoseconds(held));
+#else
+    lock_.unlock();
+#endif
+  }
+
+  bool owns_lock() const noexcept { return lock_.owns_lock(); }
+
+private:
+#if FLIGHT_METRICS
+  static std::uint64_t nanoseconds(std::chrono::steady_clock::duration d) noexcept {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+  }
+
+  const LockMetrics* metrics_{nullptr};
+  std::chrono::steady_clock::time_point acquired_{};
+  bool timed_{false};
+#endif
+  Lock lock_;
+};
+
+template <typename Mutex>
+using MeteredUniqueLock = MeteredLock<std::unique_lock<Mutex>>;
+template <typename Mutex>
+using MeteredSharedLock = MeteredLock<std::shared_lock<Mutex>>;
+
+} // namespace flight::util
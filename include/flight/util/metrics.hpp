@@ -0,0 +1,147 @@
+#pragma once
+
+#include "flight/util/latency_histogram.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Build with -DFLIGHT_METRICS=0 (make METRICS=0) to compile all instrumentation out: timers and metered
+// locks become plain scopes/locks and nothing is recorded. The registry itself still links, so the CLI
+// `stats` command keeps working (and reports that metrics are disabled).
+#ifndef FLIGHT_METRICS
+#define FLIGHT_METRICS 1
+#endif
+
+namespace flight::util {
+
+struct HistogramId {
+  std::uint32_t index{0};
+};
+
+struct CounterId {
+  std::uint32_t index{0};
+};
+
+// Process-wide metrics registry. Metrics are registered once by (name, labels) and then recorded into
+// per-thread shards without locks or shared cache lines; snapshot() aggregates all shards on demand.
+// Histograms hold nanoseconds and are exported in seconds.
+class Metrics final {
+public:
+  static constexpr std::size_t kMaxHistograms = 256;
+  static constexpr std::size_t kMaxCounters = 256;
+
+  Metrics();
+  ~Metrics();
+  Metrics(const Metrics&) = delete;
+  Metrics& operator=(const Metrics&) = delete;
+
+  static Metrics& global();
+  static constexpr bool enabled() noexcept { return FLIGHT_METRICS != 0; }
+
+  // Idempotent: the same (name, labels) returns the same id. `labels` is Prometheus label syntax without
+  // braces, e.g. `repo="inmem",op="get"`. Throws std::length_error past kMaxHistograms/kMaxCounters.
+  HistogramId histogram(std::string_view name, std::string_view labels, std::string_view help);
+  CounterId counter(std::string_view name, std::string_view labels, std::string_view help);
+
+  void record(HistogramId id, std::uint64_t value) noexcept;
+  void add(CounterId id, std::uint64_t n = 1) noexcept;
+
+  struct HistogramValue {
+    std::string name;
+    std::string labels;
+    std::string help;
+    LatencyHistogram::Snapshot data;
+  };
+  struct CounterValue {
+    std::string name;
+    std::string labels;
+    std::string help;
+    std::uint64_t value{0};
+  };
+  struct Snapshot {
+    std::vector<HistogramValue> histograms;
+    std::vector<CounterValue> counters;
+  };
+
+  Snapshot snapshot() const;
+
+  // Histograms as Prometheus summaries (0.5/0.99/0.999 quantiles, _sum, _count), counters as counters.
+  void write_prometheus(std::ostream& out) const;
+  // Human-readable table of everything recorded so far (for the CLI `stats` command).
+  void write_table(std::ostream& out) const;
+
+private:
+  struct Definition {
+    std::string name;
+    std::string labels;
+    std::string help;
+  };
+
+  // One per thread that recorded; owned by the registry so data survives thread exit. Written only by its
+  // thread, read by snapshot().
+  struct Shard {
+    ~Shard();
+    std::array<std::atomic<LatencyHistogram*>, kMaxHistograms> histograms{};
+    std::array<std::atomic<std::uint64_t>, kMaxCounters> counters{};
+  };
+
+  Shard& local_shard();
+
+  const std::uint64_t instance_id_;
+  mutable std::mutex mu_;
+  std::vector<Definition> histogram_defs_;
+  std::vector<Definition> counter_defs_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+// Records the lifetime of a scope into a histogram of the global registry.
+class ScopedTimer final {
+public:
+#if FLIGHT_METRICS
+  explicit ScopedTimer(HistogramId id) noexcept : id_(id), start_(std::chrono::steady_clock::now()) {}
+  ~ScopedTimer() {
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    Metrics::global().record(id_, static_cast<std::uint64_t>(
+                                      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+  }
+#else
+  explicit ScopedTimer(HistogramId) noexcept {}
+#endif
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+#if FLIGHT_METRICS
+private:
+  HistogramId id_;
+  std::chrono::steady_clock::time_point start_;
+#endif
+};
+
+} // namespace flight::util
+
+// Times the rest of the enclosing scope into histogram `name{labels}`, registered once per call site.
+// FLIGHT_METRICS_COUNT adds one to counter `name{labels}`. Both expand to nothing with FLIGHT_METRICS=0.
+#if FLIGHT_METRICS
+#define FLIGHT_METRICS_TIME(var, name, labels, help)                                                            \
+  static const ::flight::util::HistogramId var##_id = ::flight::util::Metrics::global().histogram(name, labels, help); \
+  const ::flight::util::ScopedTimer var(var##_id)
+#define FLIGHT_METRICS_COUNT(name, labels, help)                                                                \
+  do {                                                                                                        \
+    static const ::flight::util::CounterId flight_metrics_counter_id =                                        \
+        ::flight::util::Metrics::global().counter(name, labels, help);                                         \
+    ::flight::util::Metrics::global().add(flight_metrics_counter_id);                                          \
+  } while (false)
+#else
+#define FLIGHT_METRICS_TIME(var, name, labels, help) static_cast<void>(0)
+#define FLIGHT_METRICS_COUNT(name, labels, help) static_cast<void>(0)
+#endif
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace flight::util {
+
+// Hierarchical timing wheel: kLevels wheels of kSlots slots each, level l counting in units of
+// kSlots^l ticks. A timer is filed in the coarsest level its distance needs; when time reaches a coarse
+// slot, its timers cascade down into finer levels, and level 0 fires them on their exact tick. Scheduling,
+// cancelling and firing are O(1) per timer (plus at most kLevels - 1 cascades over its lifetime), so
+// millions of outstanding timers cost no per-timer scan and no thread each.
+// Time is an abstract tick count that only moves forward through advance(). Not thread-safe.
+template <typename T>
+class TimerWheel final {
+public:
+  using Tick = std::uint64_t;
+  // Identifies a scheduled timer for cancel(); handles of fired or cancelled timers are recognised as stale.
+  using Handle = std::uint64_t;
+
+  static constexpr unsigned kSlotBits = 8;
+  static constexpr std::size_t kSlots = std::size_t{1} << kSlotBits;
+  static constexpr unsigned kLevels = 4; // 2^32 ticks before a timer needs re-filing at the top level
+
+  explicit TimerWheel(Tick now = 0) : now_(now) { heads_.fill(kNil); }
+
+  Tick now() const noexcept { return now_; }
+  std::size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  // Arms a timer that fires on the first advance() that reaches `deadline` (the next advance() that moves
+  // time at all, if the deadline has already passed).
+  Handle schedule(Tick deadline, T value) {
+    std::uint32_t index = free_;
+    if (index != kNil) {
+      free_ = nodes_[index].next;
+    } else {
+      index = static_cast<std::uint32_t>(nodes_.size());
+      nodes_.emplace_back();
+    }
+    Node& n = nodes_[index];
+    n.value = std::move(value);
+    n.deadline = deadline;
+    n.live = true;
+    link(index, now_ + 1);
+    ++size_;
+    return (Handle{n.generation} << 32) | index;
+  }
+
+  // False if the timer already fired or was cancelled.
+  bool cancel(Handle handle) {
+    const auto index = static_cast<std::uint32_t>(handle);
+    if (index >= nodes_.size()) return false;
+    Node& n = nodes_[index];
+    if (!n.live || n.generation != static_cast<std::uint32_t>(handle >> 32)) return false;
+    unlink(index);
+    release(index);
+    return true;
+  }
+
+  // Moves time forward to `now` (no-op if it is not ahead), calling on_expire(T) for every timer whose
+  // deadline is reached, in deadline-tick order. on_expire may schedule and cancel timers. Returns the number
+  // of timers fired. Empty stretches are skipped, so the cost follows the timers due, not the time elapsed.
+  template <typename Fn>
+  std::size_t advance(Tick now, Fn&& on_expire) {
+    std::size_t fired = 0;
+    while (now_ < now && size_ != 0) {
+      const Tick next = next_event();
+      if (next > now) break;
+      now_ = next;
+      // Cascade every level whose current slot starts at this tick (a level's boundary implies the finer ones').
+      for (unsigned level = 1; level < kLevels; ++level) {
+        if ((now_ & ((Tick{1} << (kSlotBits * level)) - 1)) != 0) break;
+        cascade(level);
+      }
+      auto& head = heads_[slot_index(0, now_)];
+      while (head != kNil) {
+        const auto index = head;
+        unlink(index);
+        T value = std::move(nodes_[index].value);
+        release(index);
+        ++fired;
+        on_expire(std::move(value));
+      }
+    }
+    if (now_ < now) now_ = now;
+    return fired;
+  }
+
+private:
+  static constexpr std::uint32_t kNil = std::numeric_limits<std::uint32_t>::max();
+
+  struct Node {
+    T value{};
+    Tick deadline{0};
+    std::uint32_t next{kNil};
+    std::uint32_t prev{kNil};
+    std::uint32_t slot{0};
+    std::uint32_t generation{0};
+    bool live{false};
+  };
+
+  static std::size_t slot_index(unsigned level, Tick tick) noexcept {
+    return level * kSlots + static_cast<std::size_t>((tick >> (kSlotBits * level)) & (kSlots - 1));
+  }
+
+  // The first tick after now_ with work: a non-empty level-0 slot, or a coarser slot due to cascade. Each level
+  // is scanned for one revolution from its next boundary, which covers every slot a timer can be filed in.
+  Tick next_event() const {
+    Tick best = std::numeric_limits<Tick>::max();
+    for (unsigned level = 0; level < kLevels; ++level) {
+      const unsigned shift = kSlotBits * level;
+      Tick tick = ((now_ >> shift) + 1) << shift;
+      for (std::size_t i = 0; i < kSlots && tick < best; ++i, tick += Tick{1} << shift) {
+        if (heads_[slot_index(level, tick)] != kNil) {
+          best = tick;
+          break;
+        }
+      }
+    }
+    return best;
+  }
+
+  // Files a timer by its distance from now_, as if it were due no earlier than `earliest`.
+  void link(std::uint32_t index, Tick earliest) {
+    Node& n = nodes_[index];
+    Tick at = std::max(n.deadline, earliest);
+    const Tick delta = at - now_;
+    unsigned level = 0;
+    while (level + 1 < kLevels && delta >= (Tick{1} << (kSlotBits * (level + 1)))) ++level;
+    if (delta >= (Tick{1} << (kSlotBits * kLevels))) {
+      // Beyond the top level's reach: park it in the farthest slot; it is re-filed when that slot cascades.
+      at = now_ + (Tick{kSlots - 1} << (kSlotBits * level));
+    }
+    n.slot = static_cast<std::uint32_t>(slot_index(level, at));
+    n.prev = kNil;
+    n.next = heads_[n.slot];
+    if (n.next != kNil) nodes_[n.next].prev = index;
+    heads_[n.slot] = index;
+  }
+
+  void unlink(std::uint32_t index) {
+    Node& n = nodes_[index];
+    if (n.prev != kNil) {
+      nodes_[n.prev].next = n.next;
+    } else {
+      heads_[n.slot] = n.next;
+    }
+    if (n.next != kNil) nodes_[n.next].prev = n.prev;
+  }
+
+  void release(std::uint32_t index) {
+    Node& n = nodes_[index];
+    n.value = T{};
+    n.live = false;
+    ++n.generation;
+    n.next = free_;
+    free_ = index;
+    --size_;
+  }
+
+  // Re-files the timers of `level`'s current slot relative to now_, so they move to finer levels (or, if
+  // parked beyond the wheel's reach, to wherever their remaining distance now fits).
+  void cascade(unsigned level) {
+    auto index = heads_[slot_index(level, now_)];
+    heads_[slot_index(level, now_)] = kNil;
+    while (index != kNil) {
+      const auto next = nodes_[index].next;
+      link(index, now_);
+      index = next;
+    }
+  }
+
+  Tick now_;
+  std::size_t size_{0};
+  std::uint32_t free_{kNil};
+  std::vector<Node> nodes_;
+  std::array<std::uint32_t, kLevels * kSlots> heads_{};
+};
+
+} // namespace flight::util
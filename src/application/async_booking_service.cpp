@@ -0,0 +1,99 @@
+#include "flight/application/async_booking_service.hpp"
+
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace flight::application {
+
+namespace {
+
+// Wraps a promise in a Callback (std::function needs a copyable target, hence the shared_ptr).
+std::pair<std::future<BookSeatResult>, AsyncBookingService::Callback> promised() {
+  auto promise = std::make_shared<std::promise<BookSeatResult>>();
+  auto future = promise->get_future();
+  return {std::move(future), [promise](BookSeatResult r) { promise->set_value(std::move(r)); }};
+}
+
+} // namespace
+
+AsyncBookingService::AsyncBookingService(BookingService& booking, AsyncBookingOptions options)
+    : booking_(booking), options_(options), queue_(options.queue_capacity) {
+  if (options_.workers == 0 || options_.max_batch == 0) {
+    throw std::invalid_argument("AsyncBookingService: workers and max_batch must be > 0");
+  }
+  workers_.reserve(options_.workers);
+  for (std::size_t i = 0; i < options_.workers; ++i) workers_.emplace_back([this] { run(); });
+}
+
+AsyncBookingService::~AsyncBookingService() {
+  queue_.close();
+  for (auto& w : workers_) w.join();
+}
+
+std::future<BookSeatResult> AsyncBookingService::submit(const BookSeatCommand& cmd) {
+  auto [future, done] = promised();
+  submit(cmd, std::move(done));
+  return std::move(future);
+}
+
+void AsyncBookingService::submit(const BookSeatCommand& cmd, Callback done) {
+  Pending pending{cmd, std::move(done), std::chrono::steady_clock::now()};
+  if (!queue_.push(pending)) throw std::logic_error("AsyncBookingService: submit() during shutdown");
+}
+
+std::optional<std::future<BookSeatResult>> AsyncBookingService::try_submit(const BookSeatCommand& cmd) {
+  auto [future, done] = promised();
+  if (!try_submit(cmd, std::move(done))) return std::nullopt;
+  return std::move(future);
+}
+
+bool AsyncBookingService::try_submit(const BookSeatCommand& cmd, Callback done) {
+  Pending pending{cmd, std::move(done), std::chrono::steady_clock::now()};
+  if (queue_.try_push(pending)) return true;
+  FLIGHT_METRICS_COUNT("flight_booking_queue_rejected_total", "", "Commands refused because the queue was full.");
+  return false;
+}
+
+void AsyncBookingService::run() {
+#if FLIGHT_METRICS
+  static const auto wait_id = flight::util::Metrics::global().histogram(
+      "flight_booking_queue_wait_seconds", "", "Time booking commands spent queued before a worker took them.");
+#endif
+  std::vector<Pending> batch;
+  std::vector<BookSeatCommand> commands;
+  while (queue_.pop_batch(batch, options_.max_batch) > 0) {
+    commands.clear();
+#if FLIGHT_METRICS
+    const auto now = std::chrono::steady_clock::now();
+#endif
+    for (const auto& p : batch) {
+      commands.push_back(p.cmd);
+#if FLIGHT_METRICS
+      flight::util::Metrics::global().record(
+          wait_id,
+          static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - p.enqueued).count()));
+#endif
+    }
+
+    std::vector<BookSeatResult> results;
+    try {
+      results = booking_.book_seat_batch(commands);
+    } catch (const std::exception& e) {
+      results.assign(batch.size(), BookSeatResult{false, std::nullopt, e.what()});
+    } catch (...) {
+      results.assign(batch.size(), BookSeatResult{false, std::nullopt, "Booking failed"});
+    }
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      try {
+        batch[i].done(std::move(results[i]));
+      } catch (...) {
+        // A throwing callback must not take the worker (and every later command) down with it.
+      }
+    }
+    batch.clear();
+  }
+}
+
+} // namespace flight::application
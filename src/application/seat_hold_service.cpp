@@ -0,0 +1,127 @@
+#include "flight/application/seat_hold_service.hpp"
+
+#include "flight/domain/reservation.hpp"
+#include "flight/util/metrics.hpp"
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace flight::application {
+
+SeatHoldService::SeatHoldService(IFlightRepository& flights, IReservationRepository& reservations, IIdGenerator& ids,
+                                 const IClock& clock, SeatHoldOptions options)
+    : flights_(flights), reservations_(reservations), ids_(ids), clock_(clock), options_(options),
+      origin_(clock.now()) {
+  if (options_.resolution.count() <= 0) throw std::invalid_argument("SeatHoldService: resolution must be > 0");
+  if (flights_.durable()) {
+    throw std::invalid_argument("SeatHoldService: holds are not durable, so a durable flight repository is refused");
+  }
+}
+
+HoldSeatResult SeatHoldService::hold_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat,
+                                          std::chrono::milliseconds ttl) {
+  FLIGHT_METRICS_TIME(timer, "flight_booking_op_seconds", "op=\"hold_seat\"", "Latency of BookingService calls.");
+  if (ttl.count() <= 0) return HoldSeatResult{false, std::nullopt, "Hold TTL must be positive"};
+  expire_due();
+  if (!flights_.try_book_seat(flight_id, seat)) {
+    FLIGHT_METRICS_COUNT("flight_booking_failures_total", "op=\"hold_seat\"", "Bookings rejected by the repository.");
+    return HoldSeatResult{false, std::nullopt, "Seat not available or invalid"};
+  }
+
+  const auto expires_at = clock_.now() + ttl;
+  std::lock_guard<std::mutex> lk(mu_);
+  const flight::domain::HoldId id{next_hold_id_++};
+  const auto timer_handle = wheel_.schedule(tick_at(expires_at, /*round_up*/ true), id.value());
+  holds_.emplace(id.value(), Held{flight_id, seat, expires_at, timer_handle});
+  return HoldSeatResult{true, SeatHold{id, flight_id, seat, expires_at}, {}};
+}
+
+BookSeatResult SeatHoldService::confirm_hold(flight::domain::HoldId hold_id, flight::domain::OrderId order_id) {
+  FLIGHT_METRICS_TIME(timer, "flight_booking_op_seconds", "op=\"confirm_hold\"", "Latency of BookingService calls.");
+  const auto now = clock_.now();
+  std::optional<Held> held;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    held = take_locked(hold_id.value());
+  }
+  if (!held) return BookSeatResult{false, std::nullopt, "Hold not found (confirmed, released or expired)"};
+  if (now >= held->expires_at) {
+    // Expired, but expire_due() has not run since: finish its job.
+    flights_.release_seat(held->flight_id, held->seat);
+    FLIGHT_METRICS_COUNT("flight_seat_holds_expired_total", "", "Seat holds released because their TTL passed.");
+    return BookSeatResult{false, std::nullopt, "Hold expired"};
+  }
+
+  // The seat is already taken in the repository; only the reservation is written.
+  const auto res =
+      flight::domain::Reservation(ids_.next_reservation_id(), order_id, held->flight_id, held->seat, now);
+  reservations_.add(res);
+  return BookSeatResult{true, res, {}};
+}
+
+bool SeatHoldService::release_hold(flight::domain::HoldId hold_id) {
+  std::optional<Held> held;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    held = take_locked(hold_id.value());
+  }
+  if (!held) return false;
+  flights_.release_seat(held->flight_id, held->seat);
+  return true;
+}
+
+std::size_t SeatHoldService::expire_due() {
+  std::vector<Held> expired;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    wheel_.advance(tick_at(clock_.now(), /*round_up*/ false), [&](flight::domain::HoldId::value_type id) {
+      const auto it = holds_.find(id);
+      if (it == holds_.end()) return;
+      expired.push_back(it->second);
+      holds_.erase(it);
+    });
+  }
+  // Seats are released outside mu_, so holders and confirmers never wait on repository writes.
+  for (const auto& held : expired) {
+    flights_.release_seat(held.flight_id, held.seat);
+    FLIGHT_METRICS_COUNT("flight_seat_holds_expired_total", "", "Seat holds released because their TTL passed.");
+  }
+  return expired.size();
+}
+
+std::size_t SeatHoldService::release_all() {
+  std::unordered_map<flight::domain::HoldId::value_type, Held> outstanding;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    outstanding.swap(holds_);
+    for (const auto& [_, held] : outstanding) wheel_.cancel(held.timer);
+  }
+  for (const auto& [_, held] : outstanding) flights_.release_seat(held.flight_id, held.seat);
+  return outstanding.size();
+}
+
+std::size_t SeatHoldService::active_holds() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return holds_.size();
+}
+
+SeatHoldService::Wheel::Tick SeatHoldService::tick_at(std::chrono::system_clock::time_point t, bool round_up) const {
+  if (t <= origin_) return 0;
+  const auto elapsed = t - origin_;
+  const auto resolution = std::chrono::duration_cast<std::chrono::system_clock::duration>(options_.resolution);
+  auto ticks = elapsed / resolution;
+  if (round_up && elapsed % resolution != std::chrono::system_clock::duration::zero()) ++ticks;
+  return static_cast<Wheel::Tick>(ticks);
+}
+
+std::optional<SeatHoldService::Held> SeatHoldService::take_locked(flight::domain::HoldId::value_type id) {
+  const auto it = holds_.find(id);
+  if (it == holds_.end()) return std::nullopt;
+  Held held = it->second;
+  holds_.erase(it);
+  wheel_.cancel(held.timer);
+  return held;
+}
+
+} // namespace flight::application
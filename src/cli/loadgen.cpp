@@ -0,0 +1,233 @@
+#include "loadgen.hpp"
+
+#include "flight/application/async_booking_service.hpp"
+#include "flight/application/booking_service.hpp"
+#include "flight/application/flight_search_service.hpp"
+#include "flight/domain/airport_code.hpp"
+#include "flight/domain/flight.hpp"
+#include "flight/infrastructure/system_clock.hpp"
+#include "flight/util/latency_histogram.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace flight::cli {
+
+namespace {
+
+using steady = std::chrono::steady_clock;
+using flight::util::format_ns;
+using flight::util::LatencyHistogram;
+
+enum Op : std::size_t { kSearch, kBook, kCancel, kOpCount };
+constexpr std::array<const char*, kOpCount> kOpNames{"search", "book", "cancel"};
+
+constexpr std::uint16_t kRows = 30;
+constexpr std::uint8_t kSeatsPerRow = 6;
+
+// Route r flies between two synthetic airports derived from r (AAA-ZZZ).
+flight::domain::AirportCode route_airport(std::size_t route, int which) {
+  const std::size_t n = route * 2 + static_cast<std::size_t>(which);
+  const char code[3] = {static_cast<char>('A' + n / 676 % 26), static_cast<char>('A' + n / 26 % 26),
+                        static_cast<char>('A' + n % 26)};
+  return flight::domain::AirportCode(std::string_view(code, 3));
+}
+
+// Written by one worker, read by the reporter. Padded so workers never share a cache line.
+struct alignas(64) WorkerStats {
+  std::array<LatencyHistogram, kOpCount> latency;
+  std::array<std::atomic<std::uint64_t>, kOpCount> failed{};
+};
+
+struct Totals {
+  std::array<LatencyHistogram::Snapshot, kOpCount> latency{};
+  std::array<std::uint64_t, kOpCount> failed{};
+
+  static Totals collect(const std::vector<std::unique_ptr<WorkerStats>>& workers) {
+    Totals t;
+    for (const auto& w : workers) {
+      for (std::size_t op = 0; op < kOpCount; ++op) {
+        w->latency[op].add_to(t.latency[op]);
+        t.failed[op] += w->failed[op].load(std::memory_order_relaxed);
+      }
+    }
+    return t;
+  }
+
+  Totals operator-(const Totals& before) const {
+    Totals t = *this;
+    for (std::size_t op = 0; op < kOpCount; ++op) {
+      t.latency[op] -= before.latency[op];
+      t.failed[op] -= before.failed[op];
+    }
+    return t;
+  }
+};
+
+void print_line(std::ostream& out, const char* label, const Totals& t, double seconds) {
+  std::uint64_t ops = 0;
+  for (const auto& h : t.latency) ops += h.total();
+  char head[64];
+  std::snprintf(head, sizeof head, "%-8s %10.0f ops/s", label, seconds > 0 ? static_cast<double>(ops) / seconds : 0.0);
+  out << head;
+  for (std::size_t op = 0; op < kOpCount; ++op) {
+    const auto& h = t.latency[op];
+    out << " | " << kOpNames[op] << ' ' << h.total() << " p50 " << format_ns(h.percentile(0.50)) << " p99 "
+        << format_ns(h.percentile(0.99)) << " p999 " << format_ns(h.percentile(0.999));
+    if (t.failed[op] != 0) out << " failed " << t.failed[op];
+  }
+  out << '\n' << std::flush;
+}
+
+std::vector<flight::domain::FlightId> seed_catalog(flight::application::IFlightRepository& flights,
+                                                   flight::application::IIdGenerator& ids,
+                                                   const LoadgenOptions& options) {
+  std::vector<flight::domain::FlightId> seeded;
+  const auto now = std::chrono::system_clock::now();
+  for (std::size_t i = 0; i < options.flights; ++i) {
+    const std::size_t route = i % options.routes;
+    // Spread departures over the next week.
+    const auto departure = now + std::chrono::minutes(static_cast<std::int64_t>(i * 7 * 24 * 60 / options.flights));
+    seeded.push_back(ids.next_flight_id());
+    flights.upsert(flight::domain::Flight(seeded.back(), route_airport(route, 0), route_airport(route, 1), departure,
+                                          kRows, kSeatsPerRow));
+  }
+  return seeded;
+}
+
+} // namespace
+
+int run_loadgen(flight::application::IFlightRepository& flights,
+                flight::application::IReservationRepository& reservations, flight::application::IIdGenerator& ids,
+                const LoadgenOptions& options, std::ostream& out, flight::application::IChangeGroups* groups) {
+  if (options.flights == 0 || options.routes == 0 || options.threads == 0) {
+    throw std::invalid_argument("loadgen: flights, routes and threads must be > 0");
+  }
+  const unsigned total_weight = options.search_weight + options.book_weight + options.cancel_weight;
+  if (total_weight == 0) throw std::invalid_argument("loadgen: operation mix must not be all zero");
+
+  flight::infrastructure::SystemClock clock;
+  const flight::application::FlightSearchService search{flights};
+  flight::application::BookingService booking{flights, reservations, ids, clock, groups};
+  std::unique_ptr<flight::application::AsyncBookingService> async;
+  if (options.async_workers > 0) {
+    async = std::make_unique<flight::application::AsyncBookingService>(
+        booking, flight::application::AsyncBookingOptions{options.async_workers, options.async_queue,
+                                                          options.async_batch});
+  }
+
+  const auto seed_start = steady::now();
+  const auto flight_ids = seed_catalog(flights, ids, options);
+  const std::chrono::duration<double> seed_time = steady::now() - seed_start;
+  out << "loadgen: seeded " << options.flights << " flights on " << options.routes << " routes in "
+      << seed_time.count() << "s; " << options.threads << " threads, "
+      << (options.rate > 0 ? std::to_string(static_cast<long long>(options.rate)) + " ops/s target"
+                           : std::string("unthrottled"))
+      << ", mix search/book/cancel " << options.search_weight << '/' << options.book_weight << '/'
+      << options.cancel_weight << '\n';
+  if (async) {
+    out << "loadgen: async booking with " << options.async_workers << " workers, queue " << options.async_queue
+        << ", batches of " << options.async_batch << ", " << (options.async_reject ? "reject" : "wait")
+        << " when full\n";
+  }
+
+  std::vector<std::unique_ptr<WorkerStats>> stats;
+  for (std::size_t t = 0; t < options.threads; ++t) stats.push_back(std::make_unique<WorkerStats>());
+  std::atomic<bool> stop{false};
+  const auto start = steady::now();
+
+  auto worker = [&](std::size_t t) {
+    WorkerStats& my = *stats[t];
+    std::mt19937_64 rng(options.seed + t);
+    auto pick = [&rng](std::size_t n) { return static_cast<std::size_t>(rng() % n); };
+    const auto order_id = ids.next_order_id();
+    std::vector<flight::domain::ReservationId> mine; // this worker's live reservations, for cancellations
+
+    const auto interval = options.rate > 0
+                              ? std::chrono::duration_cast<steady::duration>(std::chrono::duration<double>(
+                                    static_cast<double>(options.threads) / options.rate))
+                              : steady::duration::zero();
+    auto next = start;
+
+    while (!stop.load(std::memory_order_relaxed)) {
+      auto op_start = steady::now();
+      if (interval > steady::duration::zero()) {
+        if (op_start < next) std::this_thread::sleep_until(next);
+        op_start = next; // open loop: a late start counts against latency
+        next += interval;
+      }
+
+      const auto roll = static_cast<unsigned>(pick(total_weight));
+      Op op = roll < options.search_weight ? kSearch : roll < options.search_weight + options.book_weight ? kBook : kCancel;
+      if (op == kCancel && mine.empty()) op = kBook;
+
+      bool ok = true;
+      if (op == kSearch) {
+        const auto route = pick(options.routes);
+        search.search({route_airport(route, 0), route_airport(route, 1)});
+      } else if (op == kBook) {
+        const auto flight_id = flight_ids[pick(flight_ids.size())];
+        const auto seat = flight::domain::Seat{static_cast<std::uint16_t>(pick(kRows) + 1),
+                                               static_cast<char>('A' + pick(kSeatsPerRow))};
+        const flight::application::BookSeatCommand cmd{flight_id, order_id, seat};
+        std::optional<flight::application::BookSeatResult> res;
+        if (!async) {
+          res = booking.book_seat(cmd);
+        } else if (!options.async_reject) {
+          res = async->submit(cmd).get();
+        } else if (auto queued = async->try_submit(cmd)) {
+          res = queued->get();
+        }
+        ok = res && res->success;
+        if (ok) mine.push_back(res->reservation->id());
+      } else {
+        const auto i = pick(mine.size());
+        ok = booking.cancel(mine[i]);
+        mine[i] = mine.back();
+        mine.pop_back();
+      }
+
+      const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(steady::now() - op_start).count();
+      my.latency[op].record(static_cast<std::uint64_t>(std::max<std::int64_t>(elapsed, 0)));
+      if (!ok) my.failed[op].store(my.failed[op].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+  };
+
+  // A zero duration only seeds the catalog (e.g. to write a snapshot of it).
+  std::vector<std::thread> workers;
+  if (options.duration > options.duration.zero()) {
+    for (std::size_t t = 0; t < options.threads; ++t) workers.emplace_back(worker, t);
+  }
+
+  // Reporter: interval deltas of the cumulative per-worker histograms.
+  Totals previous;
+  auto previous_time = start;
+  const auto deadline = start + options.duration;
+  while (steady::now() < deadline) {
+    std::this_thread::sleep_until(std::min(previous_time + options.report_interval, deadline));
+    const auto now = steady::now();
+    const auto current = Totals::collect(stats);
+    char label[16];
+    std::snprintf(label, sizeof label, "[%5.1fs]", std::chrono::duration<double>(now - start).count());
+    print_line(out, label, current - previous, std::chrono::duration<double>(now - previous_time).count());
+    previous = current;
+    previous_time = now;
+  }
+
+  stop.store(true);
+  for (auto& w : workers) w.join();
+  print_line(out, "total", Totals::collect(stats), std::chrono::duration<double>(steady::now() - start).count());
+  return 0;
+}
+
+} // namespace flight::cli
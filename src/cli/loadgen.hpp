@@ -0,0 +1,47 @@
+#pragma once
+
+#include "flight/application/change_groups.hpp"
+#include "flight/application/flight_repository.hpp"
+#include "flight/application/id_generator.hpp"
+#include "flight/application/reservation_repository.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace flight::cli {
+
+// Synthetic peak-hour workload for `flight_cli --loadgen`.
+struct LoadgenOptions {
+  std::size_t flights{1000};
+  std::size_t routes{100};
+  std::size_t threads{4};
+  // Target rate over all threads (ops/s). Each worker then follows a fixed arrival schedule and latency is
+  // measured from the scheduled start, so stalls show up as queueing delay. 0 runs unthrottled.
+  double rate{0};
+  std::chrono::milliseconds duration{std::chrono::seconds(10)};
+  std::chrono::milliseconds report_interval{std::chrono::seconds(1)};
+  // Relative weights of the operation mix.
+  unsigned search_weight{80};
+  unsigned book_weight{15};
+  unsigned cancel_weight{5};
+  std::uint64_t seed{1};
+  // With async_workers > 0, bookings go through an AsyncBookingService with that many workers, a queue of
+  // async_queue commands and batches of up to async_batch; async_reject refuses bookings when the queue is
+  // full (counted as failed) instead of waiting for room.
+  std::size_t async_workers{0};
+  std::size_t async_queue{4096};
+  std::size_t async_batch{64};
+  bool async_reject{false};
+};
+
+// Seeds `flights` with the synthetic catalog, runs the workload (reservations go to `reservations`, ids come
+// from `ids`) and prints a summary line every report interval plus a final total. Returns the process exit code.
+// `groups` (the journal, if any) makes each booking and its reservation durable as one unit.
+int run_loadgen(flight::application::IFlightRepository& flights,
+                flight::application::IReservationRepository& reservations, flight::application::IIdGenerator& ids,
+                const LoadgenOptions& options, std::ostream& out,
+                flight::application::IChangeGroups* groups = nullptr);
+
+} // namespace flight::cli
@@ -1,18 +1,32 @@
 #include "flight/application/booking_service.hpp"
 #include "flight/application/flight_search_service.hpp"
+#include "flight/application/seat_hold_service.hpp"
 #include "flight/domain/airport_code.hpp"
 #include "flight/domain/flight.hpp"
 #include "flight/infrastructure/atomic_id_generator.hpp"
+#include "flight/infrastructure/catalog_snapshot.hpp"
 #include "flight/infrastructure/in_memory_flight_repository.hpp"
 #include "flight/infrastructure/in_memory_reservation_repository.hpp"
+#include "flight/infrastructure/instrumented_reservation_repository.hpp"
+#include "flight/infrastructure/journaled_repositories.hpp"
+#include "flight/infrastructure/schedule_import.hpp"
+#include "flight/infrastructure/snowflake_id_generator.hpp"
 #include "flight/infrastructure/system_clock.hpp"
 #include "flight/infrastructure/flight_repository_factory.hpp"
+#include "flight/util/metrics.hpp"
 
+#include "loadgen.hpp"
+
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <chrono>
+#include <ctime>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 namespace {
@@ -30,43 +44,244 @@ std::string format_time(std::chrono::system_clock::time_point tp) {
   return oss.str();
 }
 
+// Parses YYYY-MM-DD as local midnight; nullopt for "*" or malformed input.
+std::optional<std::chrono::system_clock::time_point> parse_day(const std::string& text) {
+  if (text == "*") return std::nullopt;
+  std::tm tm{};
+  std::istringstream iss(text);
+  iss >> std::get_time(&tm, "%Y-%m-%d");
+  if (iss.fail()) return std::nullopt;
+  tm.tm_isdst = -1;
+  return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+}
+
 } // namespace
 
-static std::string parse_flight_repo_arg(int argc, char** argv) {
-  std::string repo = "inmem";
+// Returns the value of a `--name=value` argument, or `fallback` if absent.
+static std::string arg_value(int argc, char** argv, const std::string& name, std::string fallback) {
+  const std::string prefix = "--" + name + "=";
   for (int i = 1; i < argc; ++i) {
     const std::string arg = argv[i];
-    const std::string prefix = "--flight-repo=";
-    if (arg.rfind(prefix, 0) == 0) repo = arg.substr(prefix.size());
+    if (arg.rfind(prefix, 0) == 0) fallback = arg.substr(prefix.size());
   }
-  return repo;
+  return fallback;
+}
+
+static flight::infrastructure::FlightRepoConfig parse_flight_repo_config(int argc, char** argv) {
+  flight::infrastructure::FlightRepoConfig config;
+  auto& sqlite = config.sqlite_file;
+  sqlite.path = arg_value(argc, argv, "sqlite-path", sqlite.path);
+  sqlite.reader_connections = std::stoul(arg_value(argc, argv, "sqlite-readers",
+                                                   std::to_string(sqlite.reader_connections)));
+  sqlite.synchronous = arg_value(argc, argv, "sqlite-synchronous", sqlite.synchronous);
+  sqlite.busy_timeout_ms = std::stoi(arg_value(argc, argv, "sqlite-busy-timeout-ms",
+                                               std::to_string(sqlite.busy_timeout_ms)));
+  sqlite.mmap_size = std::stoll(arg_value(argc, argv, "sqlite-mmap-size", std::to_string(sqlite.mmap_size)));
+  config.instrumented = true;
+  return config;
+}
+
+// Writes all metrics in Prometheus text format to `path` (no-op for an empty path).
+static void write_metrics_file(const std::string& path) {
+  if (path.empty()) return;
+  std::ofstream out(path, std::ios::trunc);
+  flight::util::Metrics::global().write_prometheus(out);
+  if (!out) std::cerr << "Could not write metrics to " << path << "\n";
+}
+
+// Writes the flight catalog to `path` as a CatalogSnapshot (no-op for an empty path). With a journal the
+// snapshot becomes the journal's base (see BookingJournal::write_snapshot), so the next start with
+// --snapshot and --journal replays only what changed since. A snapshot holds seats but no reservations, so
+// without a journal (which keeps them) it is refused once any seat is booked: the seats would come back with
+// nobody able to cancel them. Returns false if the snapshot was refused.
+static bool write_snapshot_file(const std::string& path, const flight::application::IFlightRepository& flights,
+                                flight::infrastructure::BookingJournal* journal) {
+  if (path.empty()) return true;
+  if (journal == nullptr) {
+    bool booked = false;
+    flights.visit_all([&](const flight::domain::Flight& f) { booked = booked || f.booked_count() > 0; });
+    if (booked) {
+      std::cerr << "Snapshot " << path << ": not written; seats are booked and their reservations would be lost "
+                << "(use --journal)\n";
+      return false;
+    }
+  }
+  const auto n =
+      journal != nullptr ? journal->write_snapshot(path) : flight::infrastructure::CatalogSnapshot::write(path, flights);
+  std::cout << "Snapshot " << path << ": wrote " << n << " flights\n";
+  return true;
+}
+
+static bool has_flag(int argc, char** argv, const std::string& name) {
+  for (int i = 1; i < argc; ++i) {
+    if (argv[i] == "--" + name) return true;
+  }
+  return false;
+}
+
+// --loadgen [--flights=N] [--routes=M] [--threads=K] [--rate=OPS_PER_S] [--duration-s=S] [--report-ms=MS]
+//           [--mix=SEARCH,BOOK,CANCEL] [--seed=N] [--async-workers=N [--async-queue=N] [--async-batch=N]
+//           [--async-reject]]
+static flight::cli::LoadgenOptions parse_loadgen_options(int argc, char** argv) {
+  flight::cli::LoadgenOptions o;
+  o.flights = std::stoul(arg_value(argc, argv, "flights", std::to_string(o.flights)));
+  o.routes = std::stoul(arg_value(argc, argv, "routes", std::to_string(o.routes)));
+  o.threads = std::stoul(arg_value(argc, argv, "threads", std::to_string(o.threads)));
+  o.rate = std::stod(arg_value(argc, argv, "rate", "0"));
+  o.duration = std::chrono::seconds(std::stol(arg_value(argc, argv, "duration-s", "10")));
+  o.report_interval = std::chrono::milliseconds(std::stol(arg_value(argc, argv, "report-ms", "1000")));
+  o.seed = std::stoull(arg_value(argc, argv, "seed", std::to_string(o.seed)));
+  o.async_workers = std::stoul(arg_value(argc, argv, "async-workers", std::to_string(o.async_workers)));
+  o.async_queue = std::stoul(arg_value(argc, argv, "async-queue", std::to_string(o.async_queue)));
+  o.async_batch = std::stoul(arg_value(argc, argv, "async-batch", std::to_string(o.async_batch)));
+  o.async_reject = has_flag(argc, argv, "async-reject");
+
+  const auto mix = arg_value(argc, argv, "mix", "");
+  if (!mix.empty()) {
+    char comma1 = 0, comma2 = 0;
+    std::istringstream iss(mix);
+    if (!(iss >> o.search_weight >> comma1 >> o.book_weight >> comma2 >> o.cancel_weight) || comma1 != ',' ||
+        comma2 != ',') {
+      throw std::invalid_argument("--mix expects SEARCH,BOOK,CANCEL weights, e.g. 80,15,5");
+    }
+  }
+  return o;
+}
+
+// --ids=seq [--id-block=N] hands out sequential ids, continuing after the restored ones; each thread leases N at a
+// time. --ids=snowflake --node-id=N makes time-ordered ids that stay unique across processes with distinct node ids.
+static std::unique_ptr<flight::application::IIdGenerator>
+make_id_generator(int argc, char** argv, const flight::application::IClock& clock, std::uint64_t first_flight_id,
+                  std::uint64_t first_reservation_id, std::uint64_t first_order_id) {
+  const auto kind = arg_value(argc, argv, "ids", "seq");
+  if (kind == "snowflake") {
+    return std::make_unique<flight::infrastructure::SnowflakeIdGenerator>(
+        static_cast<std::uint32_t>(std::stoul(arg_value(argc, argv, "node-id", "0"))), clock);
+  }
+  if (kind != "seq") throw std::invalid_argument("--ids expects seq or snowflake");
+  return std::make_unique<flight::infrastructure::AtomicIdGenerator>(
+      first_flight_id, first_reservation_id, first_order_id, std::stoull(arg_value(argc, argv, "id-block", "256")));
 }
 
 int main(int argc, char** argv) {
   using namespace flight;
+  using namespace flight::domain::literals;
 
-  infrastructure::AtomicIdGenerator ids;
   infrastructure::SystemClock clock;
-  infrastructure::InMemoryReservationRepository reservations;
+  std::unique_ptr<application::IReservationRepository> reservations_ptr =
+      std::make_unique<infrastructure::InMemoryReservationRepository>();
+  if (util::Metrics::enabled()) {
+    reservations_ptr =
+        std::make_unique<infrastructure::InstrumentedReservationRepository>(std::move(reservations_ptr), "inmem");
+  }
+  const auto metrics_out = arg_value(argc, argv, "metrics-out", "");
 
-  const auto repo_type = infrastructure::parse_flight_repo_type(parse_flight_repo_arg(argc, argv));
-  auto flights_ptr = infrastructure::make_flight_repository(repo_type);
+  const auto repo_type = infrastructure::parse_flight_repo_type(arg_value(argc, argv, "flight-repo", "inmem"));
+  auto flights_ptr = infrastructure::make_flight_repository(repo_type, parse_flight_repo_config(argc, argv));
+  // The database file keeps the flights and their booked seats, but reservations stay in memory: after a restart
+  // the seats are still occupied and nothing references them.
+  if (repo_type == infrastructure::FlightRepoType::SqliteFile) {
+    std::cerr << "Warning: --flight-repo=sqlite-file persists flights and booked seats only; reservations are "
+                 "kept in memory and lost on exit\n";
+  }
+
+  // --snapshot=FILE loads the catalog from a snapshot written by --snapshot-out (instead of seeding demo flights).
+  // Only the in-memory backends take it: SQLite upserts keep no seat map, and their REPLACE cascades to the booked
+  // seats a database file already holds.
+  // With --journal the snapshot stays mapped as the journal's base.
+  std::uint64_t max_snapshot_flight_id = 0;
+  std::size_t snapshot_flights = 0;
+  std::shared_ptr<const infrastructure::CatalogSnapshot> snapshot;
+  if (const auto snapshot_path = arg_value(argc, argv, "snapshot", ""); !snapshot_path.empty()) {
+    if (repo_type != infrastructure::FlightRepoType::InMemory && repo_type != infrastructure::FlightRepoType::LockFree) {
+      throw std::invalid_argument("--snapshot requires --flight-repo=inmem or --flight-repo=lockfree");
+    }
+    const auto start = std::chrono::steady_clock::now();
+    snapshot = std::make_shared<const infrastructure::CatalogSnapshot>(snapshot_path);
+    max_snapshot_flight_id = snapshot->load_into(*flights_ptr);
+    snapshot_flights = snapshot->size();
+    std::cout << "Snapshot " << snapshot_path << ": loaded " << snapshot_flights << " flights in "
+              << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << "s\n";
+  }
+
+  // --journal=PATH makes the in-memory backends durable: the journal is replayed here and appended to on every
+  // change. --journal-checkpoint-mb sets the size that triggers a checkpoint (0 disables them).
+  infrastructure::JournalRecovery recovery;
+  std::shared_ptr<infrastructure::BookingJournal> journal;
+  if (const auto journal_path = arg_value(argc, argv, "journal", ""); !journal_path.empty()) {
+    if (repo_type != infrastructure::FlightRepoType::InMemory && repo_type != infrastructure::FlightRepoType::LockFree) {
+      throw std::invalid_argument("--journal requires --flight-repo=inmem or --flight-repo=lockfree");
+    }
+    infrastructure::JournalOptions options;
+    options.path = journal_path;
+    options.checkpoint_bytes = std::stoull(arg_value(argc, argv, "journal-checkpoint-mb",
+                                                     std::to_string(options.checkpoint_bytes >> 20))) << 20;
+    options.snapshot = snapshot;
+    auto journaled =
+        infrastructure::make_journaled_repositories(std::move(flights_ptr), std::move(reservations_ptr), options);
+    recovery = journaled.journal->recovery();
+    journal = journaled.journal;
+    flights_ptr = std::move(journaled.flights);
+    reservations_ptr = std::move(journaled.reservations);
+    std::cout << "Journal " << journal_path << ": replayed " << recovery.records << " records (" << recovery.flights
+              << " flights, " << recovery.reservations << " reservations)\n";
+  }
   auto& flights = *flights_ptr;
+  auto& reservations = *reservations_ptr;
+  const auto ids_ptr = make_id_generator(argc, argv, clock, std::max(recovery.max_flight_id, max_snapshot_flight_id) + 1,
+                                         recovery.max_reservation_id + 1, recovery.max_order_id + 1);
+  auto& ids = *ids_ptr;
+  const auto snapshot_out = arg_value(argc, argv, "snapshot-out", "");
 
-  // Seed a few flights.
+  // --import=FILE [--import-threads=N] [--import-batch=N] bulk-loads a CSV schedule (see schedule_import.hpp),
+  // reports throughput and malformed rows, and exits; non-zero if any row was rejected.
+  if (const auto import_path = arg_value(argc, argv, "import", ""); !import_path.empty()) {
+    std::ifstream in(import_path, std::ios::binary);
+    if (!in) throw std::runtime_error("Cannot open " + import_path);
+    infrastructure::ScheduleImportOptions options;
+    options.threads = std::stoul(arg_value(argc, argv, "import-threads", std::to_string(options.threads)));
+    options.batch_size = std::stoul(arg_value(argc, argv, "import-batch", std::to_string(options.batch_size)));
+    const auto result = infrastructure::import_schedule(in, flights, options);
+    std::cout << "Import " << import_path << ": " << result.rows << " rows (" << result.imported << " imported, "
+              << result.malformed << " malformed) in " << result.seconds << "s, "
+              << static_cast<std::uint64_t>(result.rows_per_second()) << " rows/s, " << result.batches
+              << " batches\n";
+    for (const auto& e : result.errors) std::cout << "  line " << e.line << ": " << e.message << "\n";
+    if (result.malformed > result.errors.size()) {
+      std::cout << "  ... and " << result.malformed - result.errors.size() << " more malformed rows\n";
+    }
+    write_metrics_file(metrics_out);
+    const bool snapshot_written = write_snapshot_file(snapshot_out, flights, journal.get());
+    return result.malformed == 0 && snapshot_written ? 0 : 1;
+  }
+
+  if (has_flag(argc, argv, "loadgen")) {
+    const int rc =
+        cli::run_loadgen(flights, reservations, ids, parse_loadgen_options(argc, argv), std::cout, journal.get());
+    write_metrics_file(metrics_out);
+    const bool snapshot_written = write_snapshot_file(snapshot_out, flights, journal.get());
+    return rc != 0 ? rc : (snapshot_written ? 0 : 1);
+  }
+
+  // Seed a few flights (unless a snapshot or the journal restored a catalog).
   const auto now = std::chrono::system_clock::now();
-  const auto f1 = domain::Flight(ids.next_flight_id(), domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+  const auto f1 = domain::Flight(ids.next_flight_id(), "WAW"_iata, "FRA"_iata,
                                 now + std::chrono::hours(6), /*rows*/ 30, /*seats_per_row*/ 6);
-  const auto f2 = domain::Flight(ids.next_flight_id(), domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+  const auto f2 = domain::Flight(ids.next_flight_id(), "WAW"_iata, "FRA"_iata,
                                 now + std::chrono::hours(26), 25, 6);
-  const auto f3 = domain::Flight(ids.next_flight_id(), domain::AirportCode("WAW"), domain::AirportCode("CDG"),
+  const auto f3 = domain::Flight(ids.next_flight_id(), "WAW"_iata, "CDG"_iata,
                                 now + std::chrono::hours(8), 20, 6);
-  flights.upsert(f1);
-  flights.upsert(f2);
-  flights.upsert(f3);
+  if (snapshot_flights == 0 && recovery.flights == 0) {
+    flights.upsert(f1);
+    flights.upsert(f2);
+    flights.upsert(f3);
+  }
 
   application::FlightSearchService search{flights};
-  application::BookingService booking{flights, reservations, ids, clock};
+  application::BookingService booking{flights, reservations, ids, clock, journal.get()};
+  // Holds live only in memory, so they are off when the flights are durable (see SeatHoldService).
+  std::optional<application::SeatHoldService> holds;
+  if (!flights.durable()) holds.emplace(flights, reservations, ids, clock);
 
   // In a real UI/API, OrderId would come from the purchasing flow.
   const auto order_id = ids.next_order_id();
@@ -75,9 +290,16 @@ int main(int argc, char** argv) {
   std::cout << "OrderId: " << order_id << "\n\n";
 
   while (true) {
-    std::cout << "Choose: [1] Search flights  [2] Book seat  [3] List my reservations  [0] Exit\n> ";
-    int choice = 0;
-    if (!(std::cin >> choice)) return 0;
+    std::cout << "Choose: [1] Search flights  [2] Book seat  [3] List my reservations  [4] Book group  [5] Book any seat  [6] Book seats together  [7] Stats  [8] Hold seat  [9] Confirm hold  [0] Exit\n> ";
+    std::string command;
+    if (!(std::cin >> command)) break;
+    if (holds) holds->expire_due();
+    int choice = -1;
+    if (command == "stats") {
+      choice = 7;
+    } else {
+      std::istringstream(command) >> choice;
+    }
 
     if (choice == 0) break;
 
@@ -87,8 +309,15 @@ int main(int argc, char** argv) {
       std::cin >> from;
       std::cout << "Destination (e.g. FRA): ";
       std::cin >> to;
+      std::string day;
+      std::cout << "Departure date (YYYY-MM-DD, or * for any): ";
+      std::cin >> day;
 
       application::FlightSearchCriteria c{domain::AirportCode(from), domain::AirportCode(to)};
+      if (const auto start = parse_day(day)) {
+        c.departure_from = *start;
+        c.departure_to = *start + std::chrono::hours(24);
+      }
       std::cout << "Searching for flights from " << c.origin.value() << " to " << c.destination.value() << "...\n";
       const auto results = search.search(c);
       std::cout << "Search completed.\n";
@@ -100,8 +329,9 @@ int main(int argc, char** argv) {
 
       std::cout << "Found flights:\n";
       for (const auto& f : results) {
-        std::cout << "  FlightId " << f.id() << "  " << f.origin().value() << "->" << f.destination().value()
-                  << "  dep: " << format_time(f.departure()) << "  cap: " << f.capacity() << "\n";
+        std::cout << "  FlightId " << f.id << "  " << f.origin.value() << "->" << f.destination.value()
+                  << "  dep: " << format_time(f.departure) << "  cap: " << f.capacity << "  free: " << f.available
+                  << "\n";
       }
       std::cout << "\n";
 
@@ -140,11 +370,119 @@ int main(int argc, char** argv) {
       }
       std::cout << "\n";
 
+    } else if (choice == 4) {
+      std::uint64_t flight_id_v = 0;
+      std::size_t count = 0;
+
+      std::cout << "FlightId: ";
+      std::cin >> flight_id_v;
+      std::cout << "Number of seats: ";
+      std::cin >> count;
+
+      application::BookSeatsCommand cmd{domain::FlightId{flight_id_v}, order_id, {}};
+      for (std::size_t i = 0; i < count; ++i) {
+        std::uint16_t row = 0;
+        char letter = 'A';
+        std::cout << "Seat " << (i + 1) << " row: ";
+        std::cin >> row;
+        std::cout << "Seat " << (i + 1) << " letter: ";
+        std::cin >> letter;
+        cmd.seats.emplace_back(row, letter);
+      }
+      const auto res = booking.book_seats(cmd);
+
+      if (!res.success) {
+        std::cout << "Booking failed: " << res.error << "\n\n";
+      } else {
+        std::cout << "Booked " << res.reservations.size() << " seats:";
+        for (const auto& r : res.reservations) std::cout << " " << r.seat().to_string();
+        std::cout << "\n\n";
+      }
+
+    } else if (choice == 5) {
+      std::uint64_t flight_id_v = 0;
+      std::cout << "FlightId: ";
+      std::cin >> flight_id_v;
+
+      const auto res = booking.book_any_seat({domain::FlightId{flight_id_v}, order_id});
+      if (!res.success) {
+        std::cout << "Booking failed: " << res.error << "\n\n";
+      } else {
+        std::cout << "Booked! ReservationId " << res.reservation->id() << " Seat " << res.reservation->seat().to_string()
+                  << "\n\n";
+      }
+
+    } else if (choice == 6) {
+      std::uint64_t flight_id_v = 0;
+      std::size_t count = 0;
+
+      std::cout << "FlightId: ";
+      std::cin >> flight_id_v;
+      std::cout << "Number of seats: ";
+      std::cin >> count;
+
+      const auto res = booking.book_adjacent_seats({domain::FlightId{flight_id_v}, order_id, count});
+      if (!res.success) {
+        std::cout << "Booking failed: " << res.error << "\n\n";
+      } else {
+        std::cout << "Booked " << res.reservations.size() << " seats:";
+        for (const auto& r : res.reservations) std::cout << " " << r.seat().to_string();
+        std::cout << "\n\n";
+      }
+
+    } else if (choice == 7) {
+      util::Metrics::global().write_table(std::cout);
+      write_metrics_file(metrics_out);
+      std::cout << "\n";
+
+    } else if ((choice == 8 || choice == 9) && !holds) {
+      std::cout << "Seat holds are not durable and are disabled with --journal and --flight-repo=sqlite-file.\n\n";
+
+    } else if (choice == 8) {
+      std::uint64_t flight_id_v = 0;
+      std::uint16_t row = 0;
+      char letter = 'A';
+      long ttl_s = 0;
+
+      std::cout << "FlightId: ";
+      std::cin >> flight_id_v;
+      std::cout << "Seat row: ";
+      std::cin >> row;
+      std::cout << "Seat letter (A-F, etc.): ";
+      std::cin >> letter;
+      std::cout << "Hold for (seconds): ";
+      std::cin >> ttl_s;
+
+      const auto res = holds->hold_seat(domain::FlightId{flight_id_v}, domain::Seat{row, letter},
+                                        std::chrono::seconds(ttl_s));
+      if (!res.success) {
+        std::cout << "Hold failed: " << res.error << "\n\n";
+      } else {
+        std::cout << "Held! HoldId " << res.hold->id << " Seat " << res.hold->seat.to_string() << " until "
+                  << format_time(res.hold->expires_at) << "\n\n";
+      }
+
+    } else if (choice == 9) {
+      std::uint64_t hold_id_v = 0;
+      std::cout << "HoldId: ";
+      std::cin >> hold_id_v;
+
+      const auto res = holds->confirm_hold(domain::HoldId{hold_id_v}, order_id);
+      if (!res.success) {
+        std::cout << "Confirm failed: " << res.error << "\n\n";
+      } else {
+        std::cout << "Booked! ReservationId " << res.reservation->id() << " Seat " << res.reservation->seat().to_string()
+                  << "\n\n";
+      }
+
     } else {
       std::cout << "Unknown option.\n\n";
     }
   }
 
+  if (holds) holds->release_all(); // held seats are not part of the catalog
+  write_metrics_file(metrics_out);
+  const bool snapshot_written = write_snapshot_file(snapshot_out, flights, journal.get());
   std::cout << "Bye.\n";
-  return 0;
+  return snapshot_written ? 0 : 1;
 }
@@ -0,0 +1,43 @@
+#include "flight/infrastructure/atomic_id_generator.hpp"
+
+#include <stdexcept>
+
+namespace flight::infrastructure {
+
+namespace {
+
+std::atomic<std::uint64_t> g_instances{0};
+
+// A thread's current block [next, end) of one sequence of the generator `owner`. One slot per sequence: a
+// thread alternating between generators re-leases on every switch, which only costs ids, never uniqueness.
+struct Lease {
+  std::uint64_t owner{0};
+  std::uint64_t next{0};
+  std::uint64_t end{0};
+};
+
+thread_local std::array<Lease, 3> t_leases{};
+
+} // namespace
+
+AtomicIdGenerator::AtomicIdGenerator(std::uint64_t first_flight_id, std::uint64_t first_reservation_id,
+                                     std::uint64_t first_order_id, std::uint64_t block_size)
+    : block_size_(block_size), instance_(g_instances.fetch_add(1, std::memory_order_relaxed) + 1) {
+  if (block_size_ == 0) throw std::invalid_argument("AtomicIdGenerator: block_size must be > 0");
+  counters_[kFlight].next.store(first_flight_id, std::memory_order_relaxed);
+  counters_[kReservation].next.store(first_reservation_id, std::memory_order_relaxed);
+  counters_[kOrder].next.store(first_order_id, std::memory_order_relaxed);
+}
+
+std::uint64_t AtomicIdGenerator::next(Sequence s) {
+  if (block_size_ == 1) return counters_[s].next.fetch_add(1, std::memory_order_relaxed);
+  auto& lease = t_leases[s];
+  if (lease.owner != instance_ || lease.next == lease.end) {
+    lease.next = counters_[s].next.fetch_add(block_size_, std::memory_order_relaxed);
+    lease.end = lease.next + block_size_;
+    lease.owner = instance_;
+  }
+  return lease.next++;
+}
+
+} // namespace flight::infrastructure
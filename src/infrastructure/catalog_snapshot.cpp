@@ -0,0 +1,198 @@
+#include "flight/infrastructure/catalog_snapshot.hpp"
+#include "flight/infrastructure/durable_file.hpp"
+#include "flight/util/crc32.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace flight::infrastructure {
+
+static_assert(std::endian::native == std::endian::little, "catalog snapshots are little-endian and used in place");
+static_assert(std::is_trivially_copyable_v<SnapshotHeader> && std::is_trivially_copyable_v<SnapshotFlight>);
+
+namespace {
+
+constexpr std::array<char, 8> kMagic{'F', 'L', 'T', 'S', 'N', 'A', 'P', '\0'};
+
+std::uint32_t header_crc(SnapshotHeader header) {
+  header.header_crc = 0;
+  return flight::util::crc32(std::as_bytes(std::span<const SnapshotHeader>(&header, 1)));
+}
+
+std::int64_t to_ns(flight::domain::Flight::time_point tp) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+}
+
+flight::domain::Flight::time_point from_ns(std::int64_t ns) {
+  return flight::domain::Flight::time_point(
+      std::chrono::duration_cast<flight::domain::Flight::time_point::duration>(std::chrono::nanoseconds(ns)));
+}
+
+[[noreturn]] void corrupt(const std::string& path, const char* what) {
+  throw std::runtime_error("CatalogSnapshot: " + path + ": " + what);
+}
+
+} // namespace
+
+std::size_t CatalogSnapshot::write(const std::string& path, const flight::application::IFlightRepository& flights) {
+  std::vector<SnapshotFlight> records;
+  std::vector<std::uint64_t> words;
+  flights.visit_all([&](const flight::domain::Flight& f) {
+    const auto seat_words = f.seat_map().words();
+    records.push_back(SnapshotFlight{f.id().value(), to_ns(f.departure()), words.size(), f.origin().packed(),
+                                     f.destination().packed(), f.rows(), f.seats_per_row(), 0});
+    words.insert(words.end(), seat_words.begin(), seat_words.end());
+  });
+  // Id order makes snapshots of the same catalog byte-identical, whatever the repository's iteration order.
+  std::sort(records.begin(), records.end(), [](const auto& a, const auto& b) { return a.id < b.id; });
+  std::vector<std::uint64_t> sorted_words;
+  sorted_words.reserve(words.size());
+  for (auto& r : records) {
+    const auto count = flight::domain::SeatMap::words_for(static_cast<std::uint32_t>(r.rows) * r.seats_per_row);
+    const auto first = words.begin() + static_cast<std::ptrdiff_t>(r.first_word);
+    r.first_word = sorted_words.size();
+    sorted_words.insert(sorted_words.end(), first, first + static_cast<std::ptrdiff_t>(count));
+  }
+
+  SnapshotHeader header;
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.header_bytes = sizeof(SnapshotHeader);
+  header.flight_count = records.size();
+  header.word_count = sorted_words.size();
+  header.file_bytes = sizeof(SnapshotHeader) + records.size() * sizeof(SnapshotFlight) +
+                      sorted_words.size() * sizeof(std::uint64_t);
+  const auto record_bytes = std::as_bytes(std::span<const SnapshotFlight>(records));
+  const auto word_bytes = std::as_bytes(std::span<const std::uint64_t>(sorted_words));
+  header.body_crc = flight::util::crc32(word_bytes, flight::util::crc32(record_bytes));
+  header.header_crc = header_crc(header);
+
+  // Synced and renamed like a journal checkpoint, so a crash leaves the old snapshot or the complete new one.
+  replace_file(path, {std::as_bytes(std::span<const SnapshotHeader>(&header, 1)), record_bytes, word_bytes});
+  return records.size();
+}
+
+CatalogSnapshot::CatalogSnapshot(const std::string& path, bool verify_checksum) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) corrupt(path, "cannot open");
+  struct stat st {};
+  if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(SnapshotHeader)) {
+    ::close(fd);
+    corrupt(path, "too short for a snapshot header");
+  }
+  length_ = static_cast<std::size_t>(st.st_size);
+  void* base = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // the mapping keeps the file referenced
+  if (base == MAP_FAILED) corrupt(path, "mmap failed");
+  base_ = base;
+
+  try {
+    const auto* bytes = static_cast<const std::byte*>(base_);
+    SnapshotHeader header;
+    std::memcpy(&header, bytes, sizeof header);
+    if (header.magic != kMagic) corrupt(path, "not a catalog snapshot");
+    if (header.version != kVersion) corrupt(path, "unsupported snapshot version");
+    if (header.header_crc != header_crc(header)) corrupt(path, "header checksum mismatch");
+    if (header.header_bytes != sizeof(SnapshotHeader) || header.file_bytes != length_ ||
+        header.flight_count > (length_ - sizeof(SnapshotHeader)) / sizeof(SnapshotFlight) ||
+        header.word_count > (length_ - sizeof(SnapshotHeader)) / sizeof(std::uint64_t) ||
+        header.file_bytes != sizeof(SnapshotHeader) + header.flight_count * sizeof(SnapshotFlight) +
+                                 header.word_count * sizeof(std::uint64_t)) {
+      corrupt(path, "size does not match header");
+    }
+
+    const auto* records = bytes + sizeof(SnapshotHeader);
+    const auto* words = records + header.flight_count * sizeof(SnapshotFlight);
+    // mmap returns page-aligned memory and every section is a multiple of 8 bytes, so these are aligned.
+    flights_ = {reinterpret_cast<const SnapshotFlight*>(records), static_cast<std::size_t>(header.flight_count)};
+    words_ = {reinterpret_cast<const std::uint64_t*>(words), static_cast<std::size_t>(header.word_count)};
+    checksum_ = header.body_crc;
+
+    if (verify_checksum &&
+        flight::util::crc32(std::span<const std::byte>(records, length_ - sizeof(SnapshotHeader))) != header.body_crc) {
+      corrupt(path, "body checksum mismatch");
+    }
+  } catch (...) {
+    ::munmap(base_, length_);
+    throw;
+  }
+}
+
+CatalogSnapshot::~CatalogSnapshot() { ::munmap(base_, length_); }
+
+const SnapshotFlight* CatalogSnapshot::find(std::uint64_t id) const noexcept {
+  const auto it = std::lower_bound(flights_.begin(), flights_.end(), id,
+                                   [](const SnapshotFlight& f, std::uint64_t v) { return f.id < v; });
+  return it != flights_.end() && it->id == id ? &*it : nullptr;
+}
+
+bool CatalogSnapshot::holds(const flight::domain::Flight& flight) const {
+  const auto* f = find(flight.id().value());
+  if (f == nullptr || f->departure_ns != to_ns(flight.departure()) || f->origin != flight.origin().packed() ||
+      f->destination != flight.destination().packed() || f->rows != flight.rows() ||
+      f->seats_per_row != flight.seats_per_row()) {
+    return false;
+  }
+  const auto words = seat_words(*f);
+  const auto current = flight.seat_map().words();
+  return std::equal(words.begin(), words.end(), current.begin(), current.end());
+}
+
+std::span<const std::uint64_t> CatalogSnapshot::seat_words(const SnapshotFlight& f) const {
+  const auto count = flight::domain::SeatMap::words_for(static_cast<std::uint32_t>(f.rows) * f.seats_per_row);
+  if (f.first_word > words_.size() || count > words_.size() - f.first_word) {
+    throw std::runtime_error("CatalogSnapshot: seat words out of range for flight " + std::to_string(f.id));
+  }
+  return words_.subspan(static_cast<std::size_t>(f.first_word), count);
+}
+
+flight::application::FlightSummary CatalogSnapshot::summary(const SnapshotFlight& f) const {
+  const auto capacity = static_cast<std::uint32_t>(f.rows) * f.seats_per_row;
+  std::uint32_t booked = 0;
+  for (const auto w : seat_words(f)) booked += static_cast<std::uint32_t>(std::popcount(w));
+  return flight::application::FlightSummary{flight::domain::FlightId{f.id},
+                                            flight::domain::AirportCode::from_packed(f.origin),
+                                            flight::domain::AirportCode::from_packed(f.destination),
+                                            from_ns(f.departure_ns),
+                                            capacity,
+                                            capacity - std::min(booked, capacity)};
+}
+
+flight::domain::Flight CatalogSnapshot::flight(const SnapshotFlight& f) const {
+  const auto words = seat_words(f);
+  flight::domain::SeatMap seats(f.rows, f.seats_per_row);
+  for (std::size_t i = 0; i < words.size(); ++i) seats.assign_word(i, words[i]);
+  return flight::domain::Flight(flight::domain::FlightId{f.id}, flight::domain::AirportCode::from_packed(f.origin),
+                                flight::domain::AirportCode::from_packed(f.destination), from_ns(f.departure_ns),
+                                f.rows, f.seats_per_row, std::move(seats));
+}
+
+std::uint64_t CatalogSnapshot::load_into(flight::application::IFlightRepository& repository) const {
+  // Bounded batches: one lock hold (or transaction) per batch without materialising the whole catalog.
+  constexpr std::size_t kBatch = 1u << 16;
+  std::uint64_t max_id = 0;
+  std::vector<flight::domain::Flight> batch;
+  batch.reserve(std::min(kBatch, flights_.size()));
+  for (const auto& f : flights_) {
+    batch.push_back(flight(f));
+    max_id = std::max(max_id, f.id);
+    if (batch.size() == kBatch) {
+      repository.upsert_many(std::move(batch));
+      batch.clear();
+    }
+  }
+  repository.upsert_many(std::move(batch));
+  return max_id;
+}
+
+} // namespace flight::infrastructure
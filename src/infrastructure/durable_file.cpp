@@ -0,0 +1,71 @@
+#include "flight/infrastructure/durable_file.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace flight::infrastructure {
+
+namespace {
+
+[[noreturn]] void throw_errno(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+} // namespace
+
+void write_all(int fd, std::span<const std::byte> data, const std::string& path) {
+  const std::byte* p = data.data();
+  std::size_t left = data.size();
+  while (left > 0) {
+    const auto n = ::write(fd, p, left);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      throw_errno("write to " + path + " failed");
+    }
+    p += n;
+    left -= static_cast<std::size_t>(n);
+  }
+}
+
+void sync_file(int fd, const std::string& path) {
+#if defined(__APPLE__)
+  // fsync on macOS only reaches the drive cache; F_FULLFSYNC asks the drive to flush it.
+  if (::fcntl(fd, F_FULLFSYNC) == 0) return;
+  if (::fsync(fd) != 0) throw_errno("fsync of " + path + " failed");
+#else
+  if (::fdatasync(fd) != 0) throw_errno("fdatasync of " + path + " failed");
+#endif
+}
+
+void sync_parent_dir(const std::string& path) {
+  auto dir = std::filesystem::path(path).parent_path();
+  if (dir.empty()) dir = ".";
+  const int fd = ::open(dir.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) throw_errno("cannot open directory " + dir.string());
+  const int rc = ::fsync(fd);
+  ::close(fd);
+  if (rc != 0) throw_errno("fsync of directory " + dir.string() + " failed");
+}
+
+void replace_file(const std::string& path, std::initializer_list<std::span<const std::byte>> parts, bool sync) {
+  const std::string tmp = path + ".tmp";
+  const int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) throw_errno("cannot create " + tmp);
+  try {
+    for (const auto part : parts) write_all(fd, part, tmp);
+    if (sync) sync_file(fd, tmp);
+  } catch (...) {
+    ::close(fd);
+    throw;
+  }
+  if (::close(fd) != 0) throw_errno("close of " + tmp + " failed");
+  if (std::rename(tmp.c_str(), path.c_str()) != 0) throw_errno("cannot rename " + tmp);
+  if (sync) sync_parent_dir(path);
+}
+
+} // namespace flight::infrastructure
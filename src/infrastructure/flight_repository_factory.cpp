@@ -1,26 +1,54 @@
 #include "flight/infrastructure/flight_repository_factory.hpp"
 #include "flight/infrastructure/in_memory_flight_repository.hpp"
+#include "flight/infrastructure/instrumented_flight_repository.hpp"
+#include "flight/infrastructure/lock_free_flight_repository.hpp"
 #include "flight/infrastructure/sqlite_flight_repository.hpp"
 
 #include <stdexcept>
+#include <utility>
 
 namespace flight::infrastructure {
 
 FlightRepoType parse_flight_repo_type(const std::string& value) {
   if (value == "inmem") return FlightRepoType::InMemory;
+  if (value == "lockfree") return FlightRepoType::LockFree;
   if (value == "sqlite") return FlightRepoType::Sqlite;
-  throw std::invalid_argument("Unknown --flight-repo value: " + value + " (use inmem|sqlite)");
+  if (value == "sqlite-file") return FlightRepoType::SqliteFile;
+  throw std::invalid_argument("Unknown --flight-repo value: " + value + " (use inmem|lockfree|sqlite|sqlite-file)");
 }
 
-std::unique_ptr<flight::application::IFlightRepository>
-make_flight_repository(FlightRepoType type) {
+const char* flight_repo_type_name(FlightRepoType type) noexcept {
+  switch (type) {
+    case FlightRepoType::InMemory: return "inmem";
+    case FlightRepoType::LockFree: return "lockfree";
+    case FlightRepoType::Sqlite: return "sqlite";
+    case FlightRepoType::SqliteFile: return "sqlite-file";
+  }
+  return "unknown";
+}
+
+static std::unique_ptr<flight::application::IFlightRepository>
+make_plain_flight_repository(FlightRepoType type, const FlightRepoConfig& config) {
   switch (type) {
     case FlightRepoType::InMemory:
       return std::make_unique<InMemoryFlightRepository>();
+    case FlightRepoType::LockFree:
+      return std::make_unique<LockFreeFlightRepository>();
     case FlightRepoType::Sqlite:
       return std::make_unique<SqliteFlightRepository>(true); // :memory:
+    case FlightRepoType::SqliteFile:
+      return std::make_unique<SqliteFlightRepository>(config.sqlite_file); // WAL + reader pool
   }
   throw std::logic_error("Unhandled FlightRepoType");
 }
 
+std::unique_ptr<flight::application::IFlightRepository>
+make_flight_repository(FlightRepoType type, const FlightRepoConfig& config) {
+  auto repo = make_plain_flight_repository(type, config);
+  if (flight::util::Metrics::enabled() && config.instrumented) {
+    return std::make_unique<InstrumentedFlightRepository>(std::move(repo), flight_repo_type_name(type));
+  }
+  return repo;
+}
+
 } // namespace flight::infrastructure
@@ -1,53 +1,276 @@
 #include "flight/infrastructure/in_memory_flight_repository.hpp"
 
+#include "flight/util/metered_lock.hpp"
+
 #include <algorithm>
-#include <mutex>
+#include <numeric>
+#include <utility>
 
 namespace flight::infrastructure {
 
+namespace {
+
+using WriterLock = flight::util::MeteredUniqueLock<std::mutex>;
+
+struct LockMetrics {
+  flight::util::LockMetrics catalog_writer = flight::util::LockMetrics::named("in_memory_flights.catalog", "writer");
+  flight::util::LockMetrics flight_writer = flight::util::LockMetrics::named("in_memory_flights.flight", "writer");
+};
+
+const LockMetrics& locks() {
+  static const LockMetrics metrics;
+  return metrics;
+}
+
+void delete_version(void* version, void* resource) {
+  std::pmr::polymorphic_allocator<>(static_cast<std::pmr::memory_resource*>(resource))
+      .delete_object(static_cast<flight::domain::Flight*>(version));
+}
+
+} // namespace
+
+InMemoryFlightRepository::Entry::Entry(flight::domain::Flight f, allocator_type a)
+    : alloc(a), version(alloc.new_object<flight::domain::Flight>(std::move(f))) {}
+
+InMemoryFlightRepository::Entry::~Entry() {
+  alloc.delete_object(const_cast<flight::domain::Flight*>(version.load(std::memory_order_relaxed)));
+}
+
+flight::domain::Flight InMemoryFlightRepository::Entry::draft() const {
+  return flight::domain::Flight(*version.load(std::memory_order_relaxed), alloc);
+}
+
+void InMemoryFlightRepository::Entry::publish(flight::domain::Flight next) {
+  const auto* old =
+      version.exchange(alloc.new_object<flight::domain::Flight>(std::move(next)), std::memory_order_acq_rel);
+  retired.retire(const_cast<flight::domain::Flight*>(old), &delete_version, alloc.resource());
+}
+
+InMemoryFlightRepository::~InMemoryFlightRepository() {
+  std::pmr::polymorphic_allocator<> alloc(&pool_);
+  flights_.for_each([&](Entry& e) { alloc.delete_object(&e); });
+}
+
 std::optional<flight::domain::Flight> InMemoryFlightRepository::get(flight::domain::FlightId id) const {
-  std::shared_lock lk(mu_);
-  auto it = flights_.find(id.value());
-  if (it == flights_.end()) return std::nullopt;
-  return it->second;
+  flight::util::EpochGuard pin;
+  const auto* e = find(id);
+  if (!e) return std::nullopt;
+  return e->current();
 }
 
 std::vector<flight::domain::Flight> InMemoryFlightRepository::search(
     const flight::application::FlightSearchCriteria& criteria) const {
-  std::shared_lock lk(mu_);
+  flight::util::EpochGuard pin;
+  const auto ids = routes_.find(criteria);
   std::vector<flight::domain::Flight> out;
-  out.reserve(flights_.size());
-  for (const auto& [_, f] : flights_) {
-    if (f.origin() == criteria.origin && f.destination() == criteria.destination) {
-      out.push_back(f);
-    }
+  if (ids.empty()) return out;
+  out.reserve(RouteIndex::max_results(ids, criteria));
+  // The index is already ordered by (departure, id), so results need no sort.
+  for (const auto& entry : ids) {
+    if (RouteIndex::limit_reached(out.size(), criteria)) break;
+    const auto& f = find(flight::domain::FlightId{entry.id})->current();
+    if (RouteIndex::matches(entry, f, criteria)) out.push_back(f);
   }
-  // Sort deterministic by id
-  std::sort(out.begin(), out.end(), [](const auto& a, const auto& b) { return a.id() < b.id(); });
   return out;
 }
 
+bool InMemoryFlightRepository::visit(flight::domain::FlightId id,
+                                     const flight::application::FlightVisitor& visitor) const {
+  flight::util::EpochGuard pin;
+  const auto* e = find(id);
+  if (!e) return false;
+  visitor(e->current());
+  return true;
+}
+
+void InMemoryFlightRepository::visit_matches(const flight::application::FlightSearchCriteria& criteria,
+                                             const flight::application::FlightVisitor& visitor) const {
+  flight::util::EpochGuard pin;
+  std::size_t matched = 0;
+  for (const auto& entry : routes_.find(criteria)) {
+    if (RouteIndex::limit_reached(matched, criteria)) break;
+    const auto& f = find(flight::domain::FlightId{entry.id})->current();
+    if (!RouteIndex::matches(entry, f, criteria)) continue;
+    visitor(f);
+    ++matched;
+  }
+}
+
+void InMemoryFlightRepository::visit_all(const flight::application::FlightVisitor& visitor) const {
+  flight::util::EpochGuard pin;
+  flights_.for_each([&](const Entry& e) { visitor(e.current()); });
+}
+
 void InMemoryFlightRepository::upsert(flight::domain::Flight flight) {
-  std::unique_lock lk(mu_);
-  flights_.insert_or_assign(flight.id().value(), std::move(flight));
+  flight::util::EpochGuard pin;
+  if (auto* e = find(flight.id())) {
+    // Fast path: replacing a flight with the same route and departure only needs that flight's lock.
+    WriterLock flk(e->mu, locks().flight_writer);
+    if (RouteIndex::same_key(e->current(), flight)) {
+      e->publish(std::move(flight));
+      return;
+    }
+  }
+  // New flight or route/departure change: the index changes too.
+  WriterLock lk(write_mu_, locks().catalog_writer);
+  if (auto* e = find(flight.id())) {
+    WriterLock flk(e->mu, locks().flight_writer);
+    move(*e, std::move(flight));
+  } else {
+    auto* fresh = std::pmr::polymorphic_allocator<>(&pool_).new_object<Entry>(std::move(flight));
+    // Published in the table before the index, so every id a search finds resolves.
+    flights_.exchange(fresh->current().id().value(), fresh);
+    routes_.insert(fresh->current());
+  }
+}
+
+void InMemoryFlightRepository::move(Entry& e, flight::domain::Flight flight) {
+  if (RouteIndex::same_key(e.current(), flight)) {
+    e.publish(std::move(flight));
+    return;
+  }
+  // See RouteIndex::matches(); the old version stays readable while the caller is pinned.
+  const auto& before = e.current();
+  routes_.insert(flight);
+  e.publish(std::move(flight));
+  routes_.erase(before);
+}
+
+void InMemoryFlightRepository::upsert_many(std::vector<flight::domain::Flight> flights) {
+  if (flights.empty()) return;
+  flight::util::EpochGuard pin;
+  WriterLock lk(write_mu_, locks().catalog_writer);
+  flights_.reserve(flights_.size() + flights.size());
+  std::pmr::polymorphic_allocator<> alloc(&pool_);
+  std::vector<const Entry*> added;
+  for (auto& flight : flights) {
+    if (auto* e = find(flight.id())) {
+      WriterLock flk(e->mu, locks().flight_writer);
+      move(*e, std::move(flight));
+    } else {
+      auto* fresh = alloc.new_object<Entry>(std::move(flight));
+      flights_.exchange(fresh->current().id().value(), fresh);
+      added.push_back(fresh);
+    }
+  }
+  // New flights are indexed together: one copy of each touched route instead of one per flight.
+  std::vector<const flight::domain::Flight*> indexed;
+  indexed.reserve(added.size());
+  for (const auto* e : added) indexed.push_back(&e->current());
+  routes_.insert_many(indexed);
 }
 
 bool InMemoryFlightRepository::try_book_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) {
-  std::unique_lock lk(mu_);
-  auto it = flights_.find(flight_id.value());
-  if (it == flights_.end()) return false;
-  auto& f = it->second;
+  flight::util::EpochGuard pin;
+  auto* e = find(flight_id);
+  if (!e) return false;
+  WriterLock flk(e->mu, locks().flight_writer);
+  const auto& f = e->current();
+  // Rejections publish nothing; a booking publishes the next version.
   if (!f.is_seat_valid(seat) || f.is_booked(seat)) return false;
-  // Will throw only if invalid / already booked, but we checked.
-  f.book_seat(seat);
+  auto next = e->draft();
+  next.book_seat(seat);
+  e->publish(std::move(next));
+  return true;
+}
+
+std::vector<bool> InMemoryFlightRepository::try_book_seat_batch(
+    std::span<const flight::application::SeatBookingRequest> requests) {
+  std::vector<bool> results(requests.size(), false);
+  // Visit the requests grouped by flight (in request order within a flight), so each flight is locked once.
+  std::vector<std::size_t> order(requests.size());
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+    return requests[a].flight_id.value() < requests[b].flight_id.value();
+  });
+
+  flight::util::EpochGuard pin;
+  for (std::size_t i = 0; i < order.size();) {
+    const auto flight_id = requests[order[i]].flight_id;
+    std::size_t end = i;
+    while (end < order.size() && requests[order[end]].flight_id == flight_id) ++end;
+    if (auto* e = find(flight_id)) {
+      // One new version per flight for the whole group of requests.
+      WriterLock flk(e->mu, locks().flight_writer);
+      auto next = e->draft();
+      bool changed = false;
+      for (std::size_t k = i; k < end; ++k) {
+        const auto& seat = requests[order[k]].seat;
+        if (!next.is_seat_valid(seat) || next.is_booked(seat)) continue;
+        next.book_seat(seat);
+        results[order[k]] = true;
+        changed = true;
+      }
+      if (changed) e->publish(std::move(next));
+    }
+    i = end;
+  }
+  return results;
+}
+
+bool InMemoryFlightRepository::try_book_seats(flight::domain::FlightId flight_id,
+                                              std::span<const flight::domain::Seat> seats) {
+  if (seats.empty()) return false;
+  flight::util::EpochGuard pin;
+  auto* e = find(flight_id);
+  if (!e) return false;
+  // The whole group lands in one version; readers never see a partial booking.
+  WriterLock flk(e->mu, locks().flight_writer);
+  auto next = e->draft();
+  for (const auto& seat : seats) {
+    if (!next.is_seat_valid(seat) || next.is_booked(seat)) return false;
+    next.book_seat(seat);
+  }
+  e->publish(std::move(next));
   return true;
 }
 
 void InMemoryFlightRepository::release_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) {
-  std::unique_lock lk(mu_);
-  auto it = flights_.find(flight_id.value());
-  if (it == flights_.end()) return;
-  it->second.release_seat(seat);
+  flight::util::EpochGuard pin;
+  auto* e = find(flight_id);
+  if (!e) return;
+  WriterLock flk(e->mu, locks().flight_writer);
+  if (!e->current().is_booked(seat)) return;
+  auto next = e->draft();
+  next.release_seat(seat);
+  e->publish(std::move(next));
+}
+
+std::optional<std::uint32_t> InMemoryFlightRepository::available_count(flight::domain::FlightId flight_id) const {
+  std::optional<std::uint32_t> out;
+  visit(flight_id, [&out](const flight::domain::Flight& f) { out = f.available_count(); });
+  return out;
+}
+
+std::vector<flight::domain::Seat> InMemoryFlightRepository::first_free_seats(flight::domain::FlightId flight_id,
+                                                                             std::size_t n) const {
+  std::vector<flight::domain::Seat> out;
+  visit(flight_id, [&](const flight::domain::Flight& f) { out = f.first_free_seats(n); });
+  return out;
+}
+
+std::optional<flight::domain::Seat> InMemoryFlightRepository::book_any_seat(flight::domain::FlightId flight_id) {
+  flight::util::EpochGuard pin;
+  auto* e = find(flight_id);
+  if (!e) return std::nullopt;
+  WriterLock flk(e->mu, locks().flight_writer);
+  if (e->current().available_count() == 0) return std::nullopt;
+  auto next = e->draft();
+  auto seat = next.book_any_seat();
+  if (seat) e->publish(std::move(next));
+  return seat;
+}
+
+std::vector<flight::domain::Seat> InMemoryFlightRepository::book_adjacent_seats(flight::domain::FlightId flight_id,
+                                                                                std::size_t n) {
+  flight::util::EpochGuard pin;
+  auto* e = find(flight_id);
+  if (!e) return {};
+  WriterLock flk(e->mu, locks().flight_writer);
+  auto next = e->draft();
+  auto seats = next.book_adjacent_seats(n);
+  if (!seats.empty()) e->publish(std::move(next));
+  return seats;
 }
 
 } // namespace flight::infrastructure
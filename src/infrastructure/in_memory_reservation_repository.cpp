@@ -1,17 +1,74 @@
 #include "flight/infrastructure/in_memory_reservation_repository.hpp"
 
+#include "flight/util/metered_lock.hpp"
+
+#include <algorithm>
 #include <mutex>
 
 namespace flight::infrastructure {
 
+namespace {
+
+using SharedLock = flight::util::MeteredSharedLock<std::shared_mutex>;
+using UniqueLock = flight::util::MeteredUniqueLock<std::shared_mutex>;
+
+struct LockMetrics {
+  flight::util::LockMetrics shared = flight::util::LockMetrics::named("in_memory_reservations", "shared");
+  flight::util::LockMetrics exclusive = flight::util::LockMetrics::named("in_memory_reservations", "exclusive");
+};
+
+const LockMetrics& locks() {
+  static const LockMetrics metrics;
+  return metrics;
+}
+
+template <typename Index>
+void unindex(Index& index, typename Index::key_type key, flight::domain::ReservationId::value_type id) {
+  auto it = index.find(key);
+  if (it == index.end()) return;
+  std::erase(it->second, id);
+  if (it->second.empty()) index.erase(it);
+}
+
+} // namespace
+
+void InMemoryReservationRepository::add_locked(flight::domain::Reservation reservation) {
+  const auto id = reservation.id().value();
+  if (auto old = reservations_.find(id); old != reservations_.end()) {
+    // Replacing: drop the old index entries (the order/flight may have changed).
+    unindex(by_order_, old->second.order_id().value(), id);
+    unindex(by_flight_, old->second.flight_id().value(), id);
+  }
+  by_order_[reservation.order_id().value()].push_back(id);
+  by_flight_[reservation.flight_id().value()].push_back(id);
+  reservations_.insert_or_assign(id, std::move(reservation));
+}
+
+std::vector<flight::domain::Reservation> InMemoryReservationRepository::collect_locked(const IdList* ids) const {
+  std::vector<flight::domain::Reservation> out;
+  if (!ids) return out;
+  out.reserve(ids->size());
+  for (const auto id : *ids) {
+    out.push_back(reservations_.at(id));
+  }
+  return out;
+}
+
 void InMemoryReservationRepository::add(flight::domain::Reservation reservation) {
-  std::unique_lock lk(mu_);
-  reservations_.insert_or_assign(reservation.id().value(), std::move(reservation));
+  UniqueLock lk(mu_, locks().exclusive);
+  add_locked(std::move(reservation));
+}
+
+void InMemoryReservationRepository::add_many(std::vector<flight::domain::Reservation> reservations) {
+  UniqueLock lk(mu_, locks().exclusive);
+  for (auto& r : reservations) {
+    add_locked(std::move(r));
+  }
 }
 
 std::optional<flight::domain::Reservation> InMemoryReservationRepository::get(
     flight::domain::ReservationId id) const {
-  std::shared_lock lk(mu_);
+  SharedLock lk(mu_, locks().shared);
   auto it = reservations_.find(id.value());
   if (it == reservations_.end()) return std::nullopt;
   return it->second;
@@ -19,14 +76,16 @@ std::optional<flight::domain::Reservation> InMemoryReservationRepository::get(
 
 std::vector<flight::domain::Reservation> InMemoryReservationRepository::list_by_order(
     flight::domain::OrderId order_id) const {
-  std::shared_lock lk(mu_);
-  std::vector<flight::domain::Reservation> out;
-  for (const auto& [_, r] : reservations_) {
-    if (r.order_id() == order_id) {
-      out.push_back(r);
-    }
-  }
-  return out;
+  SharedLock lk(mu_, locks().shared);
+  auto it = by_order_.find(order_id.value());
+  return collect_locked(it == by_order_.end() ? nullptr : &it->second);
+}
+
+std::vector<flight::domain::Reservation> InMemoryReservationRepository::list_by_flight(
+    flight::domain::FlightId flight_id) const {
+  SharedLock lk(mu_, locks().shared);
+  auto it = by_flight_.find(flight_id.value());
+  return collect_locked(it == by_flight_.end() ? nullptr : &it->second);
 }
 
 } // namespace flight::infrastructure
@@ -0,0 +1,141 @@
+#include "flight/infrastructure/instrumented_flight_repository.hpp"
+
+#include <string>
+#include <utility>
+
+namespace flight::infrastructure {
+
+using flight::util::ScopedTimer;
+
+InstrumentedFlightRepository::InstrumentedFlightRepository(
+    std::unique_ptr<flight::application::IFlightRepository> inner, std::string_view label)
+    : inner_(std::move(inner)) {
+  static constexpr std::array<const char*, kOpCount> kNames{
+      "get",
+      "search",
+      "visit",
+      "visit_matches",
+      "visit_all",
+      "search_summaries",
+      "search_in",
+      "search_summaries_in",
+      "upsert",
+      "upsert_many",
+      "try_book_seat",
+      "try_book_seats",
+      "release_seat",
+      "try_book_seat_batch",
+      "available_count",
+      "first_free_seats",
+      "book_any_seat",
+      "book_adjacent_seats"};
+  for (std::size_t op = 0; op < kOpCount; ++op) {
+    ops_[op] = flight::util::Metrics::global().histogram(
+        "flight_repository_op_seconds", "repo=\"" + std::string(label) + "\",op=\"" + kNames[op] + "\"",
+        "Latency of IFlightRepository calls.");
+  }
+}
+
+std::optional<flight::domain::Flight> InstrumentedFlightRepository::get(flight::domain::FlightId id) const {
+  const ScopedTimer timer(ops_[kGet]);
+  return inner_->get(id);
+}
+
+std::vector<flight::domain::Flight> InstrumentedFlightRepository::search(
+    const flight::application::FlightSearchCriteria& criteria) const {
+  const ScopedTimer timer(ops_[kSearch]);
+  return inner_->search(criteria);
+}
+
+bool InstrumentedFlightRepository::visit(flight::domain::FlightId id,
+                                         const flight::application::FlightVisitor& visitor) const {
+  const ScopedTimer timer(ops_[kVisit]);
+  return inner_->visit(id, visitor);
+}
+
+void InstrumentedFlightRepository::visit_matches(const flight::application::FlightSearchCriteria& criteria,
+                                                 const flight::application::FlightVisitor& visitor) const {
+  const ScopedTimer timer(ops_[kVisitMatches]);
+  inner_->visit_matches(criteria, visitor);
+}
+
+void InstrumentedFlightRepository::visit_all(const flight::application::FlightVisitor& visitor) const {
+  const ScopedTimer timer(ops_[kVisitAll]);
+  inner_->visit_all(visitor);
+}
+
+std::vector<flight::application::FlightSummary> InstrumentedFlightRepository::search_summaries(
+    const flight::application::FlightSearchCriteria& criteria) const {
+  const ScopedTimer timer(ops_[kSearchSummaries]);
+  return inner_->search_summaries(criteria);
+}
+
+std::pmr::vector<flight::domain::Flight> InstrumentedFlightRepository::search_in(
+    const flight::application::FlightSearchCriteria& criteria, std::pmr::memory_resource* mr) const {
+  const ScopedTimer timer(ops_[kSearchIn]);
+  return inner_->search_in(criteria, mr);
+}
+
+std::pmr::vector<flight::application::FlightSummary> InstrumentedFlightRepository::search_summaries_in(
+    const flight::application::FlightSearchCriteria& criteria, std::pmr::memory_resource* mr) const {
+  const ScopedTimer timer(ops_[kSearchSummariesIn]);
+  return inner_->search_summaries_in(criteria, mr);
+}
+
+void InstrumentedFlightRepository::upsert(flight::domain::Flight flight) {
+  const ScopedTimer timer(ops_[kUpsert]);
+  inner_->upsert(std::move(flight));
+}
+
+void InstrumentedFlightRepository::upsert_many(std::vector<flight::domain::Flight> flights) {
+  const ScopedTimer timer(ops_[kUpsertMany]);
+  inner_->upsert_many(std::move(flights));
+}
+
+bool InstrumentedFlightRepository::try_book_seat(flight::domain::FlightId flight_id,
+                                                 const flight::domain::Seat& seat) {
+  const ScopedTimer timer(ops_[kTryBookSeat]);
+  return inner_->try_book_seat(flight_id, seat);
+}
+
+bool InstrumentedFlightRepository::try_book_seats(flight::domain::FlightId flight_id,
+                                                  std::span<const flight::domain::Seat> seats) {
+  const ScopedTimer timer(ops_[kTryBookSeats]);
+  return inner_->try_book_seats(flight_id, seats);
+}
+
+void InstrumentedFlightRepository::release_seat(flight::domain::FlightId flight_id,
+                                                const flight::domain::Seat& seat) {
+  const ScopedTimer timer(ops_[kReleaseSeat]);
+  inner_->release_seat(flight_id, seat);
+}
+
+std::vector<bool> InstrumentedFlightRepository::try_book_seat_batch(
+    std::span<const flight::application::SeatBookingRequest> requests) {
+  const ScopedTimer timer(ops_[kTryBookSeatBatch]);
+  return inner_->try_book_seat_batch(requests);
+}
+
+std::optional<std::uint32_t> InstrumentedFlightRepository::available_count(flight::domain::FlightId flight_id) const {
+  const ScopedTimer timer(ops_[kAvailableCount]);
+  return inner_->available_count(flight_id);
+}
+
+std::vector<flight::domain::Seat> InstrumentedFlightRepository::first_free_seats(flight::domain::FlightId flight_id,
+                                                                                 std::size_t n) const {
+  const ScopedTimer timer(ops_[kFirstFreeSeats]);
+  return inner_->first_free_seats(flight_id, n);
+}
+
+std::optional<flight::domain::Seat> InstrumentedFlightRepository::book_any_seat(flight::domain::FlightId flight_id) {
+  const ScopedTimer timer(ops_[kBookAnySeat]);
+  return inner_->book_any_seat(flight_id);
+}
+
+std::vector<flight::domain::Seat> InstrumentedFlightRepository::book_adjacent_seats(
+    flight::domain::FlightId flight_id, std::size_t n) {
+  const ScopedTimer timer(ops_[kBookAdjacentSeats]);
+  return inner_->book_adjacent_seats(flight_id, n);
+}
+
+} // namespace flight::infrastructure
@@ -0,0 +1,50 @@
+#include "flight/infrastructure/instrumented_reservation_repository.hpp"
+
+#include <string>
+#include <utility>
+
+namespace flight::infrastructure {
+
+using flight::util::ScopedTimer;
+
+InstrumentedReservationRepository::InstrumentedReservationRepository(
+    std::unique_ptr<flight::application::IReservationRepository> inner, std::string_view label)
+    : inner_(std::move(inner)) {
+  static constexpr std::array<const char*, kOpCount> kNames{"add", "add_many", "get", "list_by_order",
+                                                            "list_by_flight"};
+  for (std::size_t op = 0; op < kOpCount; ++op) {
+    ops_[op] = flight::util::Metrics::global().histogram(
+        "flight_reservation_repository_op_seconds", "repo=\"" + std::string(label) + "\",op=\"" + kNames[op] + "\"",
+        "Latency of IReservationRepository calls.");
+  }
+}
+
+void InstrumentedReservationRepository::add(flight::domain::Reservation reservation) {
+  const ScopedTimer timer(ops_[kAdd]);
+  inner_->add(std::move(reservation));
+}
+
+void InstrumentedReservationRepository::add_many(std::vector<flight::domain::Reservation> reservations) {
+  const ScopedTimer timer(ops_[kAddMany]);
+  inner_->add_many(std::move(reservations));
+}
+
+std::optional<flight::domain::Reservation> InstrumentedReservationRepository::get(
+    flight::domain::ReservationId id) const {
+  const ScopedTimer timer(ops_[kGet]);
+  return inner_->get(id);
+}
+
+std::vector<flight::domain::Reservation> InstrumentedReservationRepository::list_by_order(
+    flight::domain::OrderId order_id) const {
+  const ScopedTimer timer(ops_[kListByOrder]);
+  return inner_->list_by_order(order_id);
+}
+
+std::vector<flight::domain::Reservation> InstrumentedReservationRepository::list_by_flight(
+    flight::domain::FlightId flight_id) const {
+  const ScopedTimer timer(ops_[kListByFlight]);
+  return inner_->list_by_flight(flight_id);
+}
+
+} // namespace flight::infrastructure
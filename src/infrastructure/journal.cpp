@@ -0,0 +1,169 @@
+#include "flight/infrastructure/journal.hpp"
+#include "flight/infrastructure/durable_file.hpp"
+#include "flight/util/crc32.hpp"
+
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace flight::infrastructure {
+
+namespace {
+
+using flight::util::crc32;
+
+constexpr std::size_t kHeaderBytes = 8; // u32 length + u32 crc32
+
+void put_u32(std::vector<std::byte>& out, std::uint32_t v) {
+  for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::byte>(v >> (8 * i)));
+}
+
+std::uint32_t get_u32(const std::byte* p) noexcept {
+  std::uint32_t v = 0;
+  for (int i = 0; i < 4; ++i) v |= static_cast<std::uint32_t>(p[i]) << (8 * i);
+  return v;
+}
+
+void frame(std::vector<std::byte>& out, std::span<const std::byte> record) {
+  if (record.size() > std::numeric_limits<std::uint32_t>::max()) throw std::length_error("Journal: record too large");
+  put_u32(out, static_cast<std::uint32_t>(record.size()));
+  put_u32(out, crc32(record));
+  out.insert(out.end(), record.begin(), record.end());
+}
+
+[[noreturn]] void throw_errno(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+int open_append(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+  if (fd < 0) throw_errno("Journal: cannot open " + path);
+  return fd;
+}
+
+} // namespace
+
+Journal::Journal(std::string path, bool sync) : path_(std::move(path)), sync_(sync) {
+  fd_ = open_append(path_);
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(path_, ec);
+  file_bytes_ = ec ? 0 : size;
+  flusher_ = std::thread([this] { run_flusher(); });
+}
+
+Journal::~Journal() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    stopping_ = true;
+  }
+  work_cv_.notify_one();
+  flusher_.join();
+  ::close(fd_);
+}
+
+std::size_t Journal::replay(const std::string& path, const RecordVisitor& visit) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) return 0;
+  std::vector<char> raw((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+  const std::span<const std::byte> data(reinterpret_cast<const std::byte*>(raw.data()), raw.size());
+
+  std::size_t offset = 0;
+  std::size_t records = 0;
+  while (data.size() - offset >= kHeaderBytes) {
+    const auto length = get_u32(data.data() + offset);
+    const auto crc = get_u32(data.data() + offset + 4);
+    if (length > data.size() - offset - kHeaderBytes) break;
+    const auto record = data.subspan(offset + kHeaderBytes, length);
+    if (crc32(record) != crc) break;
+    visit(record);
+    offset += kHeaderBytes + length;
+    ++records;
+  }
+  if (offset != data.size()) {
+    std::error_code ec;
+    std::filesystem::resize_file(path, offset, ec);
+    if (ec) throw std::system_error(ec, "Journal: cannot truncate torn tail of " + path);
+  }
+  return records;
+}
+
+Journal::Lsn Journal::append(std::span<const std::byte> record) {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (error_) std::rethrow_exception(error_);
+  const bool was_idle = pending_.empty();
+  frame(pending_, record);
+  if (was_idle) work_cv_.notify_one();
+  return ++appended_;
+}
+
+void Journal::wait_durable(Lsn lsn) {
+  std::unique_lock<std::mutex> lk(mu_);
+  durable_cv_.wait(lk, [&] { return durable_ >= lsn || error_; });
+  if (durable_ < lsn) std::rethrow_exception(error_);
+}
+
+std::uint64_t Journal::size_bytes() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return file_bytes_ + pending_.size();
+}
+
+void Journal::run_flusher() {
+  std::vector<std::byte> batch;
+  std::unique_lock<std::mutex> lk(mu_);
+  while (true) {
+    work_cv_.wait(lk, [&] { return stopping_ || !pending_.empty(); });
+    if (pending_.empty()) return; // stopping, nothing left to flush
+
+    // Everything appended while the previous batch was being synced goes out in this one.
+    batch.swap(pending_);
+    const Lsn batch_end = appended_;
+    lk.unlock();
+    std::exception_ptr error;
+    try {
+      write_all(fd_, batch, path_);
+      if (sync_) sync_file(fd_, path_);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    const auto written = batch.size();
+    batch.clear();
+    lk.lock();
+
+    if (error) {
+      error_ = error;
+      pending_.clear();
+    } else {
+      durable_ = batch_end;
+      file_bytes_ += written;
+    }
+    durable_cv_.notify_all();
+    if (error_) return;
+  }
+}
+
+void Journal::rewrite(const std::function<void(const RecordVisitor& emit)>& write) {
+  std::unique_lock<std::mutex> lk(mu_);
+  durable_cv_.wait(lk, [&] { return durable_ >= appended_ || error_; });
+  if (error_) std::rethrow_exception(error_);
+
+  std::vector<std::byte> buffer;
+  write([&buffer](std::span<const std::byte> record) { frame(buffer, record); });
+  replace_file(path_, {buffer}, sync_);
+
+  // The old descriptor still points at the replaced file; appends must go to the new one.
+  const int new_fd = open_append(path_);
+  ::close(fd_);
+  fd_ = new_fd;
+  file_bytes_ = buffer.size();
+}
+
+} // namespace flight::infrastructure
@@ -0,0 +1,694 @@
+#include "flight/infrastructure/journaled_repositories.hpp"
+
+#include "flight/infrastructure/catalog_snapshot.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+namespace flight::infrastructure {
+
+using flight::domain::AirportCode;
+using flight::domain::Flight;
+using flight::domain::FlightId;
+using flight::domain::OrderId;
+using flight::domain::Reservation;
+using flight::domain::ReservationId;
+using flight::domain::Seat;
+using flight::domain::SeatMap;
+
+namespace {
+
+// Record payloads, little-endian. Timestamps are nanoseconds since the system_clock epoch.
+//   kUpsertFlight     u64 id, u16 origin, u16 destination, i64 departure, u16 rows, u8 seats_per_row,
+//                     u32 word count, u64 booked-seat words (SeatMap layout)
+//   kBookSeats        u64 flight, u32 count, count x (u16 row, u8 letter)
+//   kReleaseSeat      u64 flight, u16 row, u8 letter
+//   kAddReservations  u32 count, count x (u64 id, u64 order, u64 flight, u16 row, u8 letter, i64 created_at)
+//   kUpsertFlights    u32 count, count x (kUpsertFlight payload)
+//   kGroup            u32 count, count x (u32 length, record): one change group, replayed as a whole or not at all
+//   kBase             u32 snapshot checksum, u64 flight count: the catalog snapshot a checkpoint was written on top of
+enum class RecordType : std::uint8_t {
+  kUpsertFlight = 1,
+  kBookSeats = 2,
+  kReleaseSeat = 3,
+  kAddReservations = 4,
+  kUpsertFlights = 5,
+  kGroup = 6,
+  kBase = 7
+};
+
+class RecordWriter final {
+public:
+  explicit RecordWriter(RecordType type) { u8(static_cast<std::uint8_t>(type)); }
+
+  void u8(std::uint8_t v) { bytes_.push_back(static_cast<std::byte>(v)); }
+  void u16(std::uint16_t v) { put(v, 2); }
+  void u32(std::uint32_t v) { put(v, 4); }
+  void u64(std::uint64_t v) { put(v, 8); }
+  void time(std::chrono::system_clock::time_point tp) {
+    u64(static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count()));
+  }
+  void seat(const Seat& s) {
+    u16(s.row());
+    u8(static_cast<std::uint8_t>(s.letter()));
+  }
+  void raw(std::span<const std::byte> bytes) { bytes_.insert(bytes_.end(), bytes.begin(), bytes.end()); }
+
+  std::span<const std::byte> bytes() const noexcept { return bytes_; }
+
+private:
+  void put(std::uint64_t v, int n) {
+    for (int i = 0; i < n; ++i) bytes_.push_back(static_cast<std::byte>(v >> (8 * i)));
+  }
+
+  std::vector<std::byte> bytes_;
+};
+
+class RecordReader final {
+public:
+  explicit RecordReader(std::span<const std::byte> bytes) : bytes_(bytes) {}
+
+  std::uint8_t u8() { return static_cast<std::uint8_t>(get(1)); }
+  std::uint16_t u16() { return static_cast<std::uint16_t>(get(2)); }
+  std::uint32_t u32() { return static_cast<std::uint32_t>(get(4)); }
+  std::uint64_t u64() { return get(8); }
+  std::chrono::system_clock::time_point time() {
+    const std::chrono::nanoseconds ns(static_cast<std::int64_t>(u64()));
+    return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(ns));
+  }
+  Seat seat() {
+    const auto row = u16();
+    return Seat(row, static_cast<char>(u8()));
+  }
+  std::span<const std::byte> raw(std::size_t n) {
+    if (bytes_.size() - offset_ < n) throw std::runtime_error("Journal: truncated record");
+    offset_ += n;
+    return bytes_.subspan(offset_ - n, n);
+  }
+
+  void expect_end() const {
+    if (offset_ != bytes_.size()) throw std::runtime_error("Journal: trailing bytes in record");
+  }
+
+private:
+  std::uint64_t get(int n) {
+    if (bytes_.size() - offset_ < static_cast<std::size_t>(n)) throw std::runtime_error("Journal: truncated record");
+    std::uint64_t v = 0;
+    for (int i = 0; i < n; ++i) v |= static_cast<std::uint64_t>(bytes_[offset_++]) << (8 * i);
+    return v;
+  }
+
+  std::span<const std::byte> bytes_;
+  std::size_t offset_{0};
+};
+
+void write_flight(RecordWriter& w, const Flight& f) {
+  w.u64(f.id().value());
+  w.u16(f.origin().packed());
+  w.u16(f.destination().packed());
+  w.time(f.departure());
+  w.u16(f.rows());
+  w.u8(f.seats_per_row());
+  const auto words = f.seat_map().words();
+  w.u32(static_cast<std::uint32_t>(words.size()));
+  for (const auto word : words) w.u64(word);
+}
+
+RecordWriter upsert_record(const Flight& f) {
+  RecordWriter w(RecordType::kUpsertFlight);
+  write_flight(w, f);
+  return w;
+}
+
+RecordWriter upsert_many_record(std::span<const Flight> flights) {
+  RecordWriter w(RecordType::kUpsertFlights);
+  w.u32(static_cast<std::uint32_t>(flights.size()));
+  for (const auto& f : flights) write_flight(w, f);
+  return w;
+}
+
+Flight read_flight(RecordReader& r) {
+  const FlightId id{r.u64()};
+  const auto origin = AirportCode::from_packed(r.u16());
+  const auto destination = AirportCode::from_packed(r.u16());
+  const auto departure = r.time();
+  const auto rows = r.u16();
+  const auto seats_per_row = r.u8();
+  SeatMap seats(rows, seats_per_row);
+  const auto word_count = r.u32();
+  if (word_count != SeatMap::words_for(seats.capacity())) throw std::runtime_error("Journal: seat map size mismatch");
+  for (std::size_t i = 0; i < word_count; ++i) {
+    for (auto bits = r.u64(); bits != 0; bits &= bits - 1) {
+      const auto index = i * SeatMap::kWordBits + static_cast<std::size_t>(std::countr_zero(bits));
+      if (index >= seats.capacity()) throw std::runtime_error("Journal: booked seat outside the seat map");
+      seats.set(index);
+    }
+  }
+  return Flight(id, origin, destination, departure, rows, seats_per_row, std::move(seats));
+}
+
+RecordWriter book_record(FlightId flight_id, std::span<const Seat> seats) {
+  RecordWriter w(RecordType::kBookSeats);
+  w.u64(flight_id.value());
+  w.u32(static_cast<std::uint32_t>(seats.size()));
+  for (const auto& s : seats) w.seat(s);
+  return w;
+}
+
+RecordWriter release_record(FlightId flight_id, const Seat& seat) {
+  RecordWriter w(RecordType::kReleaseSeat);
+  w.u64(flight_id.value());
+  w.seat(seat);
+  return w;
+}
+
+RecordWriter reservations_record(std::span<const Reservation> reservations) {
+  RecordWriter w(RecordType::kAddReservations);
+  w.u32(static_cast<std::uint32_t>(reservations.size()));
+  for (const auto& r : reservations) {
+    w.u64(r.id().value());
+    w.u64(r.order_id().value());
+    w.u64(r.flight_id().value());
+    w.seat(r.seat());
+    w.time(r.created_at());
+  }
+  return w;
+}
+
+} // namespace
+
+BookingJournal::BookingJournal(std::unique_ptr<flight::application::IFlightRepository> flights,
+                               std::unique_ptr<flight::application::IReservationRepository> reservations,
+                               JournalOptions options)
+    : flights_(std::move(flights)), reservations_(std::move(reservations)), options_(std::move(options)) {
+  std::set<std::uint64_t> replayed_flights;
+  recovery_.records = Journal::replay(
+      options_.path, [&](std::span<const std::byte> bytes) { replay_record(bytes, replayed_flights); });
+  journal_ = std::make_unique<Journal>(options_.path, options_.sync);
+  base_ = options_.snapshot;
+  checkpointer_ = std::thread([this] { run_checkpointer(); });
+}
+
+void BookingJournal::replay_record(std::span<const std::byte> bytes, std::set<std::uint64_t>& replayed_flights) {
+  RecordReader r(bytes);
+  switch (static_cast<RecordType>(r.u8())) {
+    case RecordType::kUpsertFlight: {
+      auto flight = read_flight(r);
+      r.expect_end();
+      recovery_.max_flight_id = std::max(recovery_.max_flight_id, flight.id().value());
+      if (replayed_flights.insert(flight.id().value()).second) ++recovery_.flights;
+      flights_->upsert(std::move(flight));
+      break;
+    }
+    case RecordType::kUpsertFlights: {
+      std::vector<Flight> batch;
+      for (auto n = r.u32(); n > 0; --n) {
+        batch.push_back(read_flight(r));
+        recovery_.max_flight_id = std::max(recovery_.max_flight_id, batch.back().id().value());
+        if (replayed_flights.insert(batch.back().id().value()).second) ++recovery_.flights;
+      }
+      r.expect_end();
+      flights_->upsert_many(std::move(batch));
+      break;
+    }
+    case RecordType::kBookSeats: {
+      const FlightId flight_id{r.u64()};
+      std::vector<Seat> seats;
+      for (auto n = r.u32(); n > 0; --n) seats.push_back(r.seat());
+      r.expect_end();
+      if (!flights_->try_book_seats(flight_id, seats)) {
+        throw std::runtime_error("Journal: replayed booking conflicts on flight " +
+                                 std::to_string(flight_id.value()));
+      }
+      break;
+    }
+    case RecordType::kReleaseSeat: {
+      const FlightId flight_id{r.u64()};
+      const auto seat = r.seat();
+      r.expect_end();
+      flights_->release_seat(flight_id, seat);
+      break;
+    }
+    case RecordType::kAddReservations: {
+      std::vector<Reservation> batch;
+      for (auto n = r.u32(); n > 0; --n) {
+        const ReservationId id{r.u64()};
+        const OrderId order_id{r.u64()};
+        const FlightId flight_id{r.u64()};
+        const auto seat = r.seat();
+        batch.emplace_back(id, order_id, flight_id, seat, r.time());
+        recovery_.max_reservation_id = std::max(recovery_.max_reservation_id, id.value());
+        recovery_.max_order_id = std::max(recovery_.max_order_id, order_id.value());
+        flight_ids_.insert(flight_id.value());
+      }
+      r.expect_end();
+      recovery_.reservations += batch.size();
+      reservations_->add_many(std::move(batch));
+      break;
+    }
+    case RecordType::kBase: {
+      const auto checksum = r.u32();
+      const auto flights = r.u64();
+      r.expect_end();
+      if (!options_.snapshot || options_.snapshot->checksum() != checksum || options_.snapshot->size() != flights) {
+        throw std::runtime_error("Journal: checkpointed on top of catalog snapshot " + std::to_string(checksum) + " (" +
+                                 std::to_string(flights) + " flights); open it with that snapshot");
+      }
+      break;
+    }
+    case RecordType::kGroup: {
+      std::vector<std::span<const std::byte>> records;
+      for (auto n = r.u32(); n > 0; --n) records.push_back(r.raw(r.u32()));
+      r.expect_end();
+      for (const auto record : records) replay_record(record, replayed_flights);
+      break;
+    }
+    default:
+      throw std::runtime_error("Journal: unknown record type");
+  }
+}
+
+BookingJournal::~BookingJournal() {
+  {
+    std::lock_guard<std::mutex> lk(checkpoint_mu_);
+    stopping_ = true;
+  }
+  checkpoint_cv_.notify_one();
+  checkpointer_.join();
+}
+
+// Applies a change and journals it: `apply(emit)` runs against the inner repositories and calls `emit` with
+// the record describing the change (not at all if nothing changed). A change whose record is known up front
+// emits it first and then applies it, so a failed append leaves nothing applied; a booking, whose outcome is
+// only known once applied, also passes emit the seats it booked, released again if the append fails. The record
+// is appended before the locks are dropped and waited for after, so concurrent changes share one sync.
+template <typename Apply>
+auto BookingJournal::change(std::optional<FlightId> flight_id, Apply&& apply) {
+  check();
+  if (in_group()) {
+    // The group already holds the locks; its records are appended together when it closes.
+    auto& group = *open_group_;
+    if (flight_id && !group.covers(*flight_id)) {
+      throw std::logic_error("BookingJournal: change to another flight inside a change group");
+    }
+    return apply([&](const RecordWriter& record, std::span<const Seat> booked = {}) {
+      group.add(record.bytes());
+      for (const auto& seat : booked) group.booked.push_back({*flight_id, seat});
+    });
+  }
+  Journal::Lsn lsn = 0;
+  const auto emit = [&](const RecordWriter& record, std::span<const Seat> booked = {}) {
+    try {
+      lsn = journal_->append(record.bytes());
+    } catch (...) {
+      if (flight_id) release(*flight_id, booked);
+      throw;
+    }
+  };
+  auto result = [&] {
+    std::shared_lock<std::shared_mutex> lk(change_mu_);
+    std::unique_lock<std::mutex> stripe;
+    if (flight_id) stripe = std::unique_lock<std::mutex>(stripes_[flight_id->value() % kStripes]);
+    return apply(emit);
+  }();
+  commit(lsn);
+  return result;
+}
+
+void BookingJournal::commit(Journal::Lsn lsn) {
+  if (lsn == 0) return;
+  try {
+    journal_->wait_durable(lsn);
+  } catch (...) {
+    // The change is applied in memory but may not be on disk, and the journal takes no more records: stop
+    // serving rather than let anyone act on state a restart would not restore.
+    failed_.store(true, std::memory_order_release);
+    throw;
+  }
+  request_checkpoint_if_due();
+}
+
+void BookingJournal::check() const {
+  if (failed_.load(std::memory_order_acquire)) {
+    throw std::runtime_error("BookingJournal: the journal could not be synced; restart to recover from it");
+  }
+}
+
+// change() for a batch that may touch any flight: holds change_mu_ exclusively instead of one stripe.
+template <typename Apply>
+void BookingJournal::change_all(Apply&& apply) {
+  check();
+  if (in_group()) {
+    throw std::logic_error("BookingJournal: catalog batch inside a change group");
+  }
+  Journal::Lsn lsn = 0;
+  const auto emit = [&](const RecordWriter& record) { lsn = journal_->append(record.bytes()); };
+  {
+    std::unique_lock<std::shared_mutex> lk(change_mu_);
+    apply(emit);
+  }
+  commit(lsn);
+}
+
+void BookingJournal::release(FlightId flight_id, std::span<const Seat> seats) {
+  for (const auto& seat : seats) flights_->release_seat(flight_id, seat);
+}
+
+thread_local BookingJournal::Group* BookingJournal::open_group_ = nullptr;
+
+void BookingJournal::Group::add(std::span<const std::byte> record) {
+  const auto length = static_cast<std::uint32_t>(record.size());
+  for (int i = 0; i < 4; ++i) records.push_back(static_cast<std::byte>(length >> (8 * i)));
+  records.insert(records.end(), record.begin(), record.end());
+  last = record.size();
+  ++count;
+}
+
+bool BookingJournal::in_group() const noexcept { return open_group_ != nullptr && open_group_->journal == this; }
+
+bool BookingJournal::Group::covers(FlightId flight_id) const {
+  return std::binary_search(flight_ids.begin(), flight_ids.end(), flight_id);
+}
+
+void BookingJournal::begin_group(std::span<const FlightId> flight_ids) {
+  check();
+  if (open_group_ != nullptr) throw std::logic_error("BookingJournal: change groups do not nest");
+  auto group = std::make_unique<Group>();
+  group->journal = this;
+  group->flight_ids.assign(flight_ids.begin(), flight_ids.end());
+  std::sort(group->flight_ids.begin(), group->flight_ids.end());
+  group->flight_ids.erase(std::unique(group->flight_ids.begin(), group->flight_ids.end()), group->flight_ids.end());
+  // Stripes are taken in index order, so groups over several flights cannot deadlock with each other (changes
+  // outside a group hold one stripe at a time).
+  std::vector<std::size_t> stripes;
+  for (const auto id : group->flight_ids) stripes.push_back(id.value() % kStripes);
+  std::sort(stripes.begin(), stripes.end());
+  stripes.erase(std::unique(stripes.begin(), stripes.end()), stripes.end());
+  group->changes = std::shared_lock<std::shared_mutex>(change_mu_);
+  for (const auto stripe : stripes) group->stripes.emplace_back(stripes_[stripe]);
+  open_group_ = group.release();
+}
+
+std::unique_ptr<BookingJournal::Group> BookingJournal::close_group() noexcept {
+  if (open_group_ == nullptr || open_group_->journal != this) return nullptr;
+  return std::unique_ptr<Group>(std::exchange(open_group_, nullptr));
+}
+
+// Appends the group's records as one, under its locks, so they keep their place in the per-flight order. If
+// that fails, the group's bookings are undone like a single booking's.
+Journal::Lsn BookingJournal::append_group(Group& group) {
+  if (group.count == 0) return 0;
+  try {
+    if (group.count == 1) return journal_->append(std::span<const std::byte>(group.records).last(group.last));
+    RecordWriter w(RecordType::kGroup);
+    w.u32(group.count);
+    w.raw(group.records);
+    return journal_->append(w.bytes());
+  } catch (...) {
+    for (const auto& b : group.booked) flights_->release_seat(b.flight_id, b.seat);
+    throw;
+  }
+}
+
+void BookingJournal::commit_group() {
+  auto group = close_group();
+  if (!group) throw std::logic_error("BookingJournal: no change group is open");
+  const auto lsn = append_group(*group);
+  group.reset(); // unlock before waiting, so concurrent changes share the sync
+  commit(lsn);
+}
+
+void BookingJournal::end_group() noexcept {
+  if (auto group = close_group()) {
+    try {
+      append_group(*group);
+    } catch (...) {
+      // Undone by append_group(); the caller is already unwinding.
+    }
+  }
+}
+
+void BookingJournal::remember_flight(FlightId flight_id) {
+  std::lock_guard<std::mutex> lk(ids_mu_);
+  flight_ids_.insert(flight_id.value());
+}
+
+void BookingJournal::request_checkpoint_if_due() {
+  if (options_.checkpoint_bytes == 0 || journal_->size_bytes() < options_.checkpoint_bytes) return;
+  {
+    std::lock_guard<std::mutex> lk(checkpoint_mu_);
+    if (checkpoint_due_) return;
+    checkpoint_due_ = true;
+  }
+  checkpoint_cv_.notify_one();
+}
+
+void BookingJournal::run_checkpointer() {
+  std::unique_lock<std::mutex> lk(checkpoint_mu_);
+  while (true) {
+    checkpoint_cv_.wait(lk, [this] { return stopping_ || checkpoint_due_; });
+    if (stopping_) return;
+    lk.unlock();
+    try {
+      checkpoint();
+    } catch (...) {
+      // The journal keeps growing; the next change past the threshold retries.
+    }
+    lk.lock();
+    checkpoint_due_ = false;
+  }
+}
+
+void BookingJournal::checkpoint() {
+  std::unique_lock<std::shared_mutex> lk(change_mu_);
+  rewrite();
+}
+
+std::size_t BookingJournal::write_snapshot(const std::string& path) {
+  std::unique_lock<std::shared_mutex> lk(change_mu_);
+  check();
+  // 1) A self-contained checkpoint, valid over the old snapshot and the new one alike (it overwrites every
+  //    flight), covers a crash before 3). Replaying the old journal over the new snapshot would book its seats
+  //    twice.
+  base_.reset();
+  rewrite();
+  // 2) The snapshot, then 3) the compact checkpoint on top of it.
+  CatalogSnapshot::write(path, *flights_);
+  base_ = std::make_shared<const CatalogSnapshot>(path, /*verify_checksum*/ false);
+  rewrite();
+  return base_->size();
+}
+
+void BookingJournal::rewrite() {
+  std::lock_guard<std::mutex> ids_lk(ids_mu_);
+  journal_->rewrite([this](const Journal::RecordVisitor& emit) {
+    if (base_) {
+      RecordWriter w(RecordType::kBase);
+      w.u32(base_->checksum());
+      w.u64(base_->size());
+      emit(w.bytes());
+    }
+    // Every flight the base does not hold as it is, including ones that never went through the journal (e.g.
+    // loaded from a catalog snapshot before the journal was opened): their later bookings are in the journal and
+    // must survive the rewrite.
+    flights_->visit_all([&](const Flight& flight) {
+      if (!base_ || !base_->holds(flight)) emit(upsert_record(flight).bytes());
+    });
+    for (const auto id : flight_ids_) {
+      const auto manifest = reservations_->list_by_flight(FlightId{id});
+      if (!manifest.empty()) emit(reservations_record(manifest).bytes());
+    }
+  });
+}
+
+JournaledFlightRepository::JournaledFlightRepository(std::shared_ptr<BookingJournal> journal)
+    : journal_(std::move(journal)), inner_(*journal_->flights_) {}
+
+std::optional<Flight> JournaledFlightRepository::get(FlightId id) const {
+  journal_->check();
+  return inner_.get(id);
+}
+
+std::vector<Flight> JournaledFlightRepository::search(const flight::application::FlightSearchCriteria& criteria) const {
+  journal_->check();
+  return inner_.search(criteria);
+}
+
+bool JournaledFlightRepository::visit(FlightId id, const flight::application::FlightVisitor& visitor) const {
+  journal_->check();
+  return inner_.visit(id, visitor);
+}
+
+void JournaledFlightRepository::visit_matches(const flight::application::FlightSearchCriteria& criteria,
+                                              const flight::application::FlightVisitor& visitor) const {
+  journal_->check();
+  inner_.visit_matches(criteria, visitor);
+}
+
+void JournaledFlightRepository::visit_all(const flight::application::FlightVisitor& visitor) const {
+  journal_->check();
+  inner_.visit_all(visitor);
+}
+
+std::vector<flight::application::FlightSummary> JournaledFlightRepository::search_summaries(
+    const flight::application::FlightSearchCriteria& criteria) const {
+  journal_->check();
+  return inner_.search_summaries(criteria);
+}
+
+std::pmr::vector<Flight> JournaledFlightRepository::search_in(const flight::application::FlightSearchCriteria& criteria,
+                                                             std::pmr::memory_resource* mr) const {
+  journal_->check();
+  return inner_.search_in(criteria, mr);
+}
+
+std::pmr::vector<flight::application::FlightSummary> JournaledFlightRepository::search_summaries_in(
+    const flight::application::FlightSearchCriteria& criteria, std::pmr::memory_resource* mr) const {
+  journal_->check();
+  return inner_.search_summaries_in(criteria, mr);
+}
+
+void JournaledFlightRepository::upsert(Flight flight) {
+  const auto id = flight.id();
+  journal_->change(id, [&](const auto& emit) {
+    emit(upsert_record(flight));
+    inner_.upsert(std::move(flight));
+    return true;
+  });
+}
+
+void JournaledFlightRepository::upsert_many(std::vector<Flight> flights) {
+  if (flights.empty()) return;
+  journal_->change_all([&](const auto& emit) {
+    emit(upsert_many_record(flights));
+    inner_.upsert_many(std::move(flights));
+  });
+}
+
+bool JournaledFlightRepository::try_book_seat(FlightId flight_id, const Seat& seat) {
+  return journal_->change(flight_id, [&](const auto& emit) {
+    if (!inner_.try_book_seat(flight_id, seat)) return false;
+    emit(book_record(flight_id, std::span<const Seat>(&seat, 1)), std::span<const Seat>(&seat, 1));
+    return true;
+  });
+}
+
+std::vector<bool> JournaledFlightRepository::try_book_seat_batch(
+    std::span<const flight::application::SeatBookingRequest> requests) {
+  // The batch is one change group (or part of the caller's, e.g. BookingService::book_seat_batch() adding the
+  // reservations), so a crash keeps all of its bookings or none, and it waits for one sync.
+  std::optional<flight::application::ChangeGroup> group;
+  if (!journal_->in_group()) {
+    std::vector<FlightId> flight_ids;
+    flight_ids.reserve(requests.size());
+    for (const auto& r : requests) flight_ids.push_back(r.flight_id);
+    group.emplace(journal_.get(), flight_ids);
+  }
+  std::vector<bool> results;
+  results.reserve(requests.size());
+  for (const auto& r : requests) {
+    results.push_back(journal_->change(r.flight_id, [&](const auto& emit) {
+      if (!inner_.try_book_seat(r.flight_id, r.seat)) return false;
+      emit(book_record(r.flight_id, std::span<const Seat>(&r.seat, 1)), std::span<const Seat>(&r.seat, 1));
+      return true;
+    }));
+  }
+  if (group) group->commit();
+  return results;
+}
+
+bool JournaledFlightRepository::try_book_seats(FlightId flight_id, std::span<const Seat> seats) {
+  return journal_->change(flight_id, [&](const auto& emit) {
+    if (!inner_.try_book_seats(flight_id, seats)) return false;
+    emit(book_record(flight_id, seats), seats);
+    return true;
+  });
+}
+
+void JournaledFlightRepository::release_seat(FlightId flight_id, const Seat& seat) {
+  journal_->change(flight_id, [&](const auto& emit) {
+    emit(release_record(flight_id, seat));
+    inner_.release_seat(flight_id, seat);
+    return true;
+  });
+}
+
+std::optional<std::uint32_t> JournaledFlightRepository::available_count(FlightId flight_id) const {
+  journal_->check();
+  return inner_.available_count(flight_id);
+}
+
+std::vector<Seat> JournaledFlightRepository::first_free_seats(FlightId flight_id, std::size_t n) const {
+  journal_->check();
+  return inner_.first_free_seats(flight_id, n);
+}
+
+std::optional<Seat> JournaledFlightRepository::book_any_seat(FlightId flight_id) {
+  return journal_->change(flight_id, [&](const auto& emit) {
+    auto seat = inner_.book_any_seat(flight_id);
+    if (seat) emit(book_record(flight_id, std::span<const Seat>(&*seat, 1)), std::span<const Seat>(&*seat, 1));
+    return seat;
+  });
+}
+
+std::vector<Seat> JournaledFlightRepository::book_adjacent_seats(FlightId flight_id, std::size_t n) {
+  return journal_->change(flight_id, [&](const auto& emit) {
+    auto seats = inner_.book_adjacent_seats(flight_id, n);
+    if (!seats.empty()) emit(book_record(flight_id, seats), seats);
+    return seats;
+  });
+}
+
+JournaledReservationRepository::JournaledReservationRepository(std::shared_ptr<BookingJournal> journal)
+    : journal_(std::move(journal)), inner_(*journal_->reservations_) {}
+
+void JournaledReservationRepository::add(Reservation reservation) {
+  journal_->change(std::nullopt, [&](const auto& emit) {
+    emit(reservations_record(std::span<const Reservation>(&reservation, 1)));
+    journal_->remember_flight(reservation.flight_id());
+    inner_.add(std::move(reservation));
+    return true;
+  });
+}
+
+void JournaledReservationRepository::add_many(std::vector<Reservation> reservations) {
+  if (reservations.empty()) return;
+  journal_->change(std::nullopt, [&](const auto& emit) {
+    emit(reservations_record(reservations));
+    for (const auto& r : reservations) journal_->remember_flight(r.flight_id());
+    inner_.add_many(std::move(reservations));
+    return true;
+  });
+}
+
+std::optional<Reservation> JournaledReservationRepository::get(ReservationId id) const {
+  journal_->check();
+  return inner_.get(id);
+}
+
+std::vector<Reservation> JournaledReservationRepository::list_by_order(OrderId order_id) const {
+  journal_->check();
+  return inner_.list_by_order(order_id);
+}
+
+std::vector<Reservation> JournaledReservationRepository::list_by_flight(FlightId flight_id) const {
+  journal_->check();
+  return inner_.list_by_flight(flight_id);
+}
+
+JournaledRepositories make_journaled_repositories(
+    std::unique_ptr<flight::application::IFlightRepository> flights,
+    std::unique_ptr<flight::application::IReservationRepository> reservations, const JournalOptions& options) {
+  auto journal = std::make_shared<BookingJournal>(std::move(flights), std::move(reservations), options);
+  JournaledRepositories out;
+  out.flights = std::make_unique<JournaledFlightRepository>(journal);
+  out.reservations = std::make_unique<JournaledReservationRepository>(journal);
+  out.journal = std::move(journal);
+  return out;
+}
+
+} // namespace flight::infrastructure
@@ -0,0 +1,338 @@
+#include "flight/infrastructure/lock_free_flight_repository.hpp"
+
+#include "flight/util/metered_lock.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace flight::infrastructure {
+
+namespace {
+
+using WriterLock = flight::util::MeteredUniqueLock<std::mutex>;
+
+// Plans book_adjacent_seats() claims before giving up on a contended flight.
+constexpr int kMaxAdjacentClaimAttempts = 8;
+
+struct LockMetrics {
+  flight::util::LockMetrics catalog_writer = flight::util::LockMetrics::named("lock_free_flights.catalog", "writer");
+};
+
+const LockMetrics& locks() {
+  static const LockMetrics metrics;
+  return metrics;
+}
+
+} // namespace
+
+LockFreeFlightRepository::Entry::Entry(const flight::domain::Flight& f)
+    : flight(f.id(), f.origin(), f.destination(), f.departure(), f.rows(), f.seats_per_row()),
+      word_count(f.seat_map().words().size()),
+      seats(std::make_unique<std::atomic<std::uint64_t>[]>(word_count)) {
+  const auto words = f.seat_map().words();
+  for (std::size_t i = 0; i < word_count; ++i) {
+    seats[i].store(words[i], std::memory_order_relaxed);
+  }
+}
+
+flight::domain::Flight LockFreeFlightRepository::Entry::snapshot(flight::domain::Flight::allocator_type alloc) const {
+  flight::domain::SeatMap booked(flight.rows(), flight.seats_per_row(), alloc);
+  for (std::size_t i = 0; i < word_count; ++i) {
+    booked.assign_word(i, seats[i].load(std::memory_order_acquire));
+  }
+  return flight::domain::Flight(flight.id(), flight.origin(), flight.destination(), flight.departure(),
+                                flight.rows(), flight.seats_per_row(), std::move(booked));
+}
+
+std::uint32_t LockFreeFlightRepository::Entry::booked_count() const noexcept {
+  std::uint32_t n = 0;
+  for (std::size_t i = 0; i < word_count; ++i) {
+    n += static_cast<std::uint32_t>(std::popcount(seats[i].load(std::memory_order_relaxed)));
+  }
+  return n;
+}
+
+LockFreeFlightRepository::~LockFreeFlightRepository() {
+  flights_.for_each([](const Entry& e) { delete &e; });
+}
+
+std::optional<flight::domain::Flight> LockFreeFlightRepository::get(flight::domain::FlightId id) const {
+  flight::util::EpochGuard pin;
+  const auto* e = find(id);
+  if (!e) return std::nullopt;
+  return e->snapshot();
+}
+
+std::vector<flight::domain::Flight> LockFreeFlightRepository::search(
+    const flight::application::FlightSearchCriteria& criteria) const {
+  flight::util::EpochGuard pin;
+  const auto ids = routes_.find(criteria);
+  std::vector<flight::domain::Flight> out;
+  if (ids.empty()) return out;
+  out.reserve(RouteIndex::max_results(ids, criteria));
+  for (const auto& entry : ids) {
+    if (RouteIndex::limit_reached(out.size(), criteria)) break;
+    const auto* e = find(flight::domain::FlightId{entry.id});
+    if (RouteIndex::matches(entry, e->flight, criteria)) out.push_back(e->snapshot());
+  }
+  return out;
+}
+
+// Seat state lives in atomics rather than in a Flight, so visitors get a freshly built snapshot.
+bool LockFreeFlightRepository::visit(flight::domain::FlightId id,
+                                     const flight::application::FlightVisitor& visitor) const {
+  flight::util::EpochGuard pin;
+  const auto* e = find(id);
+  if (!e) return false;
+  visitor(e->snapshot());
+  return true;
+}
+
+void LockFreeFlightRepository::visit_matches(const flight::application::FlightSearchCriteria& criteria,
+                                             const flight::application::FlightVisitor& visitor) const {
+  flight::util::EpochGuard pin;
+  std::size_t matched = 0;
+  for (const auto& entry : routes_.find(criteria)) {
+    if (RouteIndex::limit_reached(matched, criteria)) break;
+    const auto* e = find(flight::domain::FlightId{entry.id});
+    if (!RouteIndex::matches(entry, e->flight, criteria)) continue;
+    visitor(e->snapshot());
+    ++matched;
+  }
+}
+
+void LockFreeFlightRepository::visit_all(const flight::application::FlightVisitor& visitor) const {
+  flight::util::EpochGuard pin;
+  flights_.for_each([&](const Entry& e) { visitor(e.snapshot()); });
+}
+
+template <typename Vector>
+void LockFreeFlightRepository::collect_summaries(const flight::application::FlightSearchCriteria& criteria,
+                                                 Vector& out) const {
+  flight::util::EpochGuard pin;
+  const auto ids = routes_.find(criteria);
+  out.reserve(RouteIndex::max_results(ids, criteria));
+  for (const auto& entry : ids) {
+    if (RouteIndex::limit_reached(out.size(), criteria)) break;
+    const auto* e = find(flight::domain::FlightId{entry.id});
+    const auto& f = e->flight;
+    if (!RouteIndex::matches(entry, f, criteria)) continue;
+    out.push_back(flight::application::FlightSummary{f.id(), f.origin(), f.destination(), f.departure(),
+                                                     f.capacity(), f.capacity() - e->booked_count()});
+  }
+}
+
+std::vector<flight::application::FlightSummary> LockFreeFlightRepository::search_summaries(
+    const flight::application::FlightSearchCriteria& criteria) const {
+  std::vector<flight::application::FlightSummary> out;
+  collect_summaries(criteria, out);
+  return out;
+}
+
+std::pmr::vector<flight::domain::Flight> LockFreeFlightRepository::search_in(
+    const flight::application::FlightSearchCriteria& criteria, std::pmr::memory_resource* mr) const {
+  flight::util::EpochGuard pin;
+  const auto ids = routes_.find(criteria);
+  std::pmr::vector<flight::domain::Flight> out(mr);
+  out.reserve(RouteIndex::max_results(ids, criteria));
+  // Snapshots are built straight into the arena; the push_back moves them without copying the seat words.
+  for (const auto& entry : ids) {
+    if (RouteIndex::limit_reached(out.size(), criteria)) break;
+    const auto* e = find(flight::domain::FlightId{entry.id});
+    if (RouteIndex::matches(entry, e->flight, criteria)) out.push_back(e->snapshot(mr));
+  }
+  return out;
+}
+
+std::pmr::vector<flight::application::FlightSummary> LockFreeFlightRepository::search_summaries_in(
+    const flight::application::FlightSearchCriteria& criteria, std::pmr::memory_resource* mr) const {
+  std::pmr::vector<flight::application::FlightSummary> out(mr);
+  collect_summaries(criteria, out);
+  return out;
+}
+
+bool LockFreeFlightRepository::replace(std::unique_ptr<Entry> entry) {
+  const auto& flight = entry->flight;
+  const auto* old = find(flight.id());
+  // A move to another route or departure: see RouteIndex::matches().
+  const bool moved = old && !RouteIndex::same_key(old->flight, flight);
+  if (moved) routes_.insert(flight);
+  flights_.exchange(flight.id().value(), entry.release());
+  if (!old) return false;
+  if (moved) routes_.erase(old->flight);
+  retired_.retire(const_cast<Entry*>(old), [](void* e, void*) { delete static_cast<Entry*>(e); }, nullptr);
+  return true;
+}
+
+void LockFreeFlightRepository::upsert(flight::domain::Flight flight) {
+  auto entry = std::make_unique<Entry>(flight);
+  WriterLock lk(write_mu_, locks().catalog_writer);
+  flight::util::EpochGuard pin;
+  if (!replace(std::move(entry))) routes_.insert(flight);
+}
+
+void LockFreeFlightRepository::upsert_many(std::vector<flight::domain::Flight> flights) {
+  if (flights.empty()) return;
+  // Seat arrays are built before taking the lock, so the writer only swaps pointers.
+  std::vector<std::unique_ptr<Entry>> entries;
+  entries.reserve(flights.size());
+  for (const auto& flight : flights) entries.push_back(std::make_unique<Entry>(flight));
+  WriterLock lk(write_mu_, locks().catalog_writer);
+  flight::util::EpochGuard pin;
+  flights_.reserve(flights_.size() + entries.size());
+  std::vector<flight::domain::FlightId> added;
+  for (auto& entry : entries) {
+    const auto id = entry->flight.id();
+    // A flight added earlier in this batch is replaced like any other; it is only indexed below.
+    if (!replace(std::move(entry))) added.push_back(id);
+  }
+  std::vector<const flight::domain::Flight*> indexed;
+  indexed.reserve(added.size());
+  for (const auto id : added) indexed.push_back(&find(id)->flight);
+  routes_.insert_many(indexed);
+}
+
+bool LockFreeFlightRepository::claim(const Entry* e, const flight::domain::Seat& seat) {
+  if (!e || !e->flight.is_seat_valid(seat)) return false;
+  const auto index = e->flight.seat_map().index_of(seat);
+  const std::uint64_t bit = std::uint64_t{1} << (index % flight::domain::SeatMap::kWordBits);
+  // Exactly one fetch_or can observe the bit clear, so exactly one booker wins.
+  const auto prev = e->seats[index / flight::domain::SeatMap::kWordBits].fetch_or(bit, std::memory_order_acq_rel);
+  return (prev & bit) == 0;
+}
+
+bool LockFreeFlightRepository::try_book_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) {
+  flight::util::EpochGuard pin;
+  return claim(find(flight_id), seat);
+}
+
+std::vector<bool> LockFreeFlightRepository::try_book_seat_batch(
+    std::span<const flight::application::SeatBookingRequest> requests) {
+  std::vector<bool> results;
+  results.reserve(requests.size());
+  flight::util::EpochGuard pin;
+  for (const auto& r : requests) results.push_back(claim(find(r.flight_id), r.seat));
+  return results;
+}
+
+bool LockFreeFlightRepository::try_book_seats(flight::domain::FlightId flight_id,
+                                              std::span<const flight::domain::Seat> seats) {
+  flight::util::EpochGuard pin;
+  return claim_all(find(flight_id), seats);
+}
+
+bool LockFreeFlightRepository::claim_all(const Entry* e, std::span<const flight::domain::Seat> seats) {
+  constexpr auto kWordBits = flight::domain::SeatMap::kWordBits;
+  if (!e || seats.empty()) return false;
+
+  // Collapse the group into one mask per touched word.
+  std::vector<std::pair<std::size_t, std::uint64_t>> masks;
+  for (const auto& seat : seats) {
+    if (!e->flight.is_seat_valid(seat)) return false;
+    const auto index = e->flight.seat_map().index_of(seat);
+    const auto word = index / kWordBits;
+    const std::uint64_t bit = std::uint64_t{1} << (index % kWordBits);
+    auto m = std::find_if(masks.begin(), masks.end(), [word](const auto& p) { return p.first == word; });
+    if (m == masks.end()) {
+      masks.emplace_back(word, bit);
+    } else if (m->second & bit) {
+      return false; // repeated seat
+    } else {
+      m->second |= bit;
+    }
+  }
+
+  // Claim word by word with CAS; on conflict undo the words already claimed. A concurrent reader may
+  // briefly observe the partial claim, but the group is booked all-or-nothing.
+  for (std::size_t i = 0; i < masks.size(); ++i) {
+    auto& word = e->seats[masks[i].first];
+    const auto mask = masks[i].second;
+    auto current = word.load(std::memory_order_relaxed);
+    do {
+      if (current & mask) {
+        for (std::size_t j = 0; j < i; ++j) {
+          e->seats[masks[j].first].fetch_and(~masks[j].second, std::memory_order_acq_rel);
+        }
+        return false;
+      }
+    } while (!word.compare_exchange_weak(current, current | mask, std::memory_order_acq_rel,
+                                         std::memory_order_relaxed));
+  }
+  return true;
+}
+
+void LockFreeFlightRepository::release_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) {
+  flight::util::EpochGuard pin;
+  const auto* e = find(flight_id);
+  if (!e || !e->flight.is_seat_valid(seat)) return;
+  const auto index = e->flight.seat_map().index_of(seat);
+  const std::uint64_t bit = std::uint64_t{1} << (index % flight::domain::SeatMap::kWordBits);
+  e->seats[index / flight::domain::SeatMap::kWordBits].fetch_and(~bit, std::memory_order_acq_rel);
+}
+
+std::optional<std::uint32_t> LockFreeFlightRepository::available_count(flight::domain::FlightId flight_id) const {
+  flight::util::EpochGuard pin;
+  const auto* e = find(flight_id);
+  if (!e) return std::nullopt;
+  return e->flight.capacity() - e->booked_count();
+}
+
+std::vector<flight::domain::Seat> LockFreeFlightRepository::first_free_seats(flight::domain::FlightId flight_id,
+                                                                             std::size_t n) const {
+  constexpr auto kWordBits = flight::domain::SeatMap::kWordBits;
+  flight::util::EpochGuard pin;
+  const auto* e = find(flight_id);
+  std::vector<flight::domain::Seat> out;
+  if (!e) return out;
+  const auto& layout = e->flight.seat_map();
+  for (std::size_t i = 0; i < e->word_count && out.size() < n; ++i) {
+    auto free = ~e->seats[i].load(std::memory_order_acquire) &
+                flight::domain::SeatMap::valid_bits(layout.capacity(), i);
+    while (free != 0 && out.size() < n) {
+      out.push_back(layout.seat_at(i * kWordBits + static_cast<std::size_t>(std::countr_zero(free))));
+      free &= free - 1;
+    }
+  }
+  return out;
+}
+
+std::optional<flight::domain::Seat> LockFreeFlightRepository::book_any_seat(flight::domain::FlightId flight_id) {
+  constexpr auto kWordBits = flight::domain::SeatMap::kWordBits;
+  flight::util::EpochGuard pin;
+  const auto* e = find(flight_id);
+  if (!e) return std::nullopt;
+  const auto& layout = e->flight.seat_map();
+  for (std::size_t i = 0; i < e->word_count; ++i) {
+    const auto valid = flight::domain::SeatMap::valid_bits(layout.capacity(), i);
+    auto current = e->seats[i].load(std::memory_order_relaxed);
+    // Claim the lowest free bit of this word; retry the same word if another booker got there first.
+    while (const auto free = ~current & valid) {
+      const auto bit = free & (~free + 1);
+      if (e->seats[i].compare_exchange_weak(current, current | bit, std::memory_order_acq_rel,
+                                            std::memory_order_relaxed)) {
+        return layout.seat_at(i * kWordBits + static_cast<std::size_t>(std::countr_zero(bit)));
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+std::vector<flight::domain::Seat> LockFreeFlightRepository::book_adjacent_seats(flight::domain::FlightId flight_id,
+                                                                                std::size_t n) {
+  flight::util::EpochGuard pin;
+  const auto* e = find(flight_id);
+  if (!e) return {};
+  // Plan on a snapshot of the seat words, then claim the plan all-or-nothing. A failed claim means another
+  // booker took one of the seats; re-plan against the new state, but only so often: under a booking storm on
+  // the same seats the caller gets a failure it can retry instead of a thread spinning here.
+  for (int attempt = 0; attempt < kMaxAdjacentClaimAttempts; ++attempt) {
+    auto seats = e->snapshot().book_adjacent_seats(n);
+    if (seats.empty() || claim_all(e, seats)) return seats;
+  }
+  return {};
+}
+
+} // namespace flight::infrastructure
@@ -0,0 +1,83 @@
+#include "flight/infrastructure/route_index.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+
+namespace flight::infrastructure {
+
+RouteIndex::~RouteIndex() {
+  routes_.for_each([](const List& list) { delete &list; });
+}
+
+void RouteIndex::publish(RouteKey route, List list) {
+  const List* old = routes_.exchange(route, new List(std::move(list)));
+  if (old) retired_.retire(const_cast<List*>(old), [](void* p, void*) { delete static_cast<List*>(p); }, nullptr);
+}
+
+void RouteIndex::insert(const flight::domain::Flight& flight) {
+  const auto route = key_of(flight);
+  const List* current = routes_.find(route);
+  List entries = current ? *current : List{};
+  const Entry entry{flight.departure(), flight.id().value()};
+  // Schedules are usually loaded in departure order, so this is normally an append.
+  if (entries.empty() || entries.back() < entry) {
+    entries.push_back(entry);
+  } else {
+    auto it = std::lower_bound(entries.begin(), entries.end(), entry);
+    if (it != entries.end() && *it == entry) return;
+    entries.insert(it, entry);
+  }
+  publish(route, std::move(entries));
+}
+
+void RouteIndex::insert_many(std::span<const flight::domain::Flight* const> flights) {
+  // One copy and one publish per touched route, however many of the batch's flights it gets.
+  std::unordered_map<RouteKey, List> added;
+  for (const auto* flight : flights) {
+    added[key_of(*flight)].push_back(Entry{flight->departure(), flight->id().value()});
+  }
+  for (auto& [route, fresh] : added) {
+    std::sort(fresh.begin(), fresh.end());
+    const List* current = routes_.find(route);
+    List entries;
+    entries.reserve((current ? current->size() : 0) + fresh.size());
+    if (current) {
+      std::merge(current->begin(), current->end(), fresh.begin(), fresh.end(), std::back_inserter(entries));
+    } else {
+      entries = std::move(fresh);
+    }
+    entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+    publish(route, std::move(entries));
+  }
+}
+
+void RouteIndex::erase(const flight::domain::Flight& flight) {
+  const auto route = key_of(flight);
+  const List* current = routes_.find(route);
+  if (!current) return;
+  const Entry entry{flight.departure(), flight.id().value()};
+  auto it = std::lower_bound(current->begin(), current->end(), entry);
+  if (it == current->end() || *it != entry) return;
+  List entries;
+  entries.reserve(current->size() - 1);
+  entries.insert(entries.end(), current->begin(), it);
+  entries.insert(entries.end(), it + 1, current->end());
+  publish(route, std::move(entries));
+}
+
+std::span<const RouteIndex::Entry> RouteIndex::find(const flight::application::FlightSearchCriteria& criteria) const {
+  const List* list = routes_.find(key(criteria.origin, criteria.destination));
+  if (!list) return {};
+
+  const auto& entries = *list;
+  const auto by_departure = [](const Entry& e, flight::domain::Flight::time_point t) { return e.departure < t; };
+  auto first = entries.begin();
+  auto last = entries.end();
+  if (criteria.departure_from) first = std::lower_bound(first, last, *criteria.departure_from, by_departure);
+  if (criteria.departure_to) last = std::lower_bound(first, last, *criteria.departure_to, by_departure);
+  return {first, last};
+}
+
+} // namespace flight::infrastructure
@@ -0,0 +1,303 @@
+#include "flight/infrastructure/schedule_import.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace flight::infrastructure {
+
+namespace {
+
+constexpr std::size_t kFields = 6;
+
+std::string_view trim(std::string_view s) {
+  while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+  while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+  return s;
+}
+
+template <typename T>
+T parse_number(std::string_view field, const char* name) {
+  T value{};
+  const auto* end = field.data() + field.size();
+  const auto [ptr, ec] = std::from_chars(field.data(), end, value);
+  if (field.empty() || ec != std::errc{} || ptr != end) {
+    throw std::invalid_argument(std::string(name) + ": '" + std::string(field) + "' is not a valid number");
+  }
+  return value;
+}
+
+// Fixed-width digits at text[pos, pos + width).
+int digits(std::string_view text, std::size_t pos, std::size_t width) {
+  int value = 0;
+  for (std::size_t i = pos; i < pos + width; ++i) {
+    if (text[i] < '0' || text[i] > '9') throw std::invalid_argument("departure: expected a digit");
+    value = value * 10 + (text[i] - '0');
+  }
+  return value;
+}
+
+flight::domain::Flight::time_point parse_departure(std::string_view text) {
+  using namespace std::chrono;
+  if (!text.empty() && std::all_of(text.begin(), text.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+    return flight::domain::Flight::time_point(seconds(parse_number<std::int64_t>(text, "departure")));
+  }
+  if (!text.empty() && text.back() == 'Z') text.remove_suffix(1);
+  // YYYY-MM-DDTHH:MM, optionally followed by :SS.
+  if ((text.size() != 16 && text.size() != 19) || text[4] != '-' || text[7] != '-' ||
+      (text[10] != 'T' && text[10] != ' ') || text[13] != ':' || (text.size() == 19 && text[16] != ':')) {
+    throw std::invalid_argument("departure: '" + std::string(text) + "' is not YYYY-MM-DDTHH:MM[:SS]Z");
+  }
+  const year_month_day date{year{digits(text, 0, 4)}, month{static_cast<unsigned>(digits(text, 5, 2))},
+                            day{static_cast<unsigned>(digits(text, 8, 2))}};
+  const int h = digits(text, 11, 2);
+  const int m = digits(text, 14, 2);
+  const int s = text.size() == 19 ? digits(text, 17, 2) : 0;
+  if (!date.ok() || h > 23 || m > 59 || s > 59) {
+    throw std::invalid_argument("departure: '" + std::string(text) + "' is not a valid date and time");
+  }
+  return flight::domain::Flight::time_point(sys_days(date) + hours(h) + minutes(m) + seconds(s));
+}
+
+struct Chunk {
+  std::size_t seq{0};
+  std::size_t first_line{0};
+  std::string text;
+};
+
+struct ParsedChunk {
+  std::vector<flight::domain::Flight> flights;
+  std::vector<ScheduleImportError> errors;
+  std::size_t rows{0};
+  std::size_t malformed{0};
+};
+
+ParsedChunk parse_chunk(const Chunk& chunk, std::size_t max_errors) {
+  ParsedChunk out;
+  std::string_view text(chunk.text);
+  for (std::size_t line = chunk.first_line; !text.empty(); ++line) {
+    const auto eol = text.find('\n');
+    const auto row = trim(text.substr(0, eol));
+    text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+    if (row.empty() || (line == 1 && row.substr(0, 9) == "flight_id")) continue;
+
+    ++out.rows;
+    try {
+      out.flights.push_back(parse_schedule_row(row));
+    } catch (const std::invalid_argument& e) {
+      ++out.malformed;
+      if (out.errors.size() < max_errors) out.errors.push_back(ScheduleImportError{line, e.what()});
+    }
+  }
+  return out;
+}
+
+// Reader -> parsers -> applier. Chunks are numbered as they are read and applied strictly in that order; the
+// reader stalls while `in_flight_` chunks (read but not yet applied) reach the limit.
+class ImportPipeline final {
+public:
+  ImportPipeline(std::istream& in, const ScheduleImportOptions& options, std::size_t parsers)
+      : in_(in), chunk_bytes_(std::max<std::size_t>(options.chunk_bytes, 1)), max_errors_(options.max_errors),
+        max_in_flight_(2 * parsers + 2) {
+    reader_ = std::thread([this] { guard([this] { read(); }); });
+    for (std::size_t i = 0; i < parsers; ++i) parsers_.emplace_back([this] { guard([this] { parse(); }); });
+  }
+
+  ~ImportPipeline() {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    reader_.join();
+    for (auto& t : parsers_) t.join();
+  }
+
+  ImportPipeline(const ImportPipeline&) = delete;
+  ImportPipeline& operator=(const ImportPipeline&) = delete;
+
+  // The next chunk in file order; false once every chunk was returned. Rethrows a reader or parser failure.
+  bool next(ParsedChunk& out) {
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk, [this] { return error_ || done_.count(next_seq_) || (reader_done_ && next_seq_ == chunk_count_); });
+    if (error_) std::rethrow_exception(error_);
+    if (reader_done_ && next_seq_ == chunk_count_) return false;
+    auto it = done_.find(next_seq_++);
+    out = std::move(it->second);
+    done_.erase(it);
+    --in_flight_;
+    lk.unlock();
+    cv_.notify_all();
+    return true;
+  }
+
+private:
+  template <typename Fn>
+  void guard(Fn&& fn) {
+    try {
+      fn();
+    } catch (...) {
+      {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (!error_) error_ = std::current_exception();
+        stopping_ = true;
+      }
+      cv_.notify_all();
+    }
+  }
+
+  void read() {
+    std::string carry;
+    std::size_t line = 1;
+    std::size_t seq = 0;
+    bool eof = false;
+    while (!eof) {
+      std::string text = std::move(carry);
+      carry.clear();
+      const auto kept = text.size();
+      text.resize(kept + chunk_bytes_);
+      in_.read(text.data() + static_cast<std::ptrdiff_t>(kept), static_cast<std::streamsize>(chunk_bytes_));
+      text.resize(kept + static_cast<std::size_t>(in_.gcount()));
+      eof = !in_;
+      if (!eof) {
+        // Hand over whole lines only; the partial last line starts the next chunk.
+        const auto cut = text.rfind('\n');
+        if (cut == std::string::npos) {
+          carry = std::move(text); // a line longer than a chunk: keep reading
+          continue;
+        }
+        carry.assign(text, cut + 1);
+        text.resize(cut + 1);
+      }
+      if (text.empty()) break;
+
+      const auto lines = static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n'));
+      std::unique_lock<std::mutex> lk(mu_);
+      cv_.wait(lk, [this] { return stopping_ || in_flight_ < max_in_flight_; });
+      if (stopping_) return;
+      todo_.push_back(Chunk{seq++, line, std::move(text)});
+      ++in_flight_;
+      lk.unlock();
+      cv_.notify_all();
+      line += lines;
+    }
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      reader_done_ = true;
+      chunk_count_ = seq;
+    }
+    cv_.notify_all();
+  }
+
+  void parse() {
+    while (true) {
+      Chunk chunk;
+      {
+        std::unique_lock<std::mutex> lk(mu_);
+        cv_.wait(lk, [this] { return stopping_ || !todo_.empty() || reader_done_; });
+        if (stopping_ || todo_.empty()) return;
+        chunk = std::move(todo_.front());
+        todo_.pop_front();
+      }
+      auto parsed = parse_chunk(chunk, max_errors_);
+      {
+        std::lock_guard<std::mutex> lk(mu_);
+        done_.emplace(chunk.seq, std::move(parsed));
+      }
+      cv_.notify_all();
+    }
+  }
+
+  std::istream& in_;
+  const std::size_t chunk_bytes_;
+  const std::size_t max_errors_;
+  const std::size_t max_in_flight_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<Chunk> todo_;
+  std::map<std::size_t, ParsedChunk> done_; // parsed, waiting for their turn
+  std::size_t in_flight_{0};
+  std::size_t next_seq_{0};
+  std::size_t chunk_count_{0};
+  bool reader_done_{false};
+  bool stopping_{false};
+  std::exception_ptr error_;
+
+  std::thread reader_;
+  std::vector<std::thread> parsers_;
+};
+
+} // namespace
+
+flight::domain::Flight parse_schedule_row(std::string_view row) {
+  std::array<std::string_view, kFields> f{};
+  std::size_t n = 0;
+  while (true) {
+    const auto comma = row.find(',');
+    if (n == kFields) throw std::invalid_argument("expected 6 fields, got more");
+    f[n++] = trim(row.substr(0, comma));
+    if (comma == std::string_view::npos) break;
+    row.remove_prefix(comma + 1);
+  }
+  if (n != kFields) throw std::invalid_argument("expected 6 fields, got " + std::to_string(n));
+
+  const auto id = parse_number<flight::domain::FlightId::value_type>(f[0], "flight_id");
+  if (id == 0) throw std::invalid_argument("flight_id: must be > 0");
+  return flight::domain::Flight(flight::domain::FlightId{id}, flight::domain::AirportCode(f[1]),
+                                flight::domain::AirportCode(f[2]), parse_departure(f[3]),
+                                parse_number<std::uint16_t>(f[4], "rows"),
+                                parse_number<std::uint8_t>(f[5], "seats_per_row"));
+}
+
+ScheduleImportResult import_schedule(std::istream& in, flight::application::IFlightRepository& flights,
+                                     const ScheduleImportOptions& options) {
+  const auto start = std::chrono::steady_clock::now();
+  const auto parsers = options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+  const auto batch_size = std::max<std::size_t>(1, options.batch_size);
+
+  ScheduleImportResult result;
+  std::vector<flight::domain::Flight> batch;
+  batch.reserve(batch_size);
+  const auto flush = [&] {
+    if (batch.empty()) return;
+    result.imported += batch.size();
+    ++result.batches;
+    flights.upsert_many(std::move(batch));
+    batch.clear();
+    batch.reserve(batch_size);
+  };
+
+  {
+    ImportPipeline pipeline(in, options, parsers);
+    ParsedChunk chunk;
+    while (pipeline.next(chunk)) {
+      result.rows += chunk.rows;
+      result.malformed += chunk.malformed;
+      for (auto& e : chunk.errors) {
+        if (result.errors.size() == options.max_errors) break;
+        result.errors.push_back(std::move(e));
+      }
+      for (auto& flight : chunk.flights) {
+        result.max_flight_id = std::max(result.max_flight_id, flight.id().value());
+        batch.push_back(std::move(flight));
+        if (batch.size() == batch_size) flush();
+      }
+    }
+    flush();
+  }
+
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+} // namespace flight::infrastructure
@@ -0,0 +1,82 @@
+#include "flight/infrastructure/snowflake_id_generator.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace flight::infrastructure {
+
+namespace {
+
+constexpr unsigned kTimestampShift = SnowflakeIdGenerator::kNodeBits + SnowflakeIdGenerator::kSequenceBits;
+constexpr std::uint64_t kSequenceMask = (std::uint64_t{1} << SnowflakeIdGenerator::kSequenceBits) - 1;
+constexpr std::uint64_t kMaxTimestamp = (std::uint64_t{1} << SnowflakeIdGenerator::kTimestampBits) - 1;
+
+std::atomic<std::uint64_t> g_instances{0};
+
+// A thread's leased ids [next, end) of one sequence of the generator `owner`, all in millisecond `timestamp`.
+// One slot per sequence, as in AtomicIdGenerator: switching generators only costs the rest of the lease.
+struct Lease {
+  std::uint64_t owner{0};
+  std::uint64_t timestamp{0};
+  std::uint64_t next{0};
+  std::uint64_t end{0};
+};
+
+thread_local std::array<Lease, 3> t_leases{};
+
+} // namespace
+
+SnowflakeIdGenerator::SnowflakeIdGenerator(std::uint32_t node_id, const flight::application::IClock& clock)
+    : node_id_(node_id), clock_(clock), instance_(g_instances.fetch_add(1, std::memory_order_relaxed) + 1) {
+  if (node_id_ > kMaxNodeId) {
+    throw std::invalid_argument("SnowflakeIdGenerator: node id must be <= " + std::to_string(kMaxNodeId));
+  }
+}
+
+std::uint64_t SnowflakeIdGenerator::next(Sequence s) {
+  const auto since_epoch =
+      std::chrono::duration_cast<std::chrono::milliseconds>(clock_.now().time_since_epoch()) - kEpoch;
+  const std::uint64_t now = since_epoch.count() > 0 ? static_cast<std::uint64_t>(since_epoch.count()) : 0;
+
+  auto& lease = t_leases[s];
+  // Keep using the lease while the clock has not moved past its millisecond (or went backwards).
+  if (lease.owner == instance_ && lease.next != lease.end && now <= lease.timestamp) return lease.next++;
+
+  auto& last = last_[s].id;
+  std::uint64_t prev = last.load(std::memory_order_relaxed);
+  std::uint64_t ts = 0;
+  std::uint64_t first = 0;
+  std::uint64_t count = 0;
+  do {
+    const std::uint64_t prev_ts = prev >> kTimestampShift;
+    const std::uint64_t prev_seq = prev & kSequenceMask;
+    ts = now;
+    std::uint64_t seq = 0;
+    if (now <= prev_ts) {
+      // Same millisecond as the last lease, or the clock went backwards: continue from the last id.
+      ts = prev_ts;
+      seq = prev_seq + 1;
+      if (seq > kSequenceMask) {
+        ++ts;
+        seq = 0;
+      }
+    }
+    if (ts > kMaxTimestamp) throw std::overflow_error("SnowflakeIdGenerator: timestamp exceeds 41 bits");
+    count = std::min<std::uint64_t>(kLeaseSize, kSequenceMask + 1 - seq); // a lease never spans milliseconds
+    first = (ts << kTimestampShift) | (std::uint64_t{node_id_} << kSequenceBits) | seq;
+  } while (!last.compare_exchange_weak(prev, first + count - 1, std::memory_order_relaxed));
+
+  lease = Lease{instance_, ts, first + 1, first + count};
+  return first;
+}
+
+SnowflakeIdGenerator::Parts SnowflakeIdGenerator::decode(std::uint64_t id) {
+  const std::chrono::milliseconds ms{static_cast<std::int64_t>(id >> kTimestampShift)};
+  return Parts{std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                   kEpoch + ms)),
+               static_cast<std::uint32_t>((id >> kSequenceBits) & kMaxNodeId),
+               static_cast<std::uint32_t>(id & kSequenceMask)};
+}
+
+} // namespace flight::infrastructure
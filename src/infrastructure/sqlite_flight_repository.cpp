@@ -3,13 +3,20 @@
 #include "flight/domain/airport_code.hpp"
 #include "flight/domain/flight.hpp"
 #include "flight/domain/seat.hpp"
+#include "flight/util/metered_lock.hpp"
 
 #include <sqlite3.h>
 
+#include <array>
 #include <chrono>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace flight::infrastructure {
@@ -19,6 +26,11 @@ static void ok(int rc, sqlite3* db, const char* ctx) {
   throw std::runtime_error(std::string(ctx) + ": " + sqlite3_errmsg(db));
 }
 
+static std::string_view column_view(sqlite3_stmt* st, int col) {
+  const auto* text = reinterpret_cast<const char*>(sqlite3_column_text(st, col));
+  return text ? std::string_view(text, static_cast<std::size_t>(sqlite3_column_bytes(st, col))) : std::string_view{};
+}
+
 static std::int64_t to_epoch_seconds(flight::domain::Flight::time_point tp) {
   return std::chrono::duration_cast<std::chrono::seconds>(tp.time_since_epoch()).count();
 }
@@ -27,22 +39,131 @@ static flight::domain::Flight::time_point from_epoch_seconds(std::int64_t s) {
   return flight::domain::Flight::time_point{std::chrono::seconds{s}};
 }
 
-SqliteFlightRepository::SqliteFlightRepository(bool in_memory) {
-  const char* name = in_memory ? ":memory:" : "flight_booking.db";
-  ok(sqlite3_open(name, &db_), db_, "sqlite3_open");
-  sqlite3_exec(db_, "PRAGMA foreign_keys=ON;", nullptr, nullptr, nullptr);
-  prepare_schema();
+using WriterLock = flight::util::MeteredUniqueLock<std::mutex>;
+
+// Writer lock wait/hold (writes, and reads of a :memory: database) and time spent waiting for a pooled reader.
+struct SqliteMetrics {
+  flight::util::LockMetrics writer = flight::util::LockMetrics::named("sqlite.writer", "exclusive");
+  flight::util::HistogramId reader_wait = flight::util::Metrics::global().histogram(
+      "flight_sqlite_reader_checkout_seconds", "", "Time spent checking out a pooled read connection.");
+};
+
+static const SqliteMetrics& sqlite_metrics() {
+  static const SqliteMetrics metrics;
+  return metrics;
 }
 
-SqliteFlightRepository::~SqliteFlightRepository() {
-  if (db_) sqlite3_close(db_);
+// One sqlite3 handle plus its statement cache. Used by one thread at a time (SQLITE_OPEN_NOMUTEX).
+struct SqliteFlightRepository::Connection {
+  Connection(const std::string& path, int flags, const SqliteOptions& options) {
+    if (sqlite3_open_v2(path.c_str(), &db, flags | SQLITE_OPEN_NOMUTEX, nullptr) != SQLITE_OK) {
+      const std::string msg = db ? sqlite3_errmsg(db) : "out of memory";
+      sqlite3_close(db);
+      throw std::runtime_error("sqlite3_open_v2: " + msg);
+    }
+    sqlite3_busy_timeout(db, options.busy_timeout_ms);
+    const auto mmap = "PRAGMA mmap_size=" + std::to_string(options.mmap_size) + ";";
+    sqlite3_exec(db, mmap.c_str(), nullptr, nullptr, nullptr);
+    statements = std::make_unique<SqliteStatementCache>(db);
+  }
+
+  ~Connection() {
+    statements.reset(); // statements must be finalized before the connection closes
+    sqlite3_close(db);
+  }
+
+  Connection(const Connection&) = delete;
+  Connection& operator=(const Connection&) = delete;
+
+  sqlite3* db{nullptr};
+  std::unique_ptr<SqliteStatementCache> statements;
+};
+
+// Checks out a reader connection for one query, or falls back to the writer (under mu_) when there is no
+// reader pool.
+class SqliteFlightRepository::ReadLease final {
+public:
+  explicit ReadLease(const SqliteFlightRepository& repo) : repo_(repo) {
+    if (!repo_.pooled_reads_) {
+      writer_lock_.emplace(repo_.mu_, sqlite_metrics().writer);
+      conn_ = repo_.writer_.get();
+      return;
+    }
+    const flight::util::ScopedTimer checkout(sqlite_metrics().reader_wait);
+    std::unique_lock<std::mutex> lk(repo_.readers_mu_);
+    repo_.readers_cv_.wait(lk, [this] { return !repo_.idle_readers_.empty(); });
+    reader_ = std::move(repo_.idle_readers_.back());
+    repo_.idle_readers_.pop_back();
+    conn_ = reader_.get();
+  }
+
+  ~ReadLease() {
+    if (!reader_) return;
+    {
+      std::lock_guard<std::mutex> lk(repo_.readers_mu_);
+      repo_.idle_readers_.push_back(std::move(reader_));
+    }
+    repo_.readers_cv_.notify_one();
+  }
+
+  ReadLease(const ReadLease&) = delete;
+  ReadLease& operator=(const ReadLease&) = delete;
+
+  Connection* operator->() const noexcept { return conn_; }
+
+private:
+  const SqliteFlightRepository& repo_;
+  std::optional<WriterLock> writer_lock_;
+  std::unique_ptr<Connection> reader_;
+  Connection* conn_{nullptr};
+};
+
+static SqliteOptions default_options(bool in_memory) {
+  SqliteOptions options;
+  if (!in_memory) options.path = "flight_booking.db";
+  return options;
 }
 
+static const char* synchronous_pragma(const std::string& mode) {
+  if (mode == "OFF") return "PRAGMA synchronous=OFF;";
+  if (mode == "NORMAL") return "PRAGMA synchronous=NORMAL;";
+  if (mode == "FULL") return "PRAGMA synchronous=FULL;";
+  if (mode == "EXTRA") return "PRAGMA synchronous=EXTRA;";
+  throw std::invalid_argument("Unknown SQLite synchronous mode: " + mode + " (use OFF|NORMAL|FULL|EXTRA)");
+}
+
+SqliteFlightRepository::SqliteFlightRepository(bool in_memory)
+    : SqliteFlightRepository(default_options(in_memory)) {}
+
+SqliteFlightRepository::SqliteFlightRepository(SqliteOptions options) : options_(std::move(options)) {
+  const bool in_memory = options_.path == ":memory:";
+  const char* synchronous = synchronous_pragma(options_.synchronous);
+
+  writer_ = std::make_unique<Connection>(options_.path, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, options_);
+  sqlite3_exec(writer_->db, "PRAGMA foreign_keys=ON;", nullptr, nullptr, nullptr);
+  if (!in_memory) {
+    // WAL lets the read-only connections read concurrently with the writer.
+    exec("PRAGMA journal_mode=WAL;");
+    exec(synchronous);
+  }
+  prepare_schema();
+
+  if (!in_memory) {
+    for (std::size_t i = 0; i < options_.reader_connections; ++i) {
+      idle_readers_.push_back(std::make_unique<Connection>(options_.path, SQLITE_OPEN_READONLY, options_));
+    }
+    pooled_reads_ = !idle_readers_.empty();
+  }
+}
+
+SqliteFlightRepository::~SqliteFlightRepository() = default;
+
 void SqliteFlightRepository::exec(const char* sql) const {
+  sqlite3* db = writer_->db;
   char* err = nullptr;
-  int rc = sqlite3_exec(db_, sql, nullptr, nullptr, &err);
+  int rc = sqlite3_exec(db, sql, nullptr, nullptr, &err);
   if (err) sqlite3_free(err);
-  ok(rc, db_, "sqlite3_exec");
+  ok(rc, db, "sqlite3_exec");
 }
 
 void SqliteFlightRepository::prepare_schema() {
@@ -66,183 +187,461 @@ void SqliteFlightRepository::prepare_schema() {
       FOREIGN KEY (flight_id) REFERENCES flights(flight_id) ON DELETE CASCADE
     );
   )sql");
-}
 
-void SqliteFlightRepository::upsert(flight::domain::Flight flight) {
-  std::lock_guard<std::mutex> lock(mu_);
+  // Route + departure window lookups for search; flight_id is implicitly appended, so
+  // ORDER BY departure_epoch, flight_id is served by the index without a sort.
+  exec(R"sql(
+    DROP INDEX IF EXISTS idx_flights_route;
+  )sql");
+  exec(R"sql(
+    CREATE INDEX IF NOT EXISTS idx_flights_route_departure ON flights(origin, destination, departure_epoch);
+  )sql");
+}
 
-  const char* sql =
-      "INSERT OR REPLACE INTO flights(flight_id, origin, destination, departure_epoch, rows, seats_per_row) "
-      "VALUES(?,?,?,?,?,?);";
+static constexpr const char* kUpsertFlightSql =
+    "INSERT OR REPLACE INTO flights(flight_id, origin, destination, departure_epoch, rows, seats_per_row) "
+    "VALUES(?,?,?,?,?,?);";
 
-  sqlite3_stmt* st = nullptr;
-  ok(sqlite3_prepare_v2(db_, sql, -1, &st, nullptr), db_, "prepare upsert flight");
+// Binds and steps the kUpsertFlightSql statement for one flight, leaving it reset for the next.
+static void step_upsert(sqlite3* db, sqlite3_stmt* st, const flight::domain::Flight& flight) {
+  const auto origin = flight.origin().chars();
+  const auto destination = flight.destination().chars();
 
   sqlite3_bind_int64(st, 1, static_cast<sqlite3_int64>(flight.id().value()));
-  sqlite3_bind_text(st, 2, flight.origin().value().c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_bind_text(st, 3, flight.destination().value().c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(st, 2, origin.data(), 3, SQLITE_STATIC);
+  sqlite3_bind_text(st, 3, destination.data(), 3, SQLITE_STATIC);
   sqlite3_bind_int64(st, 4, static_cast<sqlite3_int64>(to_epoch_seconds(flight.departure())));
   sqlite3_bind_int(st, 5, static_cast<int>(flight.rows()));
   sqlite3_bind_int(st, 6, static_cast<int>(flight.seats_per_row()));
 
-  ok(sqlite3_step(st), db_, "step upsert flight");
-  sqlite3_finalize(st);
+  ok(sqlite3_step(st), db, "step upsert flight");
+  sqlite3_reset(st);
+}
+
+void SqliteFlightRepository::upsert(flight::domain::Flight flight) {
+  WriterLock lock(mu_, sqlite_metrics().writer);
+  Connection* conn = writer_.get();
+
+  auto lease = conn->statements->acquire(kUpsertFlightSql);
+  step_upsert(conn->db, lease.get(), flight);
 
   // Important: v1 doesn't upsert booked seats, because Flight doesn't expose them.
   // Booked seats are persisted via try_book_seat(). get/search reconstruct by querying booked_seats.
 }
 
+// Columns shared by the flight+seat join queries below; one row per booked seat, or a single row with
+// NULL seat columns for a flight without bookings. Rows must be grouped by flight.
+#define FLIGHT_WITH_SEATS_SELECT                                                                 \
+  "SELECT f.flight_id, f.origin, f.destination, f.departure_epoch, f.rows, f.seats_per_row, "   \
+  "b.seat_row, b.seat_letter "
+
+// Flights matching the search criteria; binds: origin, destination, from, to, limit.
+#define FLIGHT_SEARCH_WHERE                                                                      \
+  "WHERE origin=? AND destination=? AND departure_epoch>=? AND departure_epoch<? "                \
+  "ORDER BY departure_epoch ASC, flight_id ASC LIMIT ?"
+
+// Binds FLIGHT_SEARCH_WHERE parameters; `origin`/`destination` must outlive the statement's execution.
+static void bind_search(sqlite3_stmt* st, const flight::application::FlightSearchCriteria& criteria,
+                        const std::array<char, 4>& origin, const std::array<char, 4>& destination) {
+  sqlite3_bind_text(st, 1, origin.data(), 3, SQLITE_STATIC);
+  sqlite3_bind_text(st, 2, destination.data(), 3, SQLITE_STATIC);
+  sqlite3_bind_int64(st, 3, criteria.departure_from ? to_epoch_seconds(*criteria.departure_from)
+                                                    : std::numeric_limits<sqlite3_int64>::min());
+  sqlite3_bind_int64(st, 4, criteria.departure_to ? to_epoch_seconds(*criteria.departure_to)
+                                                  : std::numeric_limits<sqlite3_int64>::max());
+  sqlite3_bind_int64(st, 5, criteria.limit == 0 ? -1 : static_cast<sqlite3_int64>(criteria.limit));
+}
+
+// Rebuilds flights from a FLIGHT_WITH_SEATS_SELECT statement in a single pass.
+static std::vector<flight::domain::Flight> read_flights_with_seats(sqlite3_stmt* st, sqlite3* db) {
+  std::vector<flight::domain::Flight> out;
+  int rc = SQLITE_ROW;
+  while ((rc = sqlite3_step(st)) == SQLITE_ROW) {
+    const auto id = flight::domain::FlightId{static_cast<std::uint64_t>(sqlite3_column_int64(st, 0))};
+    if (out.empty() || out.back().id() != id) {
+      out.emplace_back(id,
+                       flight::domain::AirportCode(column_view(st, 1)),
+                       flight::domain::AirportCode(column_view(st, 2)),
+                       from_epoch_seconds(sqlite3_column_int64(st, 3)),
+                       static_cast<std::uint16_t>(sqlite3_column_int(st, 4)),
+                       static_cast<std::uint8_t>(sqlite3_column_int(st, 5)));
+    }
+    if (sqlite3_column_type(st, 6) == SQLITE_NULL) continue;
+
+    const auto r = static_cast<std::uint16_t>(sqlite3_column_int(st, 6));
+    const auto letter = column_view(st, 7);
+    const char c = letter.empty() ? 'A' : letter[0];
+    out.back().book_seat(flight::domain::Seat{r, c});
+  }
+  ok(rc, db, "step load flights");
+  return out;
+}
+
 std::optional<flight::domain::Flight> SqliteFlightRepository::get(flight::domain::FlightId id) const {
-  std::lock_guard<std::mutex> lock(mu_);
+  ReadLease conn(*this);
 
-  const char* exists_sql =
-      "SELECT 1 FROM flights WHERE flight_id=?;";
+  auto lease = conn->statements->acquire(
+      FLIGHT_WITH_SEATS_SELECT
+      "FROM flights f LEFT JOIN booked_seats b ON b.flight_id = f.flight_id WHERE f.flight_id=?;");
+  sqlite3_bind_int64(lease.get(), 1, static_cast<sqlite3_int64>(id.value()));
 
-  sqlite3_stmt* st = nullptr;
-  ok(sqlite3_prepare_v2(db_, exists_sql, -1, &st, nullptr), db_, "prepare exists get");
-  sqlite3_bind_int64(st, 1, static_cast<sqlite3_int64>(id.value()));
+  auto flights = read_flights_with_seats(lease.get(), conn->db);
+  if (flights.empty()) return std::nullopt;
+  return std::move(flights.front());
+}
 
-  const int rc = sqlite3_step(st);
-  sqlite3_finalize(st);
+std::vector<flight::domain::Flight>
+SqliteFlightRepository::search(const flight::application::FlightSearchCriteria& criteria) const {
+  ReadLease conn(*this);
+
+  const auto origin = criteria.origin.chars();
+  const auto destination = criteria.destination.chars();
+
+  // The limit applies to flights, so it is taken in the subquery before joining seats.
+  auto lease = conn->statements->acquire(
+      FLIGHT_WITH_SEATS_SELECT
+      "FROM (SELECT * FROM flights " FLIGHT_SEARCH_WHERE ") f "
+      "LEFT JOIN booked_seats b ON b.flight_id = f.flight_id "
+      "ORDER BY f.departure_epoch ASC, f.flight_id ASC;");
+  bind_search(lease.get(), criteria, origin, destination);
+
+  return read_flights_with_seats(lease.get(), conn->db);
+}
 
-  if (rc != SQLITE_ROW) {
-    return std::nullopt;
+// Streams one flight at a time instead of materializing the whole catalog.
+void SqliteFlightRepository::visit_all(const flight::application::FlightVisitor& visitor) const {
+  ReadLease conn(*this);
+
+  auto lease = conn->statements->acquire(
+      FLIGHT_WITH_SEATS_SELECT
+      "FROM flights f LEFT JOIN booked_seats b ON b.flight_id = f.flight_id ORDER BY f.flight_id;");
+  sqlite3_stmt* st = lease.get();
+
+  std::optional<flight::domain::Flight> current;
+  int rc = SQLITE_ROW;
+  while ((rc = sqlite3_step(st)) == SQLITE_ROW) {
+    const auto id = flight::domain::FlightId{static_cast<std::uint64_t>(sqlite3_column_int64(st, 0))};
+    if (!current || current->id() != id) {
+      if (current) visitor(*current);
+      current.emplace(id,
+                      flight::domain::AirportCode(column_view(st, 1)),
+                      flight::domain::AirportCode(column_view(st, 2)),
+                      from_epoch_seconds(sqlite3_column_int64(st, 3)),
+                      static_cast<std::uint16_t>(sqlite3_column_int(st, 4)),
+                      static_cast<std::uint8_t>(sqlite3_column_int(st, 5)));
+    }
+    if (sqlite3_column_type(st, 6) == SQLITE_NULL) continue;
+
+    const auto r = static_cast<std::uint16_t>(sqlite3_column_int(st, 6));
+    const auto letter = column_view(st, 7);
+    current->book_seat(flight::domain::Seat{r, letter.empty() ? 'A' : letter[0]});
   }
+  ok(rc, conn->db, "step visit all flights");
+  if (current) visitor(*current);
+}
+
+#undef FLIGHT_WITH_SEATS_SELECT
 
-  return load_flight_by_id_locked(id);
+// Rows are materialized from SQL anyway, so visiting is a thin wrapper over the by-value reads.
+bool SqliteFlightRepository::visit(flight::domain::FlightId id,
+                                   const flight::application::FlightVisitor& visitor) const {
+  const auto flight = get(id);
+  if (!flight) return false;
+  visitor(*flight);
+  return true;
 }
 
-flight::domain::Flight
-SqliteFlightRepository::load_flight_by_id_locked(flight::domain::FlightId id) const {
-  const char* sql =
-      "SELECT origin, destination, departure_epoch, rows, seats_per_row "
-      "FROM flights WHERE flight_id=?;";
+void SqliteFlightRepository::visit_matches(const flight::application::FlightSearchCriteria& criteria,
+                                           const flight::application::FlightVisitor& visitor) const {
+  for (const auto& f : search(criteria)) visitor(f);
+}
 
-  sqlite3_stmt* st = nullptr;
-  ok(sqlite3_prepare_v2(db_, sql, -1, &st, nullptr), db_, "prepare load flight");
-  sqlite3_bind_int64(st, 1, static_cast<sqlite3_int64>(id.value()));
+template <typename Vector>
+void SqliteFlightRepository::collect_summaries(const flight::application::FlightSearchCriteria& criteria,
+                                               Vector& out) const {
+  ReadLease conn(*this);
 
-  const int rc = sqlite3_step(st);
-  if (rc != SQLITE_ROW) {
-    sqlite3_finalize(st);
-    throw std::runtime_error("Flight not found while loading by id");
+  const auto origin = criteria.origin.chars();
+  const auto destination = criteria.destination.chars();
+
+  // Booked seats are only counted, never loaded.
+  auto lease = conn->statements->acquire(
+      "SELECT f.flight_id, f.departure_epoch, f.rows, f.seats_per_row, "
+      "(SELECT COUNT(*) FROM booked_seats b WHERE b.flight_id = f.flight_id) "
+      "FROM flights f " FLIGHT_SEARCH_WHERE ";");
+  sqlite3_stmt* st = lease.get();
+  bind_search(st, criteria, origin, destination);
+
+  while (sqlite3_step(st) == SQLITE_ROW) {
+    const auto capacity = static_cast<std::uint32_t>(sqlite3_column_int(st, 2)) *
+                          static_cast<std::uint32_t>(sqlite3_column_int(st, 3));
+    const auto booked = static_cast<std::uint32_t>(sqlite3_column_int(st, 4));
+    out.push_back(flight::application::FlightSummary{
+        flight::domain::FlightId{static_cast<std::uint64_t>(sqlite3_column_int64(st, 0))},
+        criteria.origin,
+        criteria.destination,
+        from_epoch_seconds(sqlite3_column_int64(st, 1)),
+        capacity,
+        capacity - booked});
   }
+}
 
-  const std::string origin = reinterpret_cast<const char*>(sqlite3_column_text(st, 0));
-  const std::string dest   = reinterpret_cast<const char*>(sqlite3_column_text(st, 1));
-  const auto dep_epoch     = static_cast<std::int64_t>(sqlite3_column_int64(st, 2));
-  const auto rows          = static_cast<std::uint16_t>(sqlite3_column_int(st, 3));
-  const auto spr           = static_cast<std::uint8_t>(sqlite3_column_int(st, 4));
+std::vector<flight::application::FlightSummary>
+SqliteFlightRepository::search_summaries(const flight::application::FlightSearchCriteria& criteria) const {
+  std::vector<flight::application::FlightSummary> out;
+  collect_summaries(criteria, out);
+  return out;
+}
 
-  sqlite3_finalize(st);
+std::pmr::vector<flight::application::FlightSummary> SqliteFlightRepository::search_summaries_in(
+    const flight::application::FlightSearchCriteria& criteria, std::pmr::memory_resource* mr) const {
+  std::pmr::vector<flight::application::FlightSummary> out(mr);
+  collect_summaries(criteria, out);
+  return out;
+}
 
-  flight::domain::Flight flight{
-      id,
-      flight::domain::AirportCode(origin),
-      flight::domain::AirportCode(dest),
-      from_epoch_seconds(dep_epoch),
-      rows,
-      spr};
+#undef FLIGHT_SEARCH_WHERE
 
-  const char* sql2 =
-      "SELECT seat_row, seat_letter FROM booked_seats WHERE flight_id=?;";
+namespace {
 
-  sqlite3_stmt* st2 = nullptr;
-  ok(sqlite3_prepare_v2(db_, sql2, -1, &st2, nullptr), db_, "prepare load seats");
-  sqlite3_bind_int64(st2, 1, static_cast<sqlite3_int64>(id.value()));
+// Seat layout of a flight, read by the booking paths to validate seats.
+struct SeatLayout {
+  std::uint16_t rows{0};
+  std::uint8_t seats_per_row{0};
 
-  while (sqlite3_step(st2) == SQLITE_ROW) {
-    const auto r = static_cast<std::uint16_t>(sqlite3_column_int(st2, 0));
-    const std::string letter = reinterpret_cast<const char*>(sqlite3_column_text(st2, 1));
-    const char c = letter.empty() ? 'A' : letter[0];
-    flight.book_seat(flight::domain::Seat{r, c});
+  // same validation logic as domain::Flight::is_seat_valid
+  bool fits(const flight::domain::Seat& seat) const noexcept {
+    if (seat.row() < 1 || seat.row() > rows) return false;
+    const char max_letter = static_cast<char>('A' + seats_per_row - 1);
+    return seat.letter() >= 'A' && seat.letter() <= max_letter;
   }
+};
 
-  sqlite3_finalize(st2);
-  return flight;
-}
-
-std::vector<flight::domain::Flight>
-SqliteFlightRepository::search(const flight::application::FlightSearchCriteria& criteria) const {
-  std::lock_guard<std::mutex> lock(mu_);
+static std::optional<SeatLayout> load_layout(SqliteStatementCache& statements, flight::domain::FlightId id) {
+  auto lease = statements.acquire("SELECT rows, seats_per_row FROM flights WHERE flight_id=?;");
+  sqlite3_stmt* st = lease.get();
+  sqlite3_bind_int64(st, 1, static_cast<sqlite3_int64>(id.value()));
 
-  const char* sql =
-      "SELECT flight_id FROM flights WHERE origin=? AND destination=? ORDER BY flight_id ASC;";
+  if (sqlite3_step(st) != SQLITE_ROW) {
+    return std::nullopt; // flight not found
+  }
+  return SeatLayout{static_cast<std::uint16_t>(sqlite3_column_int(st, 0)),
+                    static_cast<std::uint8_t>(sqlite3_column_int(st, 1))};
+}
 
-  sqlite3_stmt* st = nullptr;
-  ok(sqlite3_prepare_v2(db_, sql, -1, &st, nullptr), db_, "prepare search");
-  sqlite3_bind_text(st, 1, criteria.origin.value().c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_bind_text(st, 2, criteria.destination.value().c_str(), -1, SQLITE_TRANSIENT);
+// Booked seats of a flight as an occupancy bitmap, for the bit-scan seat selection helpers.
+static flight::domain::SeatMap load_seat_map(SqliteStatementCache& statements, flight::domain::FlightId id,
+                                             const SeatLayout& layout) {
+  flight::domain::SeatMap seats(layout.rows, layout.seats_per_row);
+  auto lease = statements.acquire("SELECT seat_row, seat_letter FROM booked_seats WHERE flight_id=?;");
+  sqlite3_stmt* st = lease.get();
+  sqlite3_bind_int64(st, 1, static_cast<sqlite3_int64>(id.value()));
 
-  std::vector<flight::domain::Flight> out;
   while (sqlite3_step(st) == SQLITE_ROW) {
-    const auto fid = static_cast<std::uint64_t>(sqlite3_column_int64(st, 0));
-    out.push_back(load_flight_by_id_locked(flight::domain::FlightId{fid}));
+    const auto letter = column_view(st, 1);
+    const flight::domain::Seat seat(static_cast<std::uint16_t>(sqlite3_column_int(st, 0)),
+                                    letter.empty() ? 'A' : letter[0]);
+    if (layout.fits(seat)) seats.set(seats.index_of(seat));
   }
-
-  sqlite3_finalize(st);
-  return out;
+  return seats;
 }
 
-bool SqliteFlightRepository::try_book_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) {
-  std::lock_guard<std::mutex> lock(mu_);
+// Atomic insert with UNIQUE(PK) constraint; returns false if the seat was already booked.
+static bool insert_booked_seat(SqliteStatementCache& statements, sqlite3* db, flight::domain::FlightId flight_id,
+                               const flight::domain::Seat& seat) {
+  const char letter = seat.letter();
+  auto lease = statements.acquire(
+      "INSERT OR IGNORE INTO booked_seats(flight_id, seat_row, seat_letter) VALUES(?,?,?);");
+  sqlite3_stmt* st = lease.get();
 
-  // Validate against flight config (rows, seats_per_row)
-  const char* sql =
-      "SELECT rows, seats_per_row FROM flights WHERE flight_id=?;";
-  sqlite3_stmt* st = nullptr;
-  ok(sqlite3_prepare_v2(db_, sql, -1, &st, nullptr), db_, "prepare seat validate");
   sqlite3_bind_int64(st, 1, static_cast<sqlite3_int64>(flight_id.value()));
+  sqlite3_bind_int(st, 2, static_cast<int>(seat.row()));
+  sqlite3_bind_text(st, 3, &letter, 1, SQLITE_STATIC);
 
-  const int rc = sqlite3_step(st);
-  if (rc != SQLITE_ROW) {
-    sqlite3_finalize(st);
-    return false; // flight not found
+  ok(sqlite3_step(st), db, "step book seat");
+  return sqlite3_changes(db) == 1;
+}
+
+// Write transaction on the writer connection; rolled back unless commit() is called.
+class WriteTransaction final {
+public:
+  WriteTransaction(SqliteStatementCache& statements, sqlite3* db) : statements_(statements), db_(db) {
+    run("BEGIN IMMEDIATE;");
+  }
+  ~WriteTransaction() {
+    if (!done_) run_noexcept("ROLLBACK;");
   }
 
-  const auto rows = static_cast<std::uint16_t>(sqlite3_column_int(st, 0));
-  const auto spr  = static_cast<std::uint8_t>(sqlite3_column_int(st, 1));
-  sqlite3_finalize(st);
+  WriteTransaction(const WriteTransaction&) = delete;
+  WriteTransaction& operator=(const WriteTransaction&) = delete;
 
-  // same validation logic as domain::Flight::is_seat_valid
-  if (seat.row() < 1 || seat.row() > rows) return false;
-  const char max_letter = static_cast<char>('A' + spr - 1);
-  if (!(seat.letter() >= 'A' && seat.letter() <= max_letter)) return false;
+  void commit() {
+    run("COMMIT;");
+    done_ = true;
+  }
 
-  // Atomic insert with UNIQUE(PK) constraint
-  const char* sql2 =
-      "INSERT OR IGNORE INTO booked_seats(flight_id, seat_row, seat_letter) VALUES(?,?,?);";
-  sqlite3_stmt* st2 = nullptr;
-  ok(sqlite3_prepare_v2(db_, sql2, -1, &st2, nullptr), db_, "prepare book seat");
+private:
+  void run(const char* sql) {
+    auto lease = statements_.acquire(sql);
+    ok(sqlite3_step(lease.get()), db_, sql);
+  }
+  // Preparing the statement can throw (e.g. out of memory); a failed ROLLBACK leaves the transaction for
+  // SQLite to roll back when the connection next begins one or closes.
+  void run_noexcept(const char* sql) noexcept {
+    try {
+      auto lease = statements_.acquire(sql);
+      sqlite3_step(lease.get());
+    } catch (...) {
+    }
+  }
 
-  sqlite3_bind_int64(st2, 1, static_cast<sqlite3_int64>(flight_id.value()));
-  sqlite3_bind_int(st2, 2, static_cast<int>(seat.row()));
+  SqliteStatementCache& statements_;
+  sqlite3* db_;
+  bool done_{false};
+};
 
-  const std::string letter(1, seat.letter());
-  sqlite3_bind_text(st2, 3, letter.c_str(), -1, SQLITE_TRANSIENT);
+} // namespace
 
-  ok(sqlite3_step(st2), db_, "step book seat");
-  sqlite3_finalize(st2);
+void SqliteFlightRepository::upsert_many(std::vector<flight::domain::Flight> flights) {
+  if (flights.empty()) return;
+  WriterLock lock(mu_, sqlite_metrics().writer);
+  Connection* conn = writer_.get();
 
-  return sqlite3_changes(db_) == 1;
+  // One transaction (one journal sync) and one prepared statement for the whole batch.
+  WriteTransaction tx(*conn->statements, conn->db);
+  {
+    auto lease = conn->statements->acquire(kUpsertFlightSql);
+    for (const auto& flight : flights) step_upsert(conn->db, lease.get(), flight);
+  }
+  tx.commit();
 }
 
-void SqliteFlightRepository::release_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) {
-  std::lock_guard<std::mutex> lock(mu_);
+bool SqliteFlightRepository::try_book_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) {
+  WriterLock lock(mu_, sqlite_metrics().writer);
+  Connection* conn = writer_.get();
+
+  const auto layout = load_layout(*conn->statements, flight_id);
+  if (!layout || !layout->fits(seat)) return false;
+
+  return insert_booked_seat(*conn->statements, conn->db, flight_id, seat);
+}
+
+std::vector<bool> SqliteFlightRepository::try_book_seat_batch(
+    std::span<const flight::application::SeatBookingRequest> requests) {
+  std::vector<bool> results;
+  if (requests.empty()) return results;
+  results.reserve(requests.size());
+  WriterLock lock(mu_, sqlite_metrics().writer);
+  Connection* conn = writer_.get();
+
+  // One transaction for the batch, but each request succeeds or fails on its own (no rollback on conflict).
+  WriteTransaction tx(*conn->statements, conn->db);
+  std::unordered_map<flight::domain::FlightId::value_type, std::optional<SeatLayout>> layouts;
+  for (const auto& r : requests) {
+    auto [it, inserted] = layouts.try_emplace(r.flight_id.value());
+    if (inserted) it->second = load_layout(*conn->statements, r.flight_id);
+    results.push_back(it->second && it->second->fits(r.seat) &&
+                      insert_booked_seat(*conn->statements, conn->db, r.flight_id, r.seat));
+  }
+  tx.commit();
+  return results;
+}
+
+bool SqliteFlightRepository::try_book_seats(flight::domain::FlightId flight_id,
+                                            std::span<const flight::domain::Seat> seats) {
+  if (seats.empty()) return false;
+  WriterLock lock(mu_, sqlite_metrics().writer);
+  Connection* conn = writer_.get();
+
+  // One transaction for the whole group; a conflicting seat rolls everything back.
+  WriteTransaction tx(*conn->statements, conn->db);
+  const auto layout = load_layout(*conn->statements, flight_id);
+  if (!layout) return false;
+  for (const auto& seat : seats) {
+    if (!layout->fits(seat) || !insert_booked_seat(*conn->statements, conn->db, flight_id, seat)) return false;
+  }
+  tx.commit();
+  return true;
+}
 
-  const char* sql =
-      "DELETE FROM booked_seats WHERE flight_id=? AND seat_row=? AND seat_letter=?;";
+void SqliteFlightRepository::release_seat(flight::domain::FlightId flight_id, const flight::domain::Seat& seat) {
+  WriterLock lock(mu_, sqlite_metrics().writer);
+  Connection* conn = writer_.get();
 
-  sqlite3_stmt* st = nullptr;
-  ok(sqlite3_prepare_v2(db_, sql, -1, &st, nullptr), db_, "prepare release seat");
+  const char letter = seat.letter();
+  auto lease = conn->statements->acquire(
+      "DELETE FROM booked_seats WHERE flight_id=? AND seat_row=? AND seat_letter=?;");
+  sqlite3_stmt* st = lease.get();
 
   sqlite3_bind_int64(st, 1, static_cast<sqlite3_int64>(flight_id.value()));
   sqlite3_bind_int(st, 2, static_cast<int>(seat.row()));
-  const std::string letter(1, seat.letter());
-  sqlite3_bind_text(st, 3, letter.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(st, 3, &letter, 1, SQLITE_STATIC);
+
+  ok(sqlite3_step(st), conn->db, "step release seat");
+}
+
+std::optional<std::uint32_t> SqliteFlightRepository::available_count(flight::domain::FlightId flight_id) const {
+  ReadLease conn(*this);
+  auto lease = conn->statements->acquire(
+      "SELECT f.rows * f.seats_per_row - (SELECT COUNT(*) FROM booked_seats b WHERE b.flight_id = f.flight_id) "
+      "FROM flights f WHERE f.flight_id=?;");
+  sqlite3_stmt* st = lease.get();
+  sqlite3_bind_int64(st, 1, static_cast<sqlite3_int64>(flight_id.value()));
 
-  ok(sqlite3_step(st), db_, "step release seat");
-  sqlite3_finalize(st);
+  const int rc = sqlite3_step(st);
+  ok(rc, conn->db, "step available count");
+  if (rc != SQLITE_ROW) return std::nullopt;
+  return static_cast<std::uint32_t>(sqlite3_column_int64(st, 0));
+}
+
+std::vector<flight::domain::Seat> SqliteFlightRepository::first_free_seats(flight::domain::FlightId flight_id,
+                                                                           std::size_t n) const {
+  ReadLease conn(*this);
+  std::vector<flight::domain::Seat> out;
+  const auto layout = load_layout(*conn->statements, flight_id);
+  if (!layout) return out;
+
+  const auto seats = load_seat_map(*conn->statements, flight_id, *layout);
+  for (const auto index : seats.first_free(n)) out.push_back(seats.seat_at(index));
+  return out;
+}
+
+std::optional<flight::domain::Seat> SqliteFlightRepository::book_any_seat(flight::domain::FlightId flight_id) {
+  WriterLock lock(mu_, sqlite_metrics().writer);
+  Connection* conn = writer_.get();
+
+  // Pick and insert in one transaction so another process sharing the file cannot take the seat in between.
+  WriteTransaction tx(*conn->statements, conn->db);
+  const auto layout = load_layout(*conn->statements, flight_id);
+  if (!layout) return std::nullopt;
+
+  const auto seats = load_seat_map(*conn->statements, flight_id, *layout);
+  const auto index = seats.find_free();
+  if (!index) return std::nullopt;
+
+  const auto seat = seats.seat_at(*index);
+  if (!insert_booked_seat(*conn->statements, conn->db, flight_id, seat)) return std::nullopt;
+  tx.commit();
+  return seat;
+}
+
+std::vector<flight::domain::Seat> SqliteFlightRepository::book_adjacent_seats(flight::domain::FlightId flight_id,
+                                                                              std::size_t n) {
+  WriterLock lock(mu_, sqlite_metrics().writer);
+  Connection* conn = writer_.get();
+
+  WriteTransaction tx(*conn->statements, conn->db);
+  const auto layout = load_layout(*conn->statements, flight_id);
+  if (!layout) return {};
+
+  const auto seats = load_seat_map(*conn->statements, flight_id, *layout);
+  std::vector<flight::domain::Seat> out;
+  for (const auto index : seats.find_adjacent(n)) {
+    out.push_back(seats.seat_at(index));
+    if (!insert_booked_seat(*conn->statements, conn->db, flight_id, out.back())) return {};
+  }
+  if (!out.empty()) tx.commit();
+  return out;
 }
 
 } // namespace flight::infrastructure
@@ -0,0 +1,31 @@
+#include "flight/infrastructure/sqlite_statement_cache.hpp"
+
+#include <sqlite3.h>
+
+#include <stdexcept>
+#include <string>
+
+namespace flight::infrastructure {
+
+SqliteStatementCache::Lease::~Lease() {
+  sqlite3_reset(st_);
+  sqlite3_clear_bindings(st_);
+}
+
+SqliteStatementCache::~SqliteStatementCache() {
+  for (auto& [_, st] : statements_) sqlite3_finalize(st);
+}
+
+SqliteStatementCache::Lease SqliteStatementCache::acquire(const char* sql) {
+  auto it = statements_.find(sql);
+  if (it == statements_.end()) {
+    sqlite3_stmt* st = nullptr;
+    if (sqlite3_prepare_v3(db_, sql, -1, SQLITE_PREPARE_PERSISTENT, &st, nullptr) != SQLITE_OK) {
+      throw std::runtime_error(std::string("prepare: ") + sqlite3_errmsg(db_) + " [" + sql + "]");
+    }
+    it = statements_.emplace(sql, st).first;
+  }
+  return Lease(it->second);
+}
+
+} // namespace flight::infrastructure
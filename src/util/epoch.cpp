@@ -0,0 +1,103 @@
+#include "flight/util/epoch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+namespace flight::util {
+
+namespace {
+
+constexpr std::uint64_t kQuiescent = 0;
+
+// Advanced by reclaim() only, so pinning readers mostly find it in their cache.
+std::atomic<std::uint64_t> g_epoch{1};
+
+// One per reading thread, on its own cache line. Slots are never freed: a thread that exits clears in_use
+// and the next new thread takes the slot over, so the list only grows to the peak number of reader threads.
+struct alignas(64) ReaderSlot {
+  std::atomic<std::uint64_t> epoch{kQuiescent}; // pinned epoch, or kQuiescent
+  std::atomic<bool> in_use{true};
+  ReaderSlot* next{nullptr};
+};
+std::atomic<ReaderSlot*> g_slots{nullptr};
+
+ReaderSlot* acquire_slot() {
+  for (auto* s = g_slots.load(std::memory_order_acquire); s != nullptr; s = s->next) {
+    bool expected = false;
+    if (!s->in_use.load(std::memory_order_relaxed) && s->in_use.compare_exchange_strong(expected, true)) return s;
+  }
+  auto* s = new ReaderSlot;
+  s->next = g_slots.load(std::memory_order_relaxed);
+  while (!g_slots.compare_exchange_weak(s->next, s, std::memory_order_release, std::memory_order_relaxed)) {
+  }
+  return s;
+}
+
+struct ThreadReader {
+  ReaderSlot* slot{acquire_slot()};
+  std::uint32_t depth{0};
+
+  ~ThreadReader() {
+    slot->epoch.store(kQuiescent, std::memory_order_release);
+    slot->in_use.store(false, std::memory_order_release);
+  }
+};
+
+ThreadReader& reader() {
+  thread_local ThreadReader r;
+  return r;
+}
+
+std::uint64_t min_pinned_epoch() {
+  std::uint64_t min = std::numeric_limits<std::uint64_t>::max();
+  for (auto* s = g_slots.load(std::memory_order_acquire); s != nullptr; s = s->next) {
+    const auto e = s->epoch.load(std::memory_order_acquire);
+    if (e != kQuiescent) min = std::min(min, e);
+  }
+  return min;
+}
+
+} // namespace
+
+// The fences pair up: a reader's fence after pinning and a writer's fence after unpublishing (in retire() and
+// reclaim()) are totally ordered, so either the writer sees the pin or the reader sees the new version.
+EpochGuard::EpochGuard() {
+  auto& r = reader();
+  if (r.depth++ == 0) {
+    r.slot->epoch.store(g_epoch.load(), std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+}
+
+EpochGuard::~EpochGuard() {
+  auto& r = reader();
+  if (--r.depth == 0) r.slot->epoch.store(kQuiescent, std::memory_order_release);
+}
+
+EpochRetireList::~EpochRetireList() {
+  for (const auto& r : retired_) r.deleter(r.object, r.context);
+}
+
+void EpochRetireList::retire(void* object, Deleter deleter, void* context) {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  // A reader pinned at this epoch or earlier may hold `object`; one that pins after the next advance cannot.
+  retired_.push_back(Retired{object, deleter, context, g_epoch.load()});
+  if (retired_.size() >= next_reclaim_) reclaim();
+}
+
+std::size_t EpochRetireList::reclaim() {
+  if (retired_.empty()) return 0;
+  g_epoch.fetch_add(1);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const auto min = min_pinned_epoch();
+  const auto keep = std::stable_partition(retired_.begin(), retired_.end(),
+                                          [min](const Retired& r) { return r.epoch >= min; });
+  const auto freed = static_cast<std::size_t>(retired_.end() - keep);
+  for (auto it = keep; it != retired_.end(); ++it) it->deleter(it->object, it->context);
+  retired_.erase(keep, retired_.end());
+  next_reclaim_ = std::max(kReclaimThreshold, 2 * retired_.size());
+  return freed;
+}
+
+} // namespace flight::util
@@ -0,0 +1,19 @@
+#include "flight/util/latency_histogram.hpp"
+
+#include <cstdio>
+
+namespace flight::util {
+
+std::string format_ns(std::uint64_t ns) {
+  char buf[32];
+  if (ns < 10'000) {
+    std::snprintf(buf, sizeof buf, "%lluns", static_cast<unsigned long long>(ns));
+  } else if (ns < 10'000'000) {
+    std::snprintf(buf, sizeof buf, "%.1fus", static_cast<double>(ns) / 1e3);
+  } else {
+    std::snprintf(buf, sizeof buf, "%.1fms", static_cast<double>(ns) / 1e6);
+  }
+  return buf;
+}
+
+} // namespace flight::util
@@ -0,0 +1,192 @@
+#include "flight/util/metrics.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+
+namespace flight::util {
+
+namespace {
+
+std::atomic<std::uint64_t> g_next_instance{1};
+
+// Per-thread cache of (registry instance, shard) so record() finds its shard without locking. Keyed by an
+// instance id rather than the address, so a registry reallocated at the same address never reuses a stale shard.
+struct ShardCacheEntry {
+  std::uint64_t instance{0};
+  void* shard{nullptr};
+};
+thread_local std::vector<ShardCacheEntry> t_shards;
+thread_local ShardCacheEntry t_last_shard; // fast path: almost every thread only ever uses global()
+
+std::string series(const std::string& name, const std::string& labels, const char* extra = nullptr) {
+  std::string out = name;
+  if (!labels.empty() || extra) {
+    out += '{';
+    out += labels;
+    if (extra) {
+      if (!labels.empty()) out += ',';
+      out += extra;
+    }
+    out += '}';
+  }
+  return out;
+}
+
+double seconds(std::uint64_t ns) { return static_cast<double>(ns) / 1e9; }
+
+} // namespace
+
+Metrics::Shard::~Shard() {
+  for (auto& h : histograms) delete h.load(std::memory_order_relaxed);
+}
+
+Metrics::Metrics() : instance_id_(g_next_instance.fetch_add(1, std::memory_order_relaxed)) {}
+
+Metrics::~Metrics() = default;
+
+Metrics& Metrics::global() {
+  static Metrics instance;
+  return instance;
+}
+
+HistogramId Metrics::histogram(std::string_view name, std::string_view labels, std::string_view help) {
+  std::lock_guard<std::mutex> lk(mu_);
+  for (std::size_t i = 0; i < histogram_defs_.size(); ++i) {
+    if (histogram_defs_[i].name == name && histogram_defs_[i].labels == labels) {
+      return HistogramId{static_cast<std::uint32_t>(i)};
+    }
+  }
+  if (histogram_defs_.size() == kMaxHistograms) throw std::length_error("Metrics: too many histograms");
+  histogram_defs_.push_back(Definition{std::string(name), std::string(labels), std::string(help)});
+  return HistogramId{static_cast<std::uint32_t>(histogram_defs_.size() - 1)};
+}
+
+CounterId Metrics::counter(std::string_view name, std::string_view labels, std::string_view help) {
+  std::lock_guard<std::mutex> lk(mu_);
+  for (std::size_t i = 0; i < counter_defs_.size(); ++i) {
+    if (counter_defs_[i].name == name && counter_defs_[i].labels == labels) {
+      return CounterId{static_cast<std::uint32_t>(i)};
+    }
+  }
+  if (counter_defs_.size() == kMaxCounters) throw std::length_error("Metrics: too many counters");
+  counter_defs_.push_back(Definition{std::string(name), std::string(labels), std::string(help)});
+  return CounterId{static_cast<std::uint32_t>(counter_defs_.size() - 1)};
+}
+
+Metrics::Shard& Metrics::local_shard() {
+  if (t_last_shard.instance == instance_id_) return *static_cast<Shard*>(t_last_shard.shard);
+  for (const auto& e : t_shards) {
+    if (e.instance == instance_id_) {
+      t_last_shard = e;
+      return *static_cast<Shard*>(e.shard);
+    }
+  }
+  auto shard = std::make_unique<Shard>();
+  Shard* raw = shard.get();
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shards_.push_back(std::move(shard));
+  }
+  t_shards.push_back(ShardCacheEntry{instance_id_, raw});
+  t_last_shard = t_shards.back();
+  return *raw;
+}
+
+void Metrics::record(HistogramId id, std::uint64_t value) noexcept {
+  if (id.index >= kMaxHistograms) return;
+  auto& slot = local_shard().histograms[id.index];
+  auto* h = slot.load(std::memory_order_relaxed);
+  if (!h) {
+    h = new (std::nothrow) LatencyHistogram();
+    if (!h) return;
+    slot.store(h, std::memory_order_release); // publish to snapshot()
+  }
+  h->record(value);
+}
+
+void Metrics::add(CounterId id, std::uint64_t n) noexcept {
+  if (id.index >= kMaxCounters) return;
+  auto& c = local_shard().counters[id.index];
+  c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+Metrics::Snapshot Metrics::snapshot() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  Snapshot out;
+  out.histograms.reserve(histogram_defs_.size());
+  for (std::size_t i = 0; i < histogram_defs_.size(); ++i) {
+    const auto& d = histogram_defs_[i];
+    HistogramValue v{d.name, d.labels, d.help, {}};
+    for (const auto& shard : shards_) {
+      if (const auto* h = shard->histograms[i].load(std::memory_order_acquire)) h->add_to(v.data);
+    }
+    out.histograms.push_back(std::move(v));
+  }
+  out.counters.reserve(counter_defs_.size());
+  for (std::size_t i = 0; i < counter_defs_.size(); ++i) {
+    const auto& d = counter_defs_[i];
+    CounterValue v{d.name, d.labels, d.help, 0};
+    for (const auto& shard : shards_) v.value += shard->counters[i].load(std::memory_order_relaxed);
+    out.counters.push_back(std::move(v));
+  }
+  return out;
+}
+
+void Metrics::write_prometheus(std::ostream& out) const {
+  auto snap = snapshot();
+  // Series of one metric family must be contiguous, under a single HELP/TYPE header.
+  const auto by_name = [](const auto& a, const auto& b) { return a.name < b.name; };
+  std::stable_sort(snap.histograms.begin(), snap.histograms.end(), by_name);
+  std::stable_sort(snap.counters.begin(), snap.counters.end(), by_name);
+  std::string last_name;
+  char buf[64];
+  for (const auto& h : snap.histograms) {
+    if (h.name != last_name) {
+      out << "# HELP " << h.name << ' ' << h.help << "\n# TYPE " << h.name << " summary\n";
+      last_name = h.name;
+    }
+    for (const auto& [q, label] : {std::pair{0.5, "quantile=\"0.5\""}, std::pair{0.99, "quantile=\"0.99\""},
+                                   std::pair{0.999, "quantile=\"0.999\""}}) {
+      std::snprintf(buf, sizeof buf, "%.9g", seconds(h.data.percentile(q)));
+      out << series(h.name, h.labels, label) << ' ' << buf << '\n';
+    }
+    std::snprintf(buf, sizeof buf, "%.9g", seconds(h.data.sum));
+    out << series(h.name + "_sum", h.labels) << ' ' << buf << '\n';
+    out << series(h.name + "_count", h.labels) << ' ' << h.data.total() << '\n';
+  }
+  for (const auto& c : snap.counters) {
+    if (c.name != last_name) {
+      out << "# HELP " << c.name << ' ' << c.help << "\n# TYPE " << c.name << " counter\n";
+      last_name = c.name;
+    }
+    out << series(c.name, c.labels) << ' ' << c.value << '\n';
+  }
+}
+
+void Metrics::write_table(std::ostream& out) const {
+  if (!enabled()) {
+    out << "Metrics are compiled out (build with METRICS=1).\n";
+    return;
+  }
+  const auto snap = snapshot();
+  char line[256];
+  for (const auto& h : snap.histograms) {
+    const auto n = h.data.total();
+    if (n == 0) continue;
+    std::snprintf(line, sizeof line, "%-64s %10llu  p50 %8s  p99 %8s  p999 %8s  mean %8s\n",
+                  series(h.name, h.labels).c_str(), static_cast<unsigned long long>(n),
+                  format_ns(h.data.percentile(0.5)).c_str(), format_ns(h.data.percentile(0.99)).c_str(),
+                  format_ns(h.data.percentile(0.999)).c_str(), format_ns(h.data.sum / n).c_str());
+    out << line;
+  }
+  for (const auto& c : snap.counters) {
+    if (c.value == 0) continue;
+    std::snprintf(line, sizeof line, "%-64s %10llu\n", series(c.name, c.labels).c_str(),
+                  static_cast<unsigned long long>(c.value));
+    out << line;
+  }
+}
+
+} // namespace flight::util
@@ -0,0 +1,30 @@
+#include "flight/domain/airport_code.hpp"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <type_traits>
+
+using namespace flight::domain;
+using namespace flight::domain::literals;
+
+static_assert(std::is_trivially_copyable_v<AirportCode>);
+static_assert(sizeof(AirportCode) == sizeof(std::uint16_t));
+static_assert("WAW"_iata == AirportCode("waw"));
+static_assert("WAW"_iata != "FRA"_iata);
+
+TEST(AirportCode, PacksAndRoundTripsLetters) {
+  const AirportCode waw("waw");
+  EXPECT_EQ(waw.value(), "WAW");
+  EXPECT_STREQ(waw.chars().data(), "WAW");
+  EXPECT_EQ(AirportCode::from_packed(waw.packed()), waw);
+  EXPECT_EQ(std::hash<AirportCode>{}(waw), std::hash<AirportCode>{}("WAW"_iata));
+  EXPECT_EQ(AirportCode("ZZZ").value(), "ZZZ");
+}
+
+TEST(AirportCode, RejectsInvalidInput) {
+  EXPECT_THROW(AirportCode("WA"), std::invalid_argument);
+  EXPECT_THROW(AirportCode("WAWA"), std::invalid_argument);
+  EXPECT_THROW(AirportCode("W1W"), std::invalid_argument);
+  EXPECT_THROW(AirportCode::from_packed(0xFFFF), std::invalid_argument);
+}
@@ -0,0 +1,177 @@
+#include "flight/application/async_booking_service.hpp"
+#include "flight/application/booking_service.hpp"
+#include "flight/infrastructure/atomic_id_generator.hpp"
+#include "flight/infrastructure/in_memory_flight_repository.hpp"
+#include "flight/infrastructure/in_memory_reservation_repository.hpp"
+#include "flight/infrastructure/lock_free_flight_repository.hpp"
+#include "flight/infrastructure/sqlite_flight_repository.hpp"
+#include "flight/infrastructure/system_clock.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace flight;
+
+namespace {
+
+// Reservation store whose batch insert fails with something that is not a std::exception.
+class FailingReservationRepository final : public application::IReservationRepository {
+public:
+  void add(domain::Reservation reservation) override { inner_.add(std::move(reservation)); }
+  void add_many(std::vector<domain::Reservation>) override { throw 42; }
+  std::optional<domain::Reservation> get(domain::ReservationId id) const override { return inner_.get(id); }
+  std::vector<domain::Reservation> list_by_order(domain::OrderId order_id) const override {
+    return inner_.list_by_order(order_id);
+  }
+  std::vector<domain::Reservation> list_by_flight(domain::FlightId flight_id) const override {
+    return inner_.list_by_flight(flight_id);
+  }
+
+private:
+  infrastructure::InMemoryReservationRepository inner_;
+};
+
+} // namespace
+
+TEST(BookingService, BookSeatBatchBooksEachCommandIndependently) {
+  infrastructure::InMemoryFlightRepository in_memory;
+  infrastructure::LockFreeFlightRepository lock_free;
+  infrastructure::SqliteFlightRepository sqlite;
+  for (application::IFlightRepository* flights :
+       std::vector<application::IFlightRepository*>{&in_memory, &lock_free, &sqlite}) {
+    infrastructure::AtomicIdGenerator ids;
+    infrastructure::SystemClock clock;
+    infrastructure::InMemoryReservationRepository reservations;
+    for (std::uint64_t id = 1; id <= 2; ++id) {
+      flights->upsert(domain::Flight(domain::FlightId{id}, domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+                                     std::chrono::system_clock::now(), 10, 6));
+    }
+    ASSERT_TRUE(flights->try_book_seat(domain::FlightId{2}, domain::Seat{1, 'A'}));
+
+    application::BookingService booking{*flights, reservations, ids, clock};
+    const domain::OrderId order{7};
+    const std::vector<application::BookSeatCommand> commands{
+        {domain::FlightId{1}, order, domain::Seat{1, 'A'}},
+        {domain::FlightId{2}, order, domain::Seat{1, 'A'}},  // already booked
+        {domain::FlightId{1}, order, domain::Seat{1, 'A'}},  // booked earlier in this batch
+        {domain::FlightId{9}, order, domain::Seat{1, 'A'}},  // unknown flight
+        {domain::FlightId{1}, order, domain::Seat{11, 'A'}}, // outside the seat map
+        {domain::FlightId{2}, order, domain::Seat{3, 'F'}}};
+    const auto results = booking.book_seat_batch(commands);
+
+    ASSERT_EQ(results.size(), commands.size());
+    const std::vector<bool> expected{true, false, false, false, false, true};
+    for (std::size_t i = 0; i < results.size(); ++i) EXPECT_EQ(results[i].success, expected[i]) << i;
+    EXPECT_EQ(results[5].reservation->seat(), (domain::Seat{3, 'F'}));
+    EXPECT_EQ(reservations.list_by_order(order).size(), 2u);
+    EXPECT_EQ(flights->available_count(domain::FlightId{2}), 58u);
+  }
+}
+
+TEST(AsyncBookingService, ConcurrentSubmittersGetExactlyOneWinnerPerSeat) {
+  infrastructure::AtomicIdGenerator ids;
+  infrastructure::SystemClock clock;
+  infrastructure::InMemoryFlightRepository flights;
+  infrastructure::InMemoryReservationRepository reservations;
+  const auto flight_id = ids.next_flight_id();
+  flights.upsert(domain::Flight(flight_id, domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+                                std::chrono::system_clock::now(), 10, 6));
+  application::BookingService booking{flights, reservations, ids, clock};
+  const auto order_id = ids.next_order_id();
+
+  constexpr int kThreads = 8;
+  std::vector<std::vector<std::future<application::BookSeatResult>>> futures(kThreads);
+  {
+    application::AsyncBookingOptions options;
+    options.workers = 3;
+    options.queue_capacity = 16; // well below the number of commands, so submitters wait
+    options.max_batch = 8;
+    application::AsyncBookingService async{booking, options};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&, t] {
+        // Every thread asks for every seat.
+        for (std::uint16_t row = 1; row <= 10; ++row) {
+          for (char letter = 'A'; letter <= 'F'; ++letter) {
+            futures[t].push_back(async.submit({flight_id, order_id, domain::Seat{row, letter}}));
+          }
+        }
+      });
+    }
+    for (auto& th : threads) th.join();
+  } // the destructor completes everything still queued
+
+  int won = 0;
+  for (auto& per_thread : futures) {
+    for (auto& f : per_thread) won += f.get().success ? 1 : 0;
+  }
+  EXPECT_EQ(won, 60);
+  EXPECT_EQ(flights.available_count(flight_id), 0u);
+  EXPECT_EQ(reservations.list_by_order(order_id).size(), 60u);
+}
+
+TEST(AsyncBookingService, TrySubmitRejectsWhenTheQueueIsFull) {
+  infrastructure::AtomicIdGenerator ids;
+  infrastructure::SystemClock clock;
+  infrastructure::LockFreeFlightRepository flights;
+  infrastructure::InMemoryReservationRepository reservations;
+  const auto flight_id = ids.next_flight_id();
+  flights.upsert(domain::Flight(flight_id, domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+                                std::chrono::system_clock::now(), 10, 6));
+  application::BookingService booking{flights, reservations, ids, clock};
+
+  application::AsyncBookingOptions options;
+  options.workers = 1;
+  options.queue_capacity = 2;
+  options.max_batch = 1;
+  application::AsyncBookingService async{booking, options};
+
+  // Park the only worker inside a completion callback.
+  std::promise<void> started;
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  async.submit({flight_id, domain::OrderId{1}, domain::Seat{1, 'A'}}, [&](application::BookSeatResult r) {
+    EXPECT_TRUE(r.success);
+    started.set_value();
+    released.wait();
+  });
+  started.get_future().wait();
+
+  auto queued1 = async.try_submit({flight_id, domain::OrderId{1}, domain::Seat{1, 'B'}});
+  auto queued2 = async.try_submit({flight_id, domain::OrderId{1}, domain::Seat{1, 'A'}});
+  ASSERT_TRUE(queued1.has_value());
+  ASSERT_TRUE(queued2.has_value());
+  EXPECT_EQ(async.queue_depth(), 2u);
+  EXPECT_FALSE(async.try_submit({flight_id, domain::OrderId{1}, domain::Seat{1, 'C'}}).has_value());
+  EXPECT_FALSE(async.try_submit({flight_id, domain::OrderId{1}, domain::Seat{1, 'C'}}, [](auto) { FAIL(); }));
+
+  release.set_value();
+  EXPECT_TRUE(queued1->get().success);
+  EXPECT_FALSE(queued2->get().success); // 1A went to the first command
+  EXPECT_EQ(flights.available_count(flight_id), 58u);
+}
+
+TEST(AsyncBookingService, FailedBatchReleasesItsSeats) {
+  infrastructure::AtomicIdGenerator ids;
+  infrastructure::SystemClock clock;
+  infrastructure::InMemoryFlightRepository flights;
+  FailingReservationRepository reservations;
+  const auto flight_id = ids.next_flight_id();
+  flights.upsert(domain::Flight(flight_id, domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+                                std::chrono::system_clock::now(), 10, 6));
+  application::BookingService booking{flights, reservations, ids, clock};
+
+  application::AsyncBookingOptions options;
+  options.workers = 1;
+  application::AsyncBookingService async{booking, options};
+  const auto result = async.submit({flight_id, domain::OrderId{1}, domain::Seat{1, 'A'}}).get();
+  EXPECT_FALSE(result.success);
+  EXPECT_FALSE(result.error.empty());
+  EXPECT_EQ(flights.available_count(flight_id), 60u); // 1A was booked, then released
+  EXPECT_FALSE(async.submit({flight_id, domain::OrderId{1}, domain::Seat{1, 'B'}}).get().success); // worker alive
+}
@@ -9,6 +9,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -50,3 +51,79 @@ TEST(BookingConcurrency, OnlyOneThreadCanBookSameSeat) {
   EXPECT_EQ(static_cast<int>(list.size()), 1);
   EXPECT_EQ(list.front().seat(), seat);
 }
+
+namespace {
+
+// Books and releases every seat of each given flight `rounds` times; returns ops/second.
+double run_book_release_rounds(infrastructure::InMemoryFlightRepository& flights,
+                               const std::vector<domain::FlightId>& flight_ids,
+                               int threads_count,
+                               int rounds,
+                               std::atomic<int>& failures) {
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  threads.reserve(static_cast<std::size_t>(threads_count));
+  for (int t = 0; t < threads_count; ++t) {
+    threads.emplace_back([&, t] {
+      for (std::size_t i = static_cast<std::size_t>(t); i < flight_ids.size();
+           i += static_cast<std::size_t>(threads_count)) {
+        for (int r = 0; r < rounds; ++r) {
+          for (std::uint16_t row = 1; row <= 30; ++row) {
+            for (char letter = 'A'; letter <= 'F'; ++letter) {
+              if (!flights.try_book_seat(flight_ids[i], domain::Seat{row, letter})) {
+                failures.fetch_add(1, std::memory_order_relaxed);
+              }
+            }
+          }
+          if (r + 1 == rounds) break; // leave the last round booked
+          for (std::uint16_t row = 1; row <= 30; ++row) {
+            for (char letter = 'A'; letter <= 'F'; ++letter) {
+              flights.release_seat(flight_ids[i], domain::Seat{row, letter});
+            }
+          }
+        }
+      }
+    });
+  }
+  for (auto& th : threads) th.join();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  const auto ops = static_cast<double>(flight_ids.size()) * rounds * 30 * 6 * 2;
+  return ops / elapsed.count();
+}
+
+} // namespace
+
+// One thread per flight books and releases seats; every booking succeeds and each flight ends up full. Whether
+// the threads actually ran in parallel depends on the machine, so that part is only reported.
+TEST(BookingConcurrency, ParallelBookingsOnDistinctFlightsAllSucceed) {
+  constexpr int kFlights = 8;
+  constexpr int kRounds = 50;
+
+  infrastructure::AtomicIdGenerator ids;
+  infrastructure::InMemoryFlightRepository single_thread_repo;
+  infrastructure::InMemoryFlightRepository multi_thread_repo;
+
+  std::vector<domain::FlightId> flight_ids;
+  for (int i = 0; i < kFlights; ++i) {
+    const auto f = domain::Flight(ids.next_flight_id(), domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+                                 std::chrono::system_clock::now(), 30, 6);
+    flight_ids.push_back(f.id());
+    single_thread_repo.upsert(f);
+    multi_thread_repo.upsert(f);
+  }
+
+  std::atomic<int> failures{0};
+  const auto baseline = run_book_release_rounds(single_thread_repo, flight_ids, 1, kRounds, failures);
+  const auto parallel = run_book_release_rounds(multi_thread_repo, flight_ids, kFlights, kRounds, failures);
+
+  // Throughput is machine-dependent, so it is reported rather than asserted.
+  RecordProperty("ops_per_sec_1_thread", static_cast<int>(baseline));
+  RecordProperty("ops_per_sec_" + std::to_string(kFlights) + "_threads", static_cast<int>(parallel));
+
+  EXPECT_EQ(failures.load(), 0);
+  for (const auto id : flight_ids) {
+    const auto f = multi_thread_repo.get(id);
+    ASSERT_TRUE(f.has_value());
+    EXPECT_EQ(f->available_count(), 0u);
+  }
+}
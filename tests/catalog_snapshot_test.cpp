@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include "flight/domain/airport_code.hpp"
+#include "flight/infrastructure/catalog_snapshot.hpp"
+#include "flight/infrastructure/in_memory_flight_repository.hpp"
+#include "flight/infrastructure/lock_free_flight_repository.hpp"
+#include "flight/util/crc32.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+using namespace flight::domain;
+using namespace flight::domain::literals;
+using flight::infrastructure::CatalogSnapshot;
+
+namespace {
+
+// Unique snapshot path under the temp directory; removed on exit.
+class TempSnapshot {
+public:
+  TempSnapshot()
+      : path_(std::filesystem::temp_directory_path() /
+              ("flight_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) +
+               ".snap")) {}
+  ~TempSnapshot() {
+    std::error_code ec;
+    std::filesystem::remove(path_, ec);
+  }
+
+  std::string path() const { return path_.string(); }
+
+private:
+  std::filesystem::path path_;
+};
+
+} // namespace
+
+TEST(CatalogSnapshot, RoundTripsFlightsAndSeatOccupancy) {
+  TempSnapshot file;
+  flight::infrastructure::LockFreeFlightRepository source;
+  const auto departure = std::chrono::system_clock::now() + std::chrono::hours(5);
+  source.upsert(Flight(FlightId{3}, "WAW"_iata, "CDG"_iata, departure, 20, 6));
+  source.upsert(Flight(FlightId{1}, "WAW"_iata, "FRA"_iata, departure + std::chrono::hours(1), 30, 6));
+  ASSERT_TRUE(source.try_book_seat(FlightId{1}, Seat{12, 'C'}));
+  ASSERT_EQ(source.book_adjacent_seats(FlightId{3}, 4).size(), 4u);
+
+  ASSERT_EQ(CatalogSnapshot::write(file.path(), source), 2u);
+
+  const CatalogSnapshot snapshot(file.path());
+  ASSERT_EQ(snapshot.size(), 2u);
+  EXPECT_EQ(snapshot.flights()[0].id, 1u); // written in id order
+  const auto summary = snapshot.summary(snapshot.flights()[1]);
+  EXPECT_EQ(summary.id, FlightId{3});
+  EXPECT_EQ(summary.destination, "CDG"_iata);
+  EXPECT_EQ(summary.departure, departure);
+  EXPECT_EQ(summary.available, 120u - 4u);
+
+  flight::infrastructure::InMemoryFlightRepository target;
+  EXPECT_EQ(snapshot.load_into(target), 3u);
+  const auto f1 = target.get(FlightId{1});
+  ASSERT_TRUE(f1.has_value());
+  EXPECT_EQ(f1->seat_map(), source.get(FlightId{1})->seat_map());
+  EXPECT_TRUE(f1->is_booked(Seat{12, 'C'}));
+  EXPECT_EQ(target.available_count(FlightId{3}), 116u);
+  EXPECT_FALSE(target.try_book_seat(FlightId{1}, Seat{12, 'C'}));
+}
+
+TEST(CatalogSnapshot, RejectsCorruptOrForeignFiles) {
+  TempSnapshot file;
+  flight::infrastructure::InMemoryFlightRepository source;
+  source.upsert(Flight(FlightId{1}, "WAW"_iata, "FRA"_iata, std::chrono::system_clock::now(), 10, 6));
+  CatalogSnapshot::write(file.path(), source);
+
+  {
+    // Flip a bit in the seat words.
+    std::fstream f(file.path(), std::ios::binary | std::ios::in | std::ios::out);
+    f.seekp(-1, std::ios::end);
+    f.put('\x01');
+  }
+  EXPECT_THROW(CatalogSnapshot(file.path()), std::runtime_error);
+  EXPECT_NO_THROW(CatalogSnapshot(file.path(), /*verify_checksum*/ false)); // only the header is checked
+
+  {
+    // A word count whose byte size wraps around to the real one, with a matching header checksum.
+    std::fstream f(file.path(), std::ios::binary | std::ios::in | std::ios::out);
+    flight::infrastructure::SnapshotHeader header;
+    f.read(reinterpret_cast<char*>(&header), sizeof header);
+    header.word_count += std::uint64_t{1} << 61;
+    header.header_crc = 0;
+    header.header_crc =
+        flight::util::crc32(std::as_bytes(std::span<const flight::infrastructure::SnapshotHeader>(&header, 1)));
+    f.seekp(0);
+    f.write(reinterpret_cast<const char*>(&header), sizeof header);
+  }
+  EXPECT_THROW(CatalogSnapshot(file.path(), /*verify_checksum*/ false), std::runtime_error);
+
+  {
+    std::ofstream f(file.path(), std::ios::binary | std::ios::trunc);
+    f << "definitely not a snapshot, but long enough to hold a header of sixty-four bytes........";
+  }
+  EXPECT_THROW(CatalogSnapshot(file.path()), std::runtime_error);
+  EXPECT_THROW(CatalogSnapshot(file.path() + ".missing"), std::runtime_error);
+}
+
+TEST(Crc32, MatchesReferenceValues) {
+  const std::string check = "123456789";
+  const auto bytes = std::as_bytes(std::span<const char>(check.data(), check.size()));
+  EXPECT_EQ(flight::util::crc32(bytes), 0xCBF43926u);
+  EXPECT_EQ(flight::util::crc32(bytes.subspan(4), flight::util::crc32(bytes.first(4))), 0xCBF43926u);
+  EXPECT_EQ(flight::util::crc32({}), 0u);
+}
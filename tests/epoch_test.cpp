@@ -0,0 +1,133 @@
+#include "flight/infrastructure/in_memory_flight_repository.hpp"
+#include "flight/util/epoch.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace flight;
+
+namespace {
+
+void count_free(void*, void* counter) { ++*static_cast<int*>(counter); }
+
+} // namespace
+
+TEST(Epoch, RetiredObjectsOutliveTheReadersThatMayHoldThem) {
+  int freed = 0;
+  int a = 0;
+  int b = 0;
+  {
+    util::EpochRetireList retired;
+    {
+      util::EpochGuard pin;
+      util::EpochGuard nested;
+      retired.retire(&a, &count_free, &freed);
+      EXPECT_EQ(retired.reclaim(), 0u);
+    }
+    EXPECT_EQ(retired.reclaim(), 1u);
+    EXPECT_EQ(freed, 1);
+
+    // A reader on another thread holds back frees the same way.
+    std::atomic<int> stage{0};
+    std::thread reader([&] {
+      util::EpochGuard pin;
+      stage.store(1);
+      while (stage.load() != 2) std::this_thread::yield();
+    });
+    while (stage.load() != 1) std::this_thread::yield();
+    retired.retire(&b, &count_free, &freed);
+    EXPECT_EQ(retired.reclaim(), 0u);
+    stage.store(2);
+    reader.join();
+    EXPECT_EQ(retired.reclaim(), 1u);
+
+    retired.retire(&a, &count_free, &freed);
+    EXPECT_EQ(retired.pending(), 1u);
+  }
+  EXPECT_EQ(freed, 3); // the destructor frees what is still pending
+}
+
+TEST(Epoch, InMemoryReadersSeeWholeVersionsWhileSeatsAreBooked) {
+  constexpr std::uint16_t kRows = 100;
+  infrastructure::InMemoryFlightRepository repo;
+  const domain::FlightId id{1};
+  repo.upsert(domain::Flight(id, domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+                             std::chrono::system_clock::time_point{}, kRows, 6));
+
+  std::atomic<bool> done{false};
+  std::thread booker([&] {
+    for (std::uint16_t row = 1; row <= kRows; ++row) {
+      for (const char first : {'A', 'C', 'E'}) {
+        const std::array<domain::Seat, 2> pair{domain::Seat{row, first}, domain::Seat{row, static_cast<char>(first + 1)}};
+        EXPECT_TRUE(repo.try_book_seats(id, pair));
+      }
+    }
+    done.store(true);
+  });
+
+  // Pairs are booked atomically, so every version a reader sees holds whole pairs, and versions only grow.
+  std::uint32_t last = 0;
+  do {
+    for (const auto& f : repo.search({domain::AirportCode("WAW"), domain::AirportCode("FRA")})) {
+      EXPECT_EQ(f.booked_count() % 2, 0u);
+      EXPECT_GE(f.booked_count(), last);
+      last = f.booked_count();
+    }
+    repo.visit(id, [](const domain::Flight& f) {
+      for (std::uint16_t row = 1; row <= kRows; ++row) {
+        EXPECT_EQ(f.is_booked(domain::Seat{row, 'A'}), f.is_booked(domain::Seat{row, 'B'}));
+      }
+    });
+  } while (!done.load());
+  booker.join();
+  EXPECT_EQ(repo.available_count(id), 0u);
+}
+
+TEST(Epoch, InMemoryReadersRunWhileTheCatalogGrows) {
+  constexpr std::uint64_t kFlights = 2000;
+  infrastructure::InMemoryFlightRepository repo;
+  const application::FlightSearchCriteria route{domain::AirportCode("WAW"), domain::AirportCode("FRA")};
+
+  std::atomic<bool> done{false};
+  std::thread writer([&] {
+    // Single inserts, a batch and route moves: table growth and route list swaps under the readers.
+    for (std::uint64_t id = 1; id <= kFlights / 2; ++id) {
+      repo.upsert(domain::Flight(domain::FlightId{id}, domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+                                 std::chrono::system_clock::time_point{std::chrono::hours(id)}, 2, 2));
+    }
+    std::vector<domain::Flight> batch;
+    for (std::uint64_t id = kFlights / 2 + 1; id <= kFlights; ++id) {
+      batch.emplace_back(domain::FlightId{id}, domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+                         std::chrono::system_clock::time_point{std::chrono::hours(id)}, 2, 2);
+    }
+    repo.upsert_many(std::move(batch));
+    for (std::uint64_t id = 1; id <= 100; ++id) {
+      repo.upsert(domain::Flight(domain::FlightId{id}, domain::AirportCode("WAW"), domain::AirportCode("CDG"),
+                                 std::chrono::system_clock::time_point{std::chrono::hours(id)}, 2, 2));
+    }
+    done.store(true);
+  });
+
+  std::size_t seen = 0;
+  do {
+    const auto found = repo.search(route);
+    EXPECT_TRUE(std::is_sorted(found.begin(), found.end(),
+                               [](const auto& a, const auto& b) { return a.departure() < b.departure(); }));
+    for (const auto& f : found) EXPECT_EQ(f.destination(), domain::AirportCode("FRA"));
+    EXPECT_GE(found.size() + 100, seen); // only the 100 moved flights ever leave the route
+    seen = found.size();
+    if (seen > 0) {
+      EXPECT_TRUE(repo.get(found.back().id()).has_value());
+    }
+  } while (!done.load());
+  writer.join();
+  EXPECT_EQ(repo.search(route).size(), kFlights - 100);
+  EXPECT_EQ(repo.search({domain::AirportCode("WAW"), domain::AirportCode("CDG")}).size(), 100u);
+}
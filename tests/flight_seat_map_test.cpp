@@ -0,0 +1,72 @@
+#include "flight/domain/flight.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+using namespace flight;
+
+namespace {
+
+domain::Flight make_flight(std::uint16_t rows, std::uint8_t seats_per_row) {
+  return domain::Flight(domain::FlightId{1}, domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+                        std::chrono::system_clock::now(), rows, seats_per_row);
+}
+
+} // namespace
+
+TEST(FlightSeatMap, BookReleaseAndCounts) {
+  auto f = make_flight(30, 6);
+  EXPECT_EQ(f.booked_count(), 0u);
+  EXPECT_EQ(f.available_count(), 180u);
+
+  f.book_seat(domain::Seat{1, 'A'});
+  f.book_seat(domain::Seat{30, 'F'});
+  EXPECT_TRUE(f.is_booked(domain::Seat{1, 'A'}));
+  EXPECT_TRUE(f.is_booked(domain::Seat{30, 'F'}));
+  EXPECT_FALSE(f.is_booked(domain::Seat{1, 'B'}));
+  EXPECT_EQ(f.booked_count(), 2u);
+  EXPECT_EQ(f.available_count(), 178u);
+
+  EXPECT_THROW(f.book_seat(domain::Seat{1, 'A'}), std::runtime_error);
+  EXPECT_THROW(f.book_seat(domain::Seat{31, 'A'}), std::invalid_argument);
+  EXPECT_FALSE(f.is_booked(domain::Seat{1, 'G'}));
+
+  f.release_seat(domain::Seat{1, 'A'});
+  f.release_seat(domain::Seat{99, 'Z'}); // invalid seats are ignored
+  EXPECT_FALSE(f.is_booked(domain::Seat{1, 'A'}));
+  EXPECT_EQ(f.booked_count(), 1u);
+}
+
+TEST(FlightSeatMap, CopiesAreIndependent) {
+  auto f = make_flight(20, 26); // spans several 64-bit words
+  f.book_seat(domain::Seat{20, 'Z'});
+
+  auto copy = f;
+  copy.book_seat(domain::Seat{3, 'C'});
+
+  EXPECT_TRUE(copy.is_booked(domain::Seat{20, 'Z'}));
+  EXPECT_FALSE(f.is_booked(domain::Seat{3, 'C'}));
+  EXPECT_EQ(f.booked_count(), 1u);
+  EXPECT_EQ(copy.booked_count(), 2u);
+}
+
+TEST(FlightSeatMap, BookAdjacentSeatsPrefersTightestRunThenNearestSplit) {
+  auto f = make_flight(10, 10);
+  for (std::uint16_t row = 1; row <= 10; ++row) {
+    for (char letter = 'A'; letter <= 'J'; ++letter) f.book_seat(domain::Seat{row, letter});
+  }
+  for (char letter = 'A'; letter <= 'E'; ++letter) f.release_seat(domain::Seat{2, letter});
+  for (char letter = 'C'; letter <= 'F'; ++letter) f.release_seat(domain::Seat{7, letter}); // straddles words
+  f.release_seat(domain::Seat{9, 'A'});
+  f.release_seat(domain::Seat{9, 'J'});
+
+  EXPECT_EQ(f.book_adjacent_seats(4), (std::vector<domain::Seat>{{7, 'C'}, {7, 'D'}, {7, 'E'}, {7, 'F'}}));
+  EXPECT_EQ(f.book_adjacent_seats(3), (std::vector<domain::Seat>{{2, 'A'}, {2, 'B'}, {2, 'C'}}));
+
+  // No row has three adjacent seats left, so the group is split over the fewest consecutive rows.
+  EXPECT_EQ(f.book_adjacent_seats(3), (std::vector<domain::Seat>{{2, 'D'}, {2, 'E'}, {9, 'A'}}));
+
+  EXPECT_TRUE(f.book_adjacent_seats(2).empty());
+  EXPECT_EQ(f.available_count(), 1u);
+}
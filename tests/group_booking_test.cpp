@@ -0,0 +1,85 @@
+#include "flight/application/booking_service.hpp"
+#include "flight/infrastructure/atomic_id_generator.hpp"
+#include "flight/infrastructure/flight_repository_factory.hpp"
+#include "flight/infrastructure/in_memory_reservation_repository.hpp"
+#include "flight/infrastructure/system_clock.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace flight;
+
+namespace {
+
+const infrastructure::FlightRepoType kRepoTypes[] = {
+    infrastructure::FlightRepoType::InMemory,
+    infrastructure::FlightRepoType::LockFree,
+    infrastructure::FlightRepoType::Sqlite,
+};
+
+domain::Flight make_flight(domain::FlightId id) {
+  return domain::Flight(id, domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+                        std::chrono::system_clock::now(), 10, 6);
+}
+
+} // namespace
+
+TEST(GroupBooking, BooksAllSeatsOrNone) {
+  for (const auto type : kRepoTypes) {
+    infrastructure::AtomicIdGenerator ids;
+    infrastructure::SystemClock clock;
+    infrastructure::InMemoryReservationRepository reservations;
+    auto flights = infrastructure::make_flight_repository(type);
+    const auto f = make_flight(ids.next_flight_id());
+    flights->upsert(f);
+
+    application::BookingService booking{*flights, reservations, ids, clock};
+    const auto order_id = ids.next_order_id();
+    ASSERT_TRUE(flights->try_book_seat(f.id(), domain::Seat{1, 'C'}));
+
+    // 1C is taken, so nothing from this group may be booked.
+    const auto failed = booking.book_seats({f.id(), order_id, {{1, 'A'}, {1, 'B'}, {1, 'C'}}});
+    EXPECT_FALSE(failed.success);
+    EXPECT_FALSE(flights->get(f.id())->is_booked(domain::Seat{1, 'A'}));
+    EXPECT_FALSE(flights->get(f.id())->is_booked(domain::Seat{1, 'B'}));
+
+    // Invalid and repeated seats fail the whole group too.
+    EXPECT_FALSE(flights->try_book_seats(f.id(), std::vector<domain::Seat>{{2, 'A'}, {11, 'A'}}));
+    EXPECT_FALSE(flights->try_book_seats(f.id(), std::vector<domain::Seat>{{2, 'A'}, {2, 'A'}}));
+    EXPECT_FALSE(flights->get(f.id())->is_booked(domain::Seat{2, 'A'}));
+
+    const auto booked = booking.book_seats({f.id(), order_id, {{1, 'A'}, {1, 'B'}, {5, 'F'}, {9, 'D'}, {10, 'F'}}});
+    ASSERT_TRUE(booked.success);
+    ASSERT_EQ(booked.reservations.size(), 5u);
+    EXPECT_EQ(reservations.list_by_order(order_id).size(), 5u);
+    EXPECT_EQ(flights->get(f.id())->booked_count(), 6u);
+  }
+}
+
+TEST(GroupBooking, OverlappingGroupsRaceAndExactlyOneWins) {
+  for (const auto type : kRepoTypes) {
+    auto flights = infrastructure::make_flight_repository(type);
+    const auto f = make_flight(domain::FlightId{1});
+    flights->upsert(f);
+
+    // Every group shares seat 5C; each group also spans two 64-bit words (rows 1 and 10).
+    std::atomic<int> winners{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+      threads.emplace_back([&, t] {
+        const std::vector<domain::Seat> group{{1, static_cast<char>('A' + t % 6)},
+                                              {5, 'C'},
+                                              {10, static_cast<char>('A' + t % 6)}};
+        if (flights->try_book_seats(f.id(), group)) winners.fetch_add(1);
+      });
+    }
+    for (auto& th : threads) th.join();
+
+    EXPECT_EQ(winners.load(), 1);
+    EXPECT_EQ(flights->get(f.id())->booked_count(), 3u);
+  }
+}
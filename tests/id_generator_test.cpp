@@ -0,0 +1,142 @@
+#include "flight/infrastructure/atomic_id_generator.hpp"
+#include "flight/infrastructure/snowflake_id_generator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace flight;
+using infrastructure::SnowflakeIdGenerator;
+
+namespace {
+
+class FakeClock final : public application::IClock {
+public:
+  std::chrono::system_clock::time_point now() const override { return now_; }
+  void set(std::chrono::system_clock::time_point t) { now_ = t; }
+
+private:
+  std::chrono::system_clock::time_point now_{std::chrono::sys_days{std::chrono::year{2026} / 3 / 1}};
+};
+
+} // namespace
+
+TEST(AtomicIdGenerator, LeasedBlocksAreUniqueAcrossThreadsAndIncreasingWithinEach) {
+  infrastructure::AtomicIdGenerator ids{100, 1, 1, /*block_size*/ 64};
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 10000;
+  std::vector<std::vector<std::uint64_t>> seen(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kPerThread; ++i) seen[t].push_back(ids.next_flight_id().value());
+    });
+  }
+  for (auto& th : threads) th.join();
+
+  std::set<std::uint64_t> all;
+  for (const auto& per_thread : seen) {
+    EXPECT_TRUE(std::is_sorted(per_thread.begin(), per_thread.end()));
+    EXPECT_GE(per_thread.front(), 100u);
+    all.insert(per_thread.begin(), per_thread.end());
+  }
+  EXPECT_EQ(all.size(), static_cast<std::size_t>(kThreads * kPerThread));
+
+  // A second generator on the same thread gets its own leases, starting from its own first id.
+  infrastructure::AtomicIdGenerator other{5000000, 1, 1, 64};
+  EXPECT_EQ(other.next_flight_id().value(), 5000000u);
+  EXPECT_EQ(ids.next_reservation_id().value(), 1u);
+  EXPECT_EQ(ids.next_reservation_id().value(), 2u);
+  EXPECT_THROW(infrastructure::AtomicIdGenerator(1, 1, 1, 0), std::invalid_argument);
+}
+
+TEST(SnowflakeIdGenerator, IdsAreTimeOrderedAndCarryTheNodeId) {
+  FakeClock clock;
+  SnowflakeIdGenerator ids{37, clock};
+  const auto t0 = clock.now();
+
+  const auto a = ids.next_flight_id().value();
+  const auto b = ids.next_flight_id().value();
+  EXPECT_LT(a, b);
+  const auto parts = SnowflakeIdGenerator::decode(b);
+  EXPECT_EQ(parts.time, t0);
+  EXPECT_EQ(parts.node_id, 37u);
+  EXPECT_EQ(parts.sequence, 1u);
+
+  // Sequences are independent; a later millisecond restarts the sequence.
+  EXPECT_EQ(SnowflakeIdGenerator::decode(ids.next_order_id().value()).sequence, 0u);
+  clock.set(t0 + std::chrono::milliseconds(5));
+  const auto c = ids.next_flight_id().value();
+  EXPECT_GT(c, b);
+  EXPECT_EQ(SnowflakeIdGenerator::decode(c).time, t0 + std::chrono::milliseconds(5));
+  EXPECT_EQ(SnowflakeIdGenerator::decode(c).sequence, 0u);
+
+  // Another node at the same instant never collides.
+  SnowflakeIdGenerator other{38, clock};
+  EXPECT_NE(other.next_flight_id().value(), ids.next_flight_id().value());
+  EXPECT_THROW(SnowflakeIdGenerator(SnowflakeIdGenerator::kMaxNodeId + 1, clock), std::invalid_argument);
+}
+
+TEST(SnowflakeIdGenerator, StaysIncreasingWhenTheClockStepsBackOrTheSequenceOverflows) {
+  FakeClock clock;
+  SnowflakeIdGenerator ids{1023, clock};
+  const auto t0 = clock.now();
+
+  std::uint64_t prev = 0;
+  for (int i = 0; i < 5000; ++i) { // more than 4096 ids within one millisecond
+    const auto id = ids.next_reservation_id().value();
+    ASSERT_GT(id, prev);
+    ASSERT_EQ(SnowflakeIdGenerator::decode(id).node_id, 1023u);
+    prev = id;
+  }
+  EXPECT_EQ(SnowflakeIdGenerator::decode(prev).time, t0 + std::chrono::milliseconds(1));
+
+  clock.set(t0 - std::chrono::seconds(3));
+  const auto back = ids.next_reservation_id().value();
+  EXPECT_GT(back, prev);
+  EXPECT_EQ(SnowflakeIdGenerator::decode(back).node_id, 1023u);
+}
+
+TEST(SnowflakeIdGenerator, ThreadsLeaseSequenceNumbersOfTheCurrentMillisecond) {
+  FakeClock clock;
+  SnowflakeIdGenerator ids{7, clock};
+  const auto t0 = clock.now();
+
+  EXPECT_EQ(SnowflakeIdGenerator::decode(ids.next_flight_id().value()).sequence, 0u);
+  std::uint64_t other = 0;
+  std::thread([&] { other = ids.next_flight_id().value(); }).join();
+  EXPECT_EQ(SnowflakeIdGenerator::decode(other).sequence, SnowflakeIdGenerator::kLeaseSize); // after this lease
+  EXPECT_EQ(SnowflakeIdGenerator::decode(ids.next_flight_id().value()).sequence, 1u);       // still local
+
+  // A new millisecond ends the lease, so ids keep following the clock.
+  clock.set(t0 + std::chrono::milliseconds(1));
+  const auto next = SnowflakeIdGenerator::decode(ids.next_flight_id().value());
+  EXPECT_EQ(next.time, t0 + std::chrono::milliseconds(1));
+  EXPECT_EQ(next.sequence, 0u);
+}
+
+TEST(SnowflakeIdGenerator, ConcurrentCallersNeverShareAnId) {
+  FakeClock clock; // frozen, so every thread competes for the same millisecond's sequence
+  SnowflakeIdGenerator ids{7, clock};
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 5000;
+  std::vector<std::vector<std::uint64_t>> seen(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kPerThread; ++i) seen[t].push_back(ids.next_order_id().value());
+    });
+  }
+  for (auto& th : threads) th.join();
+  std::set<std::uint64_t> all;
+  for (const auto& per_thread : seen) {
+    EXPECT_TRUE(std::is_sorted(per_thread.begin(), per_thread.end()));
+    all.insert(per_thread.begin(), per_thread.end());
+  }
+  EXPECT_EQ(all.size(), static_cast<std::size_t>(kThreads * kPerThread));
+}
@@ -0,0 +1,149 @@
+#include "flight/infrastructure/in_memory_flight_repository.hpp"
+#include "flight/infrastructure/lock_free_flight_repository.hpp"
+#include "flight/infrastructure/route_index.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <vector>
+
+using namespace flight;
+
+namespace {
+
+const auto kBase = std::chrono::system_clock::time_point{std::chrono::hours(24 * 20000)};
+
+// Departs `id` hours after kBase unless given explicitly, so departure order matches id order by default.
+domain::Flight make_flight(std::uint64_t id, const char* origin, const char* destination,
+                           std::optional<domain::Flight::time_point> departure = std::nullopt) {
+  return domain::Flight(domain::FlightId{id}, domain::AirportCode(origin), domain::AirportCode(destination),
+                        departure.value_or(kBase + std::chrono::hours(id)), 10, 6);
+}
+
+std::vector<std::uint64_t> search_ids(const application::IFlightRepository& repo,
+                                      const application::FlightSearchCriteria& criteria) {
+  std::vector<std::uint64_t> ids;
+  for (const auto& f : repo.search(criteria)) {
+    ids.push_back(f.id().value());
+  }
+  return ids;
+}
+
+std::vector<std::uint64_t> search_ids(const application::IFlightRepository& repo, const char* origin,
+                                      const char* destination) {
+  return search_ids(repo, {domain::AirportCode(origin), domain::AirportCode(destination)});
+}
+
+std::vector<std::unique_ptr<application::IFlightRepository>> in_memory_repositories() {
+  std::vector<std::unique_ptr<application::IFlightRepository>> repos;
+  repos.push_back(std::make_unique<infrastructure::InMemoryFlightRepository>());
+  repos.push_back(std::make_unique<infrastructure::LockFreeFlightRepository>());
+  return repos;
+}
+
+} // namespace
+
+TEST(InMemoryFlightRepositorySearch, RouteIndexReturnsMatchesInDepartureOrder) {
+  for (const auto& repo : in_memory_repositories()) {
+    repo->upsert(make_flight(7, "WAW", "FRA"));
+    repo->upsert(make_flight(3, "WAW", "FRA"));
+    repo->upsert(make_flight(5, "WAW", "CDG"));
+    repo->upsert(make_flight(1, "WAW", "FRA"));
+
+    EXPECT_EQ(search_ids(*repo, "WAW", "FRA"), (std::vector<std::uint64_t>{1, 3, 7}));
+    EXPECT_EQ(search_ids(*repo, "WAW", "CDG"), (std::vector<std::uint64_t>{5}));
+    EXPECT_TRUE(search_ids(*repo, "FRA", "WAW").empty());
+  }
+}
+
+TEST(InMemoryFlightRepositorySearch, DepartureWindowAndLimit) {
+  for (const auto& repo : in_memory_repositories()) {
+    // Ids deliberately out of departure order; 4 and 5 share a departure (ties break by id).
+    repo->upsert(make_flight(5, "WAW", "FRA", kBase + std::chrono::hours(30)));
+    repo->upsert(make_flight(1, "WAW", "FRA", kBase + std::chrono::hours(50)));
+    repo->upsert(make_flight(4, "WAW", "FRA", kBase + std::chrono::hours(30)));
+    repo->upsert(make_flight(9, "WAW", "FRA", kBase + std::chrono::hours(10)));
+    repo->upsert(make_flight(2, "WAW", "FRA", kBase + std::chrono::hours(75)));
+
+    application::FlightSearchCriteria c{domain::AirportCode("WAW"), domain::AirportCode("FRA")};
+    EXPECT_EQ(search_ids(*repo, c), (std::vector<std::uint64_t>{9, 4, 5, 1, 2}));
+
+    c.departure_from = kBase + std::chrono::hours(24);
+    c.departure_to = kBase + std::chrono::hours(48 + 2);
+    EXPECT_EQ(search_ids(*repo, c), (std::vector<std::uint64_t>{4, 5}));
+
+    c.departure_to.reset();
+    c.limit = 3;
+    EXPECT_EQ(search_ids(*repo, c), (std::vector<std::uint64_t>{4, 5, 1}));
+    EXPECT_EQ(repo->search_summaries(c).size(), 3u);
+
+    // Moving a flight's departure re-sorts it.
+    repo->upsert(make_flight(2, "WAW", "FRA", kBase + std::chrono::hours(25)));
+    EXPECT_EQ(search_ids(*repo, c), (std::vector<std::uint64_t>{2, 4, 5}));
+  }
+}
+
+TEST(InMemoryFlightRepositorySearch, LimitCountsOnlyCurrentEntries) {
+  // Mid-move, flight 1 is indexed at both its old and its new departure; the stale entry comes first and must
+  // not use up the limit.
+  const auto moved = make_flight(1, "WAW", "FRA", kBase + std::chrono::hours(5));
+  const auto other = make_flight(2, "WAW", "FRA", kBase + std::chrono::hours(3));
+  infrastructure::RouteIndex index;
+  index.insert(make_flight(1, "WAW", "FRA", kBase + std::chrono::hours(1)));
+  index.insert(moved);
+  index.insert(other);
+
+  application::FlightSearchCriteria c{domain::AirportCode("WAW"), domain::AirportCode("FRA")};
+  c.limit = 2;
+  util::EpochGuard pin;
+  const auto entries = index.find(c);
+  ASSERT_EQ(entries.size(), 3u);
+
+  std::vector<std::uint64_t> ids;
+  for (const auto& entry : entries) {
+    if (infrastructure::RouteIndex::limit_reached(ids.size(), c)) break;
+    const auto& current = entry.id == 1 ? moved : other;
+    if (infrastructure::RouteIndex::matches(entry, current, c)) ids.push_back(entry.id);
+  }
+  EXPECT_EQ(ids, (std::vector<std::uint64_t>{2, 1}));
+}
+
+TEST(InMemoryFlightRepositorySearch, UpsertMovesFlightBetweenRoutes) {
+  for (const auto& repo : in_memory_repositories()) {
+    repo->upsert(make_flight(1, "WAW", "FRA"));
+    repo->upsert(make_flight(2, "WAW", "FRA"));
+    ASSERT_TRUE(repo->try_book_seat(domain::FlightId{2}, domain::Seat{1, 'A'}));
+
+    repo->upsert(make_flight(2, "WAW", "CDG"));
+
+    EXPECT_EQ(search_ids(*repo, "WAW", "FRA"), (std::vector<std::uint64_t>{1}));
+    EXPECT_EQ(search_ids(*repo, "WAW", "CDG"), (std::vector<std::uint64_t>{2}));
+
+    repo->upsert(make_flight(1, "WAW", "FRA")); // same route, replaced in place
+    EXPECT_EQ(search_ids(*repo, "WAW", "FRA"), (std::vector<std::uint64_t>{1}));
+  }
+}
+
+TEST(InMemoryFlightRepositorySearch, SummariesAndVisitorsSeeCurrentSeatState) {
+  for (const auto& repo : in_memory_repositories()) {
+    repo->upsert(make_flight(1, "WAW", "FRA"));
+    repo->upsert(make_flight(2, "WAW", "FRA"));
+    ASSERT_TRUE(repo->try_book_seat(domain::FlightId{2}, domain::Seat{1, 'A'}));
+
+    const auto summaries = repo->search_summaries({domain::AirportCode("WAW"), domain::AirportCode("FRA")});
+    ASSERT_EQ(summaries.size(), 2u);
+    EXPECT_EQ(summaries[0].id, domain::FlightId{1});
+    EXPECT_EQ(summaries[0].available, 60u);
+    EXPECT_EQ(summaries[1].id, domain::FlightId{2});
+    EXPECT_EQ(summaries[1].capacity, 60u);
+    EXPECT_EQ(summaries[1].available, 59u);
+
+    bool booked = false;
+    EXPECT_TRUE(repo->visit(domain::FlightId{2},
+                            [&](const domain::Flight& f) { booked = f.is_booked(domain::Seat{1, 'A'}); }));
+    EXPECT_TRUE(booked);
+    EXPECT_FALSE(repo->visit(domain::FlightId{99}, [](const domain::Flight&) { FAIL(); }));
+  }
+}
@@ -0,0 +1,48 @@
+#include "flight/infrastructure/in_memory_reservation_repository.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace flight;
+
+namespace {
+
+domain::Reservation make_reservation(std::uint64_t id, std::uint64_t order, std::uint64_t flight, char letter) {
+  return domain::Reservation(domain::ReservationId{id}, domain::OrderId{order}, domain::FlightId{flight},
+                             domain::Seat{1, letter}, std::chrono::system_clock::now());
+}
+
+std::vector<std::uint64_t> ids_of(const std::vector<domain::Reservation>& list) {
+  std::vector<std::uint64_t> ids;
+  for (const auto& r : list) ids.push_back(r.id().value());
+  return ids;
+}
+
+} // namespace
+
+TEST(InMemoryReservationRepository, IndexesByOrderAndFlight) {
+  infrastructure::InMemoryReservationRepository repo;
+  repo.add(make_reservation(1, /*order*/ 10, /*flight*/ 100, 'A'));
+  repo.add(make_reservation(2, 20, 100, 'B'));
+  repo.add_many({make_reservation(3, 10, 200, 'A'), make_reservation(4, 10, 100, 'C')});
+
+  EXPECT_EQ(ids_of(repo.list_by_order(domain::OrderId{10})), (std::vector<std::uint64_t>{1, 3, 4}));
+  EXPECT_EQ(ids_of(repo.list_by_order(domain::OrderId{20})), (std::vector<std::uint64_t>{2}));
+  EXPECT_TRUE(repo.list_by_order(domain::OrderId{30}).empty());
+  EXPECT_EQ(ids_of(repo.list_by_flight(domain::FlightId{100})), (std::vector<std::uint64_t>{1, 2, 4}));
+  EXPECT_EQ(ids_of(repo.list_by_flight(domain::FlightId{200})), (std::vector<std::uint64_t>{3}));
+}
+
+TEST(InMemoryReservationRepository, ReplacingReservationMovesIndexEntries) {
+  infrastructure::InMemoryReservationRepository repo;
+  repo.add(make_reservation(1, 10, 100, 'A'));
+  repo.add(make_reservation(1, 20, 200, 'A'));
+
+  EXPECT_TRUE(repo.list_by_order(domain::OrderId{10}).empty());
+  EXPECT_TRUE(repo.list_by_flight(domain::FlightId{100}).empty());
+  EXPECT_EQ(ids_of(repo.list_by_order(domain::OrderId{20})), (std::vector<std::uint64_t>{1}));
+  EXPECT_EQ(ids_of(repo.list_by_flight(domain::FlightId{200})), (std::vector<std::uint64_t>{1}));
+}
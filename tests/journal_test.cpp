@@ -0,0 +1,364 @@
+#include <gtest/gtest.h>
+
+#include "flight/application/booking_service.hpp"
+#include "flight/application/seat_hold_service.hpp"
+#include "flight/domain/airport_code.hpp"
+#include "flight/infrastructure/atomic_id_generator.hpp"
+#include "flight/infrastructure/catalog_snapshot.hpp"
+#include "flight/infrastructure/in_memory_flight_repository.hpp"
+#include "flight/infrastructure/in_memory_reservation_repository.hpp"
+#include "flight/infrastructure/journaled_repositories.hpp"
+#include "flight/infrastructure/lock_free_flight_repository.hpp"
+#include "flight/infrastructure/system_clock.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+using namespace flight::domain;
+using namespace flight::domain::literals;
+using flight::infrastructure::JournaledRepositories;
+using flight::infrastructure::JournalOptions;
+
+namespace {
+
+// Unique journal path under the temp directory; removed on exit.
+class TempJournal {
+public:
+  TempJournal()
+      : path_(std::filesystem::temp_directory_path() /
+              ("flight_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) +
+               ".journal")) {}
+  ~TempJournal() {
+    std::error_code ec;
+    std::filesystem::remove(path_, ec);
+    std::filesystem::remove(path_.string() + ".tmp", ec);
+  }
+
+  JournalOptions options() const {
+    JournalOptions o;
+    o.path = path_.string();
+    return o;
+  }
+
+private:
+  std::filesystem::path path_;
+};
+
+JournaledRepositories open(const JournalOptions& options, bool lock_free = false) {
+  std::unique_ptr<flight::application::IFlightRepository> flights;
+  if (lock_free) {
+    flights = std::make_unique<flight::infrastructure::LockFreeFlightRepository>();
+  } else {
+    flights = std::make_unique<flight::infrastructure::InMemoryFlightRepository>();
+  }
+  return flight::infrastructure::make_journaled_repositories(
+      std::move(flights), std::make_unique<flight::infrastructure::InMemoryReservationRepository>(), options);
+}
+
+Flight make_flight(std::uint64_t id) {
+  return Flight(FlightId{id}, "WAW"_iata, "FRA"_iata, std::chrono::system_clock::now() + std::chrono::hours(id), 10, 6);
+}
+
+} // namespace
+
+TEST(BookingJournal, ReplayRestoresFlightsSeatsAndReservations) {
+  TempJournal journal;
+  const auto created = std::chrono::system_clock::now();
+  {
+    auto repos = open(journal.options());
+    EXPECT_EQ(repos.journal->recovery().records, 0u);
+    repos.flights->upsert(make_flight(1));
+    repos.flights->upsert(make_flight(2));
+    repos.flights->upsert_many({make_flight(3), make_flight(4)}); // one batch record
+    ASSERT_TRUE(repos.flights->try_book_seat(FlightId{1}, Seat{1, 'A'}));
+    ASSERT_TRUE(repos.flights->try_book_seats(FlightId{1}, std::vector<Seat>{{2, 'A'}, {2, 'B'}}));
+    ASSERT_TRUE(repos.flights->book_any_seat(FlightId{2}).has_value());
+    ASSERT_EQ(repos.flights->book_adjacent_seats(FlightId{2}, 3).size(), 3u);
+    repos.flights->release_seat(FlightId{1}, Seat{2, 'B'});
+    EXPECT_FALSE(repos.flights->try_book_seat(FlightId{1}, Seat{1, 'A'})); // failures are not journaled
+    repos.reservations->add(Reservation(ReservationId{7}, OrderId{3}, FlightId{1}, Seat{1, 'A'}, created));
+  }
+
+  auto repos = open(journal.options(), /*lock_free*/ true);
+  const auto& recovery = repos.journal->recovery();
+  EXPECT_EQ(recovery.flights, 4u);
+  EXPECT_EQ(recovery.reservations, 1u);
+  EXPECT_EQ(recovery.max_flight_id, 4u);
+  EXPECT_EQ(recovery.max_reservation_id, 7u);
+  EXPECT_EQ(recovery.max_order_id, 3u);
+
+  const auto f1 = repos.flights->get(FlightId{1});
+  ASSERT_TRUE(f1.has_value());
+  EXPECT_TRUE(f1->is_booked(Seat{1, 'A'}));
+  EXPECT_TRUE(f1->is_booked(Seat{2, 'A'}));
+  EXPECT_FALSE(f1->is_booked(Seat{2, 'B'}));
+  EXPECT_EQ(repos.flights->available_count(FlightId{2}), 60u - 4u);
+  EXPECT_EQ(repos.flights->available_count(FlightId{4}), 60u);
+
+  const auto r = repos.reservations->get(ReservationId{7});
+  ASSERT_TRUE(r.has_value());
+  EXPECT_EQ(r->seat(), (Seat{1, 'A'}));
+  EXPECT_EQ(std::chrono::duration_cast<std::chrono::nanoseconds>(r->created_at() - created).count(), 0);
+}
+
+TEST(BookingJournal, TornTailIsDroppedOnReplay) {
+  TempJournal journal;
+  {
+    auto repos = open(journal.options());
+    repos.flights->upsert(make_flight(1));
+    ASSERT_TRUE(repos.flights->try_book_seat(FlightId{1}, Seat{3, 'C'}));
+  }
+  const auto intact = std::filesystem::file_size(journal.options().path);
+  {
+    // A crash in the middle of a write leaves a partial record behind.
+    std::ofstream out(journal.options().path, std::ios::binary | std::ios::app);
+    out.write("\x20\x00\x00\x00\x12\x34", 6);
+  }
+
+  {
+    auto repos = open(journal.options());
+    EXPECT_EQ(repos.journal->recovery().records, 2u);
+    EXPECT_EQ(std::filesystem::file_size(journal.options().path), intact);
+    ASSERT_TRUE(repos.flights->try_book_seat(FlightId{1}, Seat{3, 'D'}));
+  }
+  auto repos = open(journal.options());
+  EXPECT_EQ(repos.journal->recovery().records, 3u);
+  EXPECT_EQ(repos.flights->available_count(FlightId{1}), 58u);
+}
+
+TEST(BookingJournal, BookingAndItsReservationAreOneRecord) {
+  TempJournal journal;
+  {
+    auto repos = open(journal.options());
+    repos.flights->upsert(make_flight(1));
+    flight::infrastructure::AtomicIdGenerator ids;
+    flight::infrastructure::SystemClock clock;
+    flight::application::BookingService booking{*repos.flights, *repos.reservations, ids, clock,
+                                                repos.journal.get()};
+    ASSERT_TRUE(booking.book_seat({FlightId{1}, OrderId{1}, Seat{1, 'A'}}).success);
+    ASSERT_TRUE(booking.book_seats({FlightId{1}, OrderId{1}, {Seat{2, 'A'}, Seat{2, 'B'}}}).success);
+    EXPECT_FALSE(booking.book_seat({FlightId{1}, OrderId{2}, Seat{1, 'A'}}).success); // nothing to journal
+  }
+  {
+    auto repos = open(journal.options());
+    EXPECT_EQ(repos.journal->recovery().records, 3u); // the upsert plus one record per booking
+    EXPECT_EQ(repos.journal->recovery().reservations, 3u);
+    EXPECT_EQ(repos.flights->available_count(FlightId{1}), 57u);
+  }
+
+  // A crash part way through the last booking's write loses its seats and its reservations together.
+  const auto size = std::filesystem::file_size(journal.options().path);
+  std::filesystem::resize_file(journal.options().path, size - 1);
+  auto repos = open(journal.options());
+  EXPECT_EQ(repos.journal->recovery().records, 2u);
+  EXPECT_EQ(repos.reservations->list_by_order(OrderId{1}).size(), 1u);
+  EXPECT_EQ(repos.flights->available_count(FlightId{1}), 59u);
+}
+
+TEST(BookingJournal, BookingBatchAcrossFlightsIsOneRecord) {
+  TempJournal journal;
+  {
+    auto repos = open(journal.options());
+    repos.flights->upsert(make_flight(1));
+    repos.flights->upsert(make_flight(2));
+    // Straight through the repository, the batch is its own group.
+    const std::vector<flight::application::SeatBookingRequest> requests{{FlightId{1}, Seat{9, 'A'}},
+                                                                        {FlightId{2}, Seat{9, 'A'}}};
+    EXPECT_EQ(repos.flights->try_book_seat_batch(requests), (std::vector<bool>{true, true}));
+
+    flight::infrastructure::AtomicIdGenerator ids;
+    flight::infrastructure::SystemClock clock;
+    flight::application::BookingService booking{*repos.flights, *repos.reservations, ids, clock,
+                                                repos.journal.get()};
+    const std::vector<flight::application::BookSeatCommand> commands{{FlightId{1}, OrderId{1}, Seat{1, 'A'}},
+                                                                     {FlightId{2}, OrderId{1}, Seat{1, 'A'}},
+                                                                     {FlightId{1}, OrderId{1}, Seat{9, 'A'}},
+                                                                     {FlightId{2}, OrderId{1}, Seat{2, 'B'}}};
+    const auto results = booking.book_seat_batch(commands);
+    EXPECT_EQ(std::count_if(results.begin(), results.end(), [](const auto& r) { return r.success; }), 3);
+  }
+  {
+    auto repos = open(journal.options());
+    EXPECT_EQ(repos.journal->recovery().records, 4u); // two upserts plus one record per batch
+    EXPECT_EQ(repos.journal->recovery().reservations, 3u);
+    EXPECT_EQ(repos.flights->available_count(FlightId{1}), 58u);
+    EXPECT_EQ(repos.flights->available_count(FlightId{2}), 57u);
+  }
+
+  // A crash part way through the service's batch loses every flight's seats and the reservations together.
+  const auto size = std::filesystem::file_size(journal.options().path);
+  std::filesystem::resize_file(journal.options().path, size - 1);
+  auto repos = open(journal.options());
+  EXPECT_EQ(repos.journal->recovery().records, 3u);
+  EXPECT_TRUE(repos.reservations->list_by_order(OrderId{1}).empty());
+  EXPECT_EQ(repos.flights->available_count(FlightId{1}), 59u);
+  EXPECT_EQ(repos.flights->available_count(FlightId{2}), 59u);
+}
+
+TEST(BookingJournal, CheckpointCompactsHistory) {
+  TempJournal journal;
+  {
+    auto repos = open(journal.options());
+    repos.flights->upsert(make_flight(1));
+    for (int i = 0; i < 50; ++i) {
+      ASSERT_TRUE(repos.flights->try_book_seat(FlightId{1}, Seat{1, 'A'}));
+      repos.flights->release_seat(FlightId{1}, Seat{1, 'A'});
+    }
+    ASSERT_TRUE(repos.flights->try_book_seat(FlightId{1}, Seat{4, 'F'}));
+    repos.reservations->add(
+        Reservation(ReservationId{1}, OrderId{1}, FlightId{1}, Seat{4, 'F'}, std::chrono::system_clock::now()));
+
+    const auto before = repos.journal->size_bytes();
+    repos.journal->checkpoint();
+    EXPECT_LT(repos.journal->size_bytes(), before);
+    ASSERT_TRUE(repos.flights->try_book_seat(FlightId{1}, Seat{5, 'F'})); // appends after the checkpoint
+  }
+
+  auto repos = open(journal.options());
+  EXPECT_EQ(repos.journal->recovery().records, 3u); // upsert + reservations + one booking
+  const auto f = repos.flights->get(FlightId{1});
+  ASSERT_TRUE(f.has_value());
+  EXPECT_TRUE(f->is_booked(Seat{4, 'F'}));
+  EXPECT_TRUE(f->is_booked(Seat{5, 'F'}));
+  EXPECT_FALSE(f->is_booked(Seat{1, 'A'}));
+  EXPECT_EQ(repos.reservations->list_by_flight(FlightId{1}).size(), 1u);
+}
+
+TEST(BookingJournal, ConcurrentBookingsAreAllDurable) {
+  TempJournal journal;
+  constexpr int kThreads = 8;
+  constexpr int kSeatsPerThread = 20;
+  {
+    auto repos = open(journal.options());
+    for (std::uint64_t id = 1; id <= 4; ++id) repos.flights->upsert(make_flight(id));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&, t] {
+        for (int i = 0; i < kSeatsPerThread; ++i) {
+          EXPECT_TRUE(repos.flights->book_any_seat(FlightId{static_cast<std::uint64_t>(t % 4 + 1)}).has_value());
+        }
+      });
+    }
+    for (auto& th : threads) th.join();
+  }
+
+  auto repos = open(journal.options());
+  std::uint32_t booked = 0;
+  for (std::uint64_t id = 1; id <= 4; ++id) booked += 60u - *repos.flights->available_count(FlightId{id});
+  EXPECT_EQ(booked, static_cast<std::uint32_t>(kThreads * kSeatsPerThread));
+}
+
+TEST(BookingJournal, FailedSyncStopsServingUnjournaledState) {
+  TempJournal journal;
+  const Seat seat{1, 'A'};
+  {
+    auto repos = open(journal.options());
+    repos.flights->upsert(make_flight(1));
+
+    // Cap the file size at what is already written, so the next journal write fails (EFBIG).
+    const auto size = std::filesystem::file_size(journal.options().path);
+    rlimit saved{};
+    ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &saved), 0);
+    const auto previous_handler = std::signal(SIGXFSZ, SIG_IGN);
+    rlimit capped = saved;
+    capped.rlim_cur = static_cast<rlim_t>(size);
+    ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &capped), 0);
+    EXPECT_ANY_THROW(repos.flights->try_book_seat(FlightId{1}, seat));
+    ::setrlimit(RLIMIT_FSIZE, &saved);
+    std::signal(SIGXFSZ, previous_handler);
+
+    // The booking is in memory but not on disk: nothing may observe or build on it.
+    EXPECT_ANY_THROW(repos.flights->get(FlightId{1}));
+    EXPECT_ANY_THROW(repos.flights->try_book_seat(FlightId{1}, Seat{1, 'B'}));
+    EXPECT_ANY_THROW(repos.reservations->list_by_flight(FlightId{1}));
+  }
+
+  auto reopened = open(journal.options());
+  const auto got = reopened.flights->get(FlightId{1});
+  ASSERT_TRUE(got.has_value());
+  EXPECT_FALSE(got->is_booked(seat));
+  EXPECT_TRUE(reopened.flights->try_book_seat(FlightId{1}, seat));
+}
+
+TEST(BookingJournal, SnapshotWrittenWithTheJournalBecomesItsBase) {
+  TempJournal journal;
+  const auto snapshot_path = journal.options().path + ".snap";
+  const auto reopen = [&](bool with_snapshot = true) {
+    auto options = journal.options();
+    auto flights = std::make_unique<flight::infrastructure::InMemoryFlightRepository>();
+    if (with_snapshot) {
+      options.snapshot = std::make_shared<const flight::infrastructure::CatalogSnapshot>(snapshot_path);
+      options.snapshot->load_into(*flights);
+    }
+    return flight::infrastructure::make_journaled_repositories(
+        std::move(flights), std::make_unique<flight::infrastructure::InMemoryReservationRepository>(), options);
+  };
+  {
+    // The base catalog comes from a snapshot, so the journal never sees the flights themselves.
+    flight::infrastructure::InMemoryFlightRepository base;
+    base.upsert(make_flight(1));
+    base.upsert(make_flight(2));
+    flight::infrastructure::CatalogSnapshot::write(snapshot_path, base);
+  }
+  {
+    auto repos = reopen();
+    ASSERT_TRUE(repos.flights->try_book_seat(FlightId{1}, Seat{1, 'A'}));
+    repos.reservations->add(
+        Reservation(ReservationId{1}, OrderId{1}, FlightId{1}, Seat{1, 'A'}, std::chrono::system_clock::now()));
+    EXPECT_EQ(repos.journal->write_snapshot(snapshot_path), 2u);
+  }
+  {
+    // The snapshot already holds 1A; the journal keeps only its base and the reservation, no flight.
+    auto repos = reopen();
+    EXPECT_EQ(repos.journal->recovery().records, 2u);
+    EXPECT_EQ(repos.journal->recovery().flights, 0u);
+    EXPECT_EQ(repos.reservations->list_by_flight(FlightId{1}).size(), 1u);
+    ASSERT_TRUE(repos.flights->try_book_seat(FlightId{2}, Seat{2, 'A'}));
+    repos.journal->checkpoint(); // keeps the base: only flight 2 differs from it
+    ASSERT_TRUE(repos.flights->try_book_seat(FlightId{1}, Seat{3, 'A'}));
+  }
+  {
+    auto repos = reopen();
+    EXPECT_EQ(repos.journal->recovery().records, 4u); // base, flight 2, the reservation, 3A
+    const auto f = repos.flights->get(FlightId{1});
+    ASSERT_TRUE(f.has_value());
+    EXPECT_TRUE(f->is_booked(Seat{1, 'A'}));
+    EXPECT_TRUE(f->is_booked(Seat{3, 'A'}));
+    EXPECT_EQ(f->available_count(), 58u);
+    EXPECT_EQ(repos.flights->available_count(FlightId{2}), 59u);
+  }
+
+  // The journal holds no flight it can replay without its base, nor on top of another snapshot.
+  EXPECT_THROW(reopen(/*with_snapshot*/ false), std::runtime_error);
+  {
+    flight::infrastructure::InMemoryFlightRepository other;
+    other.upsert(make_flight(1));
+    flight::infrastructure::CatalogSnapshot::write(snapshot_path, other);
+  }
+  EXPECT_THROW(reopen(), std::runtime_error);
+  std::filesystem::remove(snapshot_path);
+}
+
+TEST(BookingJournal, SeatHoldsAreRefusedSoNoHeldSeatOutlivesARestart) {
+  TempJournal journal;
+  flight::infrastructure::AtomicIdGenerator ids;
+  flight::infrastructure::SystemClock clock;
+  {
+    auto repos = open(journal.options());
+    repos.flights->upsert(make_flight(1));
+    EXPECT_TRUE(repos.flights->durable());
+    // A hold would journal its seat as booked but keep the hold itself in memory.
+    EXPECT_THROW(flight::application::SeatHoldService(*repos.flights, *repos.reservations, ids, clock),
+                 std::invalid_argument);
+  }
+  auto repos = open(journal.options());
+  EXPECT_EQ(repos.flights->available_count(FlightId{1}), 60u);
+}
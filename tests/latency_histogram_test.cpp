@@ -0,0 +1,41 @@
+#include "flight/util/latency_histogram.hpp"
+
+#include <gtest/gtest.h>
+
+using flight::util::LatencyHistogram;
+
+TEST(LatencyHistogram, BucketsCoverRangeWithBoundedError) {
+  for (std::uint64_t v : {0ull, 1ull, 15ull, 16ull, 17ull, 1000ull, 123456789ull, ~0ull}) {
+    const auto i = LatencyHistogram::bucket_of(v);
+    ASSERT_LT(i, LatencyHistogram::kBuckets);
+    const auto upper = LatencyHistogram::bucket_upper(i);
+    EXPECT_GE(upper, v);
+    EXPECT_LE(upper - v, v / 8) << v; // within one sub-bucket
+  }
+}
+
+TEST(LatencyHistogram, PercentilesAndIntervalDeltas) {
+  LatencyHistogram h;
+  for (std::uint64_t v = 1; v <= 1000; ++v) h.record(v);
+
+  LatencyHistogram::Snapshot first;
+  h.add_to(first);
+  EXPECT_EQ(first.total(), 1000u);
+  EXPECT_NEAR(static_cast<double>(first.percentile(0.5)), 500.0, 500.0 / 8);
+  EXPECT_NEAR(static_cast<double>(first.percentile(0.99)), 990.0, 990.0 / 8);
+
+  for (int i = 0; i < 10; ++i) h.record(5'000'000);
+  LatencyHistogram::Snapshot second;
+  h.add_to(second);
+  second -= first;
+  EXPECT_EQ(second.total(), 10u);
+  EXPECT_NEAR(static_cast<double>(second.percentile(0.5)), 5e6, 5e6 / 8);
+  EXPECT_EQ(LatencyHistogram::Snapshot{}.percentile(0.99), 0u);
+}
+
+TEST(LatencyHistogram, FormatsNanosecondsInReadableUnits) {
+  EXPECT_EQ(flight::util::format_ns(850), "850ns");
+  EXPECT_EQ(flight::util::format_ns(9'999), "9999ns");
+  EXPECT_EQ(flight::util::format_ns(12'500), "12.5us");
+  EXPECT_EQ(flight::util::format_ns(3'200'000'000), "3200.0ms");
+}
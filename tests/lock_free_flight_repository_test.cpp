@@ -0,0 +1,128 @@
+#include "flight/application/booking_service.hpp"
+#include "flight/infrastructure/atomic_id_generator.hpp"
+#include "flight/infrastructure/flight_repository_factory.hpp"
+#include "flight/infrastructure/in_memory_reservation_repository.hpp"
+#include "flight/infrastructure/lock_free_flight_repository.hpp"
+#include "flight/infrastructure/system_clock.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace flight;
+
+TEST(LockFreeFlightRepository, OnlyOneThreadCanBookSameSeat) {
+  infrastructure::AtomicIdGenerator ids;
+  infrastructure::SystemClock clock;
+  auto flights_ptr = infrastructure::make_flight_repository(infrastructure::parse_flight_repo_type("lockfree"));
+  auto& flights = *flights_ptr;
+  infrastructure::InMemoryReservationRepository reservations;
+
+  const auto f = domain::Flight(ids.next_flight_id(), domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+                               std::chrono::system_clock::now(), 10, 6);
+  const auto flight_id = f.id();
+  flights.upsert(f);
+
+  application::BookingService booking{flights, reservations, ids, clock};
+  const auto order_id = ids.next_order_id();
+  const domain::Seat seat{1, 'A'};
+
+  std::atomic<int> success_count{0};
+  constexpr int kThreads = 16;
+
+  std::vector<std::thread> threads;
+  threads.reserve(kThreads);
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&] {
+      const auto res = booking.book_seat(application::BookSeatCommand{flight_id, order_id, seat});
+      if (res.success) {
+        success_count.fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  for (auto& t : threads) t.join();
+
+  EXPECT_EQ(success_count.load(), 1);
+  const auto list = reservations.list_by_order(order_id);
+  ASSERT_EQ(static_cast<int>(list.size()), 1);
+  EXPECT_EQ(list.front().seat(), seat);
+}
+
+TEST(LockFreeFlightRepository, EverySeatIsBookedExactlyOnceUnderContention) {
+  infrastructure::LockFreeFlightRepository flights;
+  // 11 x 26 = 286 seats: spans several words with a partial last word.
+  const auto f = domain::Flight(domain::FlightId{1}, domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+                               std::chrono::system_clock::now(), 11, 26);
+  flights.upsert(f);
+
+  std::atomic<int> success_count{0};
+  constexpr int kThreads = 8;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&] {
+      for (std::uint16_t row = 1; row <= 11; ++row) {
+        for (char letter = 'A'; letter <= 'Z'; ++letter) {
+          if (flights.try_book_seat(f.id(), domain::Seat{row, letter})) {
+            success_count.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+
+  EXPECT_EQ(success_count.load(), 286);
+  EXPECT_FALSE(flights.try_book_seat(f.id(), domain::Seat{12, 'A'}));
+
+  flights.release_seat(f.id(), domain::Seat{11, 'Z'});
+  const auto got = flights.get(f.id());
+  ASSERT_TRUE(got.has_value());
+  EXPECT_EQ(got->booked_count(), 285u);
+  EXPECT_FALSE(got->is_booked(domain::Seat{11, 'Z'}));
+  EXPECT_TRUE(flights.try_book_seat(f.id(), domain::Seat{11, 'Z'}));
+}
+
+TEST(LockFreeFlightRepository, SeatOperationsRunWhileTheCatalogIsRewritten) {
+  infrastructure::LockFreeFlightRepository flights;
+  const auto f = domain::Flight(domain::FlightId{1}, domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+                               std::chrono::system_clock::time_point{}, 11, 26);
+  flights.upsert(f);
+
+  // Other flights are re-imported (table growth, replaced entries, a route move) while seats are booked.
+  std::atomic<bool> done{false};
+  std::thread importer([&] {
+    int round = 0;
+    do {
+      std::vector<domain::Flight> batch;
+      for (std::uint64_t id = 2; id <= 201; ++id) {
+        batch.emplace_back(domain::FlightId{id}, domain::AirportCode("WAW"),
+                           domain::AirportCode(round % 2 == 0 ? "FRA" : "CDG"),
+                           std::chrono::system_clock::time_point{std::chrono::hours(id)}, 2, 2);
+      }
+      flights.upsert_many(std::move(batch));
+      ++round;
+    } while (!done.load());
+  });
+
+  int booked = 0;
+  for (std::uint16_t row = 1; row <= 11; ++row) {
+    for (char letter = 'A'; letter <= 'Z'; ++letter) {
+      if (flights.try_book_seat(f.id(), domain::Seat{row, letter})) ++booked;
+    }
+    const auto found = flights.search({domain::AirportCode("WAW"), domain::AirportCode("FRA")});
+    EXPECT_FALSE(found.empty());
+    for (const auto& g : found) EXPECT_EQ(g.destination(), domain::AirportCode("FRA"));
+  }
+  done.store(true);
+  importer.join();
+
+  EXPECT_EQ(booked, 286);
+  EXPECT_EQ(flights.available_count(f.id()), 0u);
+  EXPECT_EQ(flights.search_summaries({domain::AirportCode("WAW"), domain::AirportCode("FRA")}).size() +
+                flights.search_summaries({domain::AirportCode("WAW"), domain::AirportCode("CDG")}).size(),
+            201u);
+}
@@ -0,0 +1,106 @@
+#include "flight/application/flight_search_service.hpp"
+#include "flight/infrastructure/in_memory_flight_repository.hpp"
+#include "flight/infrastructure/in_memory_reservation_repository.hpp"
+#include "flight/infrastructure/lock_free_flight_repository.hpp"
+#include "flight/infrastructure/sqlite_flight_repository.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+using namespace flight;
+
+namespace {
+
+// Forwards to the heap and counts what passes through.
+class CountingResource final : public std::pmr::memory_resource {
+public:
+  std::size_t allocations{0};
+  std::size_t outstanding_bytes{0};
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++allocations;
+    outstanding_bytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+    outstanding_bytes -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+domain::Flight make_flight(std::uint64_t id) {
+  return domain::Flight(domain::FlightId{id}, domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+                        std::chrono::system_clock::time_point{std::chrono::hours(id)}, 30, 6);
+}
+
+} // namespace
+
+TEST(MemoryResource, SearchResultsLiveInTheCallersArena) {
+  infrastructure::InMemoryFlightRepository in_memory;
+  infrastructure::LockFreeFlightRepository lock_free;
+  infrastructure::SqliteFlightRepository sqlite;
+  for (application::IFlightRepository* repo :
+       std::vector<application::IFlightRepository*>{&in_memory, &lock_free, &sqlite}) {
+    for (std::uint64_t id = 1; id <= 5; ++id) repo->upsert(make_flight(id));
+    ASSERT_TRUE(repo->try_book_seat(domain::FlightId{3}, domain::Seat{2, 'C'}));
+    const application::FlightSearchCriteria criteria{domain::AirportCode("WAW"), domain::AirportCode("FRA")};
+
+    CountingResource upstream;
+    alignas(std::max_align_t) std::array<std::byte, 8192> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), &upstream);
+    application::FlightSearchService search{*repo};
+
+    const auto flights = search.search_flights(criteria, &arena);
+    const auto summaries = search.search(criteria, &arena);
+    EXPECT_EQ(upstream.allocations, 0u); // everything fit in the stack buffer
+
+    const auto expected = repo->search(criteria);
+    ASSERT_EQ(flights.size(), expected.size());
+    for (std::size_t i = 0; i < flights.size(); ++i) {
+      EXPECT_EQ(flights[i].id(), expected[i].id());
+      EXPECT_EQ(flights[i].seat_map(), expected[i].seat_map());
+      EXPECT_EQ(flights[i].get_allocator().resource(), &arena);
+      EXPECT_EQ(summaries[i].id, expected[i].id());
+      EXPECT_EQ(summaries[i].available, expected[i].available_count());
+    }
+    EXPECT_TRUE(flights[2].is_booked(domain::Seat{2, 'C'}));
+
+    // A copy leaves the arena, so it may outlive it.
+    const domain::Flight copy = flights[2];
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_TRUE(copy.is_booked(domain::Seat{2, 'C'}));
+  }
+}
+
+TEST(MemoryResource, InMemoryRepositoriesDrawNodesFromTheirPool) {
+  CountingResource upstream;
+  {
+    infrastructure::InMemoryFlightRepository flights(&upstream);
+    infrastructure::InMemoryReservationRepository reservations(&upstream);
+    for (std::uint64_t id = 1; id <= 200; ++id) {
+      flights.upsert(make_flight(id));
+      reservations.add(domain::Reservation(domain::ReservationId{id}, domain::OrderId{id % 7},
+                                           domain::FlightId{id}, domain::Seat{1, 'A'},
+                                           std::chrono::system_clock::time_point{}));
+    }
+    // The pools take memory from upstream in chunks, not one allocation per node.
+    EXPECT_GT(upstream.allocations, 0u);
+    EXPECT_LT(upstream.allocations, 200u);
+
+    flights.upsert(make_flight(1)); // replacing a flight reuses pooled storage
+    ASSERT_TRUE(flights.try_book_seat(domain::FlightId{1}, domain::Seat{1, 'A'}));
+    const auto got = flights.get(domain::FlightId{1});
+    ASSERT_TRUE(got.has_value());
+    EXPECT_EQ(got->get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(got->booked_count(), 1u);
+    EXPECT_EQ(reservations.list_by_order(domain::OrderId{3}).size(), 29u);
+  }
+  EXPECT_EQ(upstream.outstanding_bytes, 0u);
+}
@@ -0,0 +1,55 @@
+#include "flight/util/metrics.hpp"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+using flight::util::Metrics;
+
+TEST(Metrics, RegistrationIsIdempotentPerNameAndLabels) {
+  Metrics m;
+  const auto a = m.histogram("op_seconds", "op=\"get\"", "help");
+  const auto b = m.histogram("op_seconds", "op=\"get\"", "help");
+  const auto c = m.histogram("op_seconds", "op=\"search\"", "help");
+  EXPECT_EQ(a.index, b.index);
+  EXPECT_NE(a.index, c.index);
+  EXPECT_EQ(m.counter("ops_total", "", "help").index, m.counter("ops_total", "", "help").index);
+}
+
+TEST(Metrics, SnapshotAggregatesAllThreads) {
+  Metrics m;
+  const auto h = m.histogram("op_seconds", "", "help");
+  const auto c = m.counter("ops_total", "", "help");
+  auto work = [&] {
+    for (int i = 0; i < 1000; ++i) {
+      m.record(h, 100);
+      m.add(c);
+    }
+  };
+  std::thread t1(work), t2(work);
+  t1.join();
+  t2.join();
+
+  const auto snap = m.snapshot();
+  ASSERT_EQ(snap.histograms.size(), 1u);
+  EXPECT_EQ(snap.histograms[0].data.total(), 2000u);
+  EXPECT_EQ(snap.histograms[0].data.sum, 200'000u);
+  ASSERT_EQ(snap.counters.size(), 1u);
+  EXPECT_EQ(snap.counters[0].value, 2000u);
+}
+
+TEST(Metrics, PrometheusGroupsSeriesUnderOneHeader) {
+  Metrics m;
+  m.record(m.histogram("op_seconds", "op=\"get\"", "Op latency."), 1'000'000);
+  m.add(m.counter("ops_total", "", "Ops."), 3);
+  m.record(m.histogram("op_seconds", "op=\"search\"", "Op latency."), 2'000'000);
+
+  std::ostringstream out;
+  m.write_prometheus(out);
+  const auto text = out.str();
+  EXPECT_EQ(text.find("# TYPE op_seconds summary"), text.rfind("# TYPE op_seconds summary"));
+  EXPECT_NE(text.find("op_seconds{op=\"get\",quantile=\"0.99\"}"), std::string::npos);
+  EXPECT_NE(text.find("op_seconds_count{op=\"search\"} 1"), std::string::npos);
+  EXPECT_NE(text.find("# TYPE ops_total counter\nops_total 3\n"), std::string::npos);
+}
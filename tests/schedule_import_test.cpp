@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include "flight/domain/airport_code.hpp"
+#include "flight/infrastructure/in_memory_flight_repository.hpp"
+#include "flight/infrastructure/lock_free_flight_repository.hpp"
+#include "flight/infrastructure/schedule_import.hpp"
+#include "flight/infrastructure/sqlite_flight_repository.hpp"
+
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace flight::domain;
+using namespace flight::domain::literals;
+using flight::infrastructure::import_schedule;
+using flight::infrastructure::parse_schedule_row;
+using flight::infrastructure::ScheduleImportOptions;
+
+TEST(ScheduleImport, ParsesRowsAndRejectsMalformedOnes) {
+  const auto f = parse_schedule_row("42, WAW ,fra,2026-11-02T06:45Z,30,6");
+  EXPECT_EQ(f.id(), FlightId{42});
+  EXPECT_EQ(f.destination(), "FRA"_iata);
+  EXPECT_EQ(f.departure(), std::chrono::sys_days(std::chrono::year{2026} / 11 / 2) + std::chrono::hours(6) +
+                               std::chrono::minutes(45));
+  EXPECT_EQ(f.capacity(), 180u);
+  EXPECT_EQ(parse_schedule_row("1,WAW,FRA,2026-11-02 06:45:30,1,1").departure(),
+            parse_schedule_row("1,WAW,FRA,1793601930,1,1").departure());
+
+  for (const char* bad : {"1,WAW,FRA,2026-11-02T06:45Z,30", "1,WAW,FRA,2026-11-02T06:45Z,30,6,x",
+                          "0,WAW,FRA,2026-11-02T06:45Z,30,6", "x,WAW,FRA,2026-11-02T06:45Z,30,6",
+                          "1,WA1,FRA,2026-11-02T06:45Z,30,6", "1,WAW,FRA,2026-02-30T06:45Z,30,6",
+                          "1,WAW,FRA,tomorrow,30,6", "1,WAW,FRA,2026-11-02T06:45Z,70000,6",
+                          "1,WAW,FRA,2026-11-02T06:45Z,30,27"}) {
+    EXPECT_THROW(parse_schedule_row(bad), std::invalid_argument) << bad;
+  }
+}
+
+TEST(ScheduleImport, StreamsChunksInParallelAndReportsMalformedRows) {
+  std::ostringstream csv;
+  csv << "flight_id,origin,destination,departure,rows,seats_per_row\r\n";
+  for (int i = 1; i <= 2000; ++i) {
+    if (i % 500 == 0) {
+      csv << i << ",WAW,FRA,not-a-date,30,6\r\n";
+    } else {
+      csv << i << ",WAW," << (i % 2 ? "FRA" : "CDG") << ",2026-11-02T06:45Z," << (10 + i % 20) << ",6\r\n";
+    }
+    if (i == 1000) csv << "\n";
+  }
+  csv << "7,WAW,LHR,2026-12-01T00:00Z,10,4"; // a later row for the same flight wins; no trailing newline
+
+  flight::infrastructure::InMemoryFlightRepository repo;
+  std::istringstream in(csv.str());
+  ScheduleImportOptions options;
+  options.threads = 4;
+  options.chunk_bytes = 1000; // many chunks, most boundaries in the middle of a row
+  options.batch_size = 128;
+  options.max_errors = 3;
+  const auto result = import_schedule(in, repo, options);
+
+  EXPECT_EQ(result.rows, 2001u);
+  EXPECT_EQ(result.malformed, 4u);
+  EXPECT_EQ(result.imported, 1997u);
+  EXPECT_EQ(result.max_flight_id, 1999u);
+  EXPECT_GE(result.batches, 1997u / 128);
+  ASSERT_EQ(result.errors.size(), 3u);
+  EXPECT_EQ(result.errors[0].line, 501u);
+  EXPECT_EQ(result.errors[1].line, 1001u);
+  EXPECT_EQ(result.errors[2].line, 1502u); // after the blank line
+  EXPECT_NE(result.errors[0].message.find("departure"), std::string::npos);
+
+  EXPECT_FALSE(repo.get(FlightId{500}).has_value());
+  const auto f7 = repo.get(FlightId{7});
+  ASSERT_TRUE(f7.has_value());
+  EXPECT_EQ(f7->destination(), "LHR"_iata);
+  EXPECT_EQ(f7->capacity(), 40u);
+  EXPECT_EQ(repo.available_count(FlightId{1999}), (10u + 1999u % 20) * 6);
+}
+
+TEST(ScheduleImport, UpsertManyReplacesFlightsInEveryRepository) {
+  const auto departure = std::chrono::system_clock::now() + std::chrono::hours(3);
+  flight::infrastructure::InMemoryFlightRepository in_memory;
+  flight::infrastructure::LockFreeFlightRepository lock_free;
+  flight::infrastructure::SqliteFlightRepository sqlite;
+  for (flight::application::IFlightRepository* repo :
+       std::vector<flight::application::IFlightRepository*>{&in_memory, &lock_free, &sqlite}) {
+    repo->upsert(Flight(FlightId{1}, "WAW"_iata, "FRA"_iata, departure, 10, 6));
+    ASSERT_TRUE(repo->try_book_seat(FlightId{1}, Seat{1, 'A'}));
+    repo->upsert_many({Flight(FlightId{1}, "WAW"_iata, "CDG"_iata, departure, 10, 6),
+                       Flight(FlightId{2}, "WAW"_iata, "CDG"_iata, departure + std::chrono::hours(1), 20, 6)});
+    repo->upsert_many({});
+
+    const auto found = repo->search({"WAW"_iata, "CDG"_iata});
+    ASSERT_EQ(found.size(), 2u);
+    EXPECT_EQ(found[0].id(), FlightId{1});
+    EXPECT_EQ(found[1].capacity(), 120u);
+    EXPECT_TRUE(repo->search({"WAW"_iata, "FRA"_iata}).empty());
+  }
+}
@@ -0,0 +1,150 @@
+#include "flight/application/seat_hold_service.hpp"
+#include "flight/infrastructure/atomic_id_generator.hpp"
+#include "flight/infrastructure/in_memory_flight_repository.hpp"
+#include "flight/infrastructure/in_memory_reservation_repository.hpp"
+#include "flight/util/timer_wheel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace flight;
+using namespace std::chrono_literals;
+
+namespace {
+
+class FakeClock final : public application::IClock {
+public:
+  std::chrono::system_clock::time_point now() const override { return now_; }
+  void advance(std::chrono::system_clock::duration d) { now_ += d; }
+
+private:
+  std::chrono::system_clock::time_point now_{std::chrono::sys_days{std::chrono::year{2026} / 5 / 1}};
+};
+
+} // namespace
+
+TEST(TimerWheel, FiresEveryTimerOnItsTickAcrossAllLevels) {
+  util::TimerWheel<std::uint64_t> wheel(1000);
+  std::mt19937_64 rng(7);
+  std::vector<std::uint64_t> deadlines;
+  for (std::uint64_t i = 0; i < 5000; ++i) {
+    // Spread over all four levels, plus a few past the wheel's reach.
+    const std::uint64_t distance = i < 10 ? (std::uint64_t{1} << 33) + i : (rng() >> (rng() % 60)) % (1u << 26);
+    deadlines.push_back(1000 + distance);
+    wheel.schedule(deadlines.back(), i);
+  }
+
+  std::vector<std::uint64_t> fired_at(deadlines.size(), 0);
+  const auto record = [&](std::uint64_t i) { fired_at[i] = wheel.now(); };
+  // Uneven steps: a timer must fire on its exact tick no matter how advance() is called.
+  std::uint64_t t = 1000;
+  while (wheel.size() > 10) wheel.advance(t += 1 + rng() % 70000, record);
+  for (std::size_t i = 10; i < deadlines.size(); ++i) {
+    EXPECT_EQ(fired_at[i], std::max<std::uint64_t>(deadlines[i], 1001)) << i;
+  }
+  wheel.advance((std::uint64_t{1} << 33) + 2000, record);
+  for (std::size_t i = 0; i < 10; ++i) EXPECT_EQ(fired_at[i], deadlines[i]) << i;
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheel, CancelledAndStaleHandlesNeverFire) {
+  util::TimerWheel<int> wheel;
+  const auto a = wheel.schedule(5, 1);
+  const auto b = wheel.schedule(300, 2);
+  wheel.schedule(3, 3);
+  EXPECT_TRUE(wheel.cancel(b));
+  EXPECT_FALSE(wheel.cancel(b));
+
+  std::vector<int> fired;
+  EXPECT_EQ(wheel.advance(10, [&](int v) { fired.push_back(v); }), 2u);
+  EXPECT_EQ(fired, (std::vector<int>{3, 1}));
+  EXPECT_FALSE(wheel.cancel(a)); // already fired; its node may be reused below
+
+  const auto c = wheel.schedule(4, 4); // overdue: fires on the next advance
+  EXPECT_FALSE(wheel.cancel(a));
+  wheel.advance(11, [&](int v) { fired.push_back(v); });
+  EXPECT_EQ(fired.back(), 4);
+  EXPECT_FALSE(wheel.cancel(c));
+  wheel.advance(1000, [&](int) { FAIL(); });
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(SeatHoldService, HoldBlocksTheSeatUntilConfirmedOrExpired) {
+  FakeClock clock;
+  infrastructure::AtomicIdGenerator ids;
+  infrastructure::InMemoryFlightRepository flights;
+  infrastructure::InMemoryReservationRepository reservations;
+  const auto flight_id = ids.next_flight_id();
+  flights.upsert(domain::Flight(flight_id, domain::AirportCode("WAW"), domain::AirportCode("FRA"), clock.now(), 10, 6));
+  application::BookingService booking{flights, reservations, ids, clock};
+  application::SeatHoldService holds{flights, reservations, ids, clock};
+  const domain::OrderId order{42};
+
+  const auto held = holds.hold_seat(flight_id, domain::Seat{1, 'A'}, 5min);
+  ASSERT_TRUE(held.success);
+  EXPECT_EQ(held.hold->expires_at, clock.now() + 5min);
+  EXPECT_FALSE(holds.hold_seat(flight_id, domain::Seat{1, 'A'}, 5min).success);
+  EXPECT_FALSE(booking.book_seat({flight_id, order, domain::Seat{1, 'A'}}).success);
+  EXPECT_TRUE(reservations.list_by_order(order).empty());
+
+  clock.advance(4min);
+  const auto confirmed = holds.confirm_hold(held.hold->id, order);
+  ASSERT_TRUE(confirmed.success);
+  EXPECT_EQ(confirmed.reservation->seat(), (domain::Seat{1, 'A'}));
+  EXPECT_EQ(reservations.list_by_order(order).size(), 1u);
+  EXPECT_FALSE(holds.confirm_hold(held.hold->id, order).success);
+
+  // Confirmed seats stay booked after the original deadline.
+  clock.advance(10min);
+  EXPECT_EQ(holds.expire_due(), 0u);
+  EXPECT_EQ(flights.available_count(flight_id), 59u);
+
+  // An unconfirmed hold comes back on its own, and a late confirm fails.
+  const auto lapsed = holds.hold_seat(flight_id, domain::Seat{2, 'B'}, 30s);
+  const auto kept = holds.hold_seat(flight_id, domain::Seat{2, 'C'}, 2min);
+  ASSERT_TRUE(lapsed.success && kept.success);
+  clock.advance(29s);
+  EXPECT_EQ(holds.expire_due(), 0u);
+  clock.advance(1s);
+  EXPECT_EQ(holds.expire_due(), 1u);
+  EXPECT_EQ(holds.active_holds(), 1u);
+  EXPECT_EQ(flights.available_count(flight_id), 58u);
+  EXPECT_FALSE(holds.confirm_hold(lapsed.hold->id, order).success);
+
+  // Expired but not yet swept: confirm refuses and releases the seat itself.
+  clock.advance(2min);
+  EXPECT_FALSE(holds.confirm_hold(kept.hold->id, order).success);
+  EXPECT_EQ(flights.available_count(flight_id), 59u);
+  EXPECT_EQ(holds.active_holds(), 0u);
+}
+
+TEST(SeatHoldService, ReleaseAndDestructionGiveSeatsBack) {
+  FakeClock clock;
+  infrastructure::AtomicIdGenerator ids;
+  infrastructure::InMemoryFlightRepository flights;
+  infrastructure::InMemoryReservationRepository reservations;
+  const auto flight_id = ids.next_flight_id();
+  flights.upsert(domain::Flight(flight_id, domain::AirportCode("WAW"), domain::AirportCode("FRA"), clock.now(), 10, 6));
+  {
+    application::SeatHoldService holds{flights, reservations, ids, clock};
+    EXPECT_FALSE(holds.hold_seat(flight_id, domain::Seat{1, 'A'}, 0s).success);
+    EXPECT_FALSE(holds.hold_seat(domain::FlightId{999}, domain::Seat{1, 'A'}, 1min).success);
+
+    const auto released = holds.hold_seat(flight_id, domain::Seat{1, 'A'}, 1min);
+    ASSERT_TRUE(released.success);
+    EXPECT_TRUE(holds.release_hold(released.hold->id));
+    EXPECT_FALSE(holds.release_hold(released.hold->id));
+    EXPECT_EQ(flights.available_count(flight_id), 60u);
+
+    for (char letter = 'A'; letter <= 'F'; ++letter) {
+      ASSERT_TRUE(holds.hold_seat(flight_id, domain::Seat{3, letter}, 1h).success);
+    }
+    EXPECT_EQ(flights.available_count(flight_id), 54u);
+  }
+  EXPECT_EQ(flights.available_count(flight_id), 60u);
+  EXPECT_TRUE(reservations.list_by_flight(flight_id).empty());
+}
@@ -0,0 +1,133 @@
+#include "flight/application/booking_service.hpp"
+#include "flight/infrastructure/atomic_id_generator.hpp"
+#include "flight/infrastructure/flight_repository_factory.hpp"
+#include "flight/infrastructure/in_memory_reservation_repository.hpp"
+#include "flight/infrastructure/system_clock.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace flight;
+
+namespace {
+
+const infrastructure::FlightRepoType kRepoTypes[] = {
+    infrastructure::FlightRepoType::InMemory,
+    infrastructure::FlightRepoType::LockFree,
+    infrastructure::FlightRepoType::Sqlite,
+};
+
+// 10 rows x 7 seats = 70 seats, so the seat map spans two 64-bit words.
+domain::Flight make_flight(domain::FlightId id) {
+  return domain::Flight(id, domain::AirportCode("WAW"), domain::AirportCode("FRA"),
+                        std::chrono::system_clock::now(), 10, 7);
+}
+
+} // namespace
+
+TEST(SeatSelection, AvailabilityAndFirstFreeSeats) {
+  for (const auto type : kRepoTypes) {
+    auto flights = infrastructure::make_flight_repository(type);
+    const auto f = make_flight(domain::FlightId{1});
+    flights->upsert(f);
+
+    EXPECT_FALSE(flights->available_count(domain::FlightId{2}).has_value());
+    EXPECT_TRUE(flights->first_free_seats(domain::FlightId{2}, 3).empty());
+    EXPECT_EQ(flights->available_count(f.id()), 70u);
+
+    ASSERT_TRUE(flights->try_book_seat(f.id(), domain::Seat{1, 'A'}));
+    ASSERT_TRUE(flights->try_book_seat(f.id(), domain::Seat{1, 'C'}));
+    EXPECT_EQ(flights->available_count(f.id()), 68u);
+    EXPECT_EQ(flights->first_free_seats(f.id(), 3),
+              (std::vector<domain::Seat>{{1, 'B'}, {1, 'D'}, {1, 'E'}}));
+
+    // Fill everything up to the last row; the free seats then all live in the second word.
+    for (std::uint16_t row = 1; row <= 9; ++row) {
+      for (char letter = 'A'; letter <= 'G'; ++letter) flights->try_book_seat(f.id(), domain::Seat{row, letter});
+    }
+    const auto tail = flights->first_free_seats(f.id(), 100);
+    ASSERT_EQ(tail.size(), 7u);
+    EXPECT_EQ(tail.front(), (domain::Seat{10, 'A'}));
+    EXPECT_EQ(tail.back(), (domain::Seat{10, 'G'}));
+  }
+}
+
+TEST(SeatSelection, BookAnySeatFillsFlightInSeatOrder) {
+  for (const auto type : kRepoTypes) {
+    infrastructure::AtomicIdGenerator ids;
+    infrastructure::SystemClock clock;
+    infrastructure::InMemoryReservationRepository reservations;
+    auto flights = infrastructure::make_flight_repository(type);
+    const auto f = make_flight(ids.next_flight_id());
+    flights->upsert(f);
+    application::BookingService booking{*flights, reservations, ids, clock};
+
+    ASSERT_TRUE(flights->try_book_seat(f.id(), domain::Seat{1, 'A'}));
+    const auto first = booking.book_any_seat({f.id(), ids.next_order_id()});
+    ASSERT_TRUE(first.success);
+    EXPECT_EQ(first.reservation->seat(), (domain::Seat{1, 'B'}));
+
+    for (int i = 0; i < 68; ++i) ASSERT_TRUE(flights->book_any_seat(f.id()).has_value());
+    EXPECT_EQ(flights->available_count(f.id()), 0u);
+    EXPECT_FALSE(flights->book_any_seat(f.id()).has_value());
+    EXPECT_FALSE(booking.book_any_seat({f.id(), ids.next_order_id()}).success);
+    EXPECT_FALSE(flights->book_any_seat(domain::FlightId{999}).has_value());
+  }
+}
+
+TEST(SeatSelection, ConcurrentBookAnySeatNeverHandsOutTheSameSeat) {
+  for (const auto type : kRepoTypes) {
+    auto flights = infrastructure::make_flight_repository(type);
+    const auto f = make_flight(domain::FlightId{1});
+    flights->upsert(f);
+
+    constexpr int kThreads = 4;
+    std::vector<std::vector<domain::Seat>> got(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&, t] {
+        while (const auto seat = flights->book_any_seat(f.id())) got[t].push_back(*seat);
+      });
+    }
+    for (auto& th : threads) th.join();
+
+    std::set<domain::Seat> unique;
+    for (const auto& seats : got) unique.insert(seats.begin(), seats.end());
+    std::size_t total = 0;
+    for (const auto& seats : got) total += seats.size();
+    EXPECT_EQ(total, 70u);
+    EXPECT_EQ(unique.size(), 70u);
+  }
+}
+
+TEST(SeatSelection, BookAdjacentSeatsIsAllOrNothing) {
+  for (const auto type : kRepoTypes) {
+    infrastructure::AtomicIdGenerator ids;
+    infrastructure::SystemClock clock;
+    infrastructure::InMemoryReservationRepository reservations;
+    auto flights = infrastructure::make_flight_repository(type);
+    const auto f = make_flight(ids.next_flight_id());
+    flights->upsert(f);
+    application::BookingService booking{*flights, reservations, ids, clock};
+
+    // Row 1 keeps A-B and E-G free; the group of three gets the tightest run, E-G.
+    ASSERT_TRUE(flights->try_book_seats(f.id(), std::vector<domain::Seat>{{1, 'C'}, {1, 'D'}}));
+    const auto order_id = ids.next_order_id();
+    const auto res = booking.book_adjacent_seats({f.id(), order_id, 3});
+    ASSERT_TRUE(res.success);
+    ASSERT_EQ(res.reservations.size(), 3u);
+    EXPECT_EQ(res.reservations.front().seat(), (domain::Seat{1, 'E'}));
+    EXPECT_EQ(res.reservations.back().seat(), (domain::Seat{1, 'G'}));
+    EXPECT_EQ(reservations.list_by_order(order_id).size(), 3u);
+
+    EXPECT_TRUE(flights->book_adjacent_seats(f.id(), 66).empty()); // only 65 left
+    EXPECT_EQ(flights->available_count(f.id()), 65u);
+    EXPECT_EQ(flights->book_adjacent_seats(f.id(), 65).size(), 65u);
+    EXPECT_FALSE(booking.book_adjacent_seats({f.id(), order_id, 0}).success);
+    EXPECT_TRUE(flights->book_adjacent_seats(domain::FlightId{999}, 1).empty());
+  }
+}
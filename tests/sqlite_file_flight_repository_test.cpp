@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include "flight/infrastructure/flight_repository_factory.hpp"
+#include "flight/infrastructure/sqlite_flight_repository.hpp"
+
+#include <sqlite3.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Unique database path under the temp directory; removes the database and its WAL files on exit.
+class TempDatabase {
+public:
+  TempDatabase()
+      : path_(std::filesystem::temp_directory_path() /
+              ("flight_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) +
+               ".db")) {}
+  ~TempDatabase() {
+    for (const char* suffix : {"", "-wal", "-shm"}) {
+      std::error_code ec;
+      std::filesystem::remove(path_.string() + suffix, ec);
+    }
+  }
+
+  std::string path() const { return path_.string(); }
+
+private:
+  std::filesystem::path path_;
+};
+
+} // namespace
+
+TEST(SqliteFileFlightRepository, ReadersRunConcurrentlyWithBookings) {
+  TempDatabase db;
+  flight::infrastructure::SqliteOptions options;
+  options.path = db.path();
+  options.reader_connections = 3;
+  flight::infrastructure::SqliteFlightRepository repo(options);
+
+  const auto now = std::chrono::system_clock::now();
+  for (std::uint64_t id = 1; id <= 4; ++id) {
+    repo.upsert(flight::domain::Flight(flight::domain::FlightId{id}, flight::domain::AirportCode("WAW"),
+                                       flight::domain::AirportCode("FRA"), now, 10, 6));
+  }
+
+  std::atomic<bool> done{false};
+  std::atomic<int> reads{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&] {
+      do {
+        const auto results =
+            repo.search({flight::domain::AirportCode("WAW"), flight::domain::AirportCode("FRA")});
+        EXPECT_EQ(results.size(), 4u);
+        reads.fetch_add(1);
+      } while (!done.load());
+    });
+  }
+
+  int booked = 0;
+  for (std::uint16_t row = 1; row <= 10; ++row) {
+    for (char letter = 'A'; letter <= 'F'; ++letter) {
+      booked += repo.try_book_seat(flight::domain::FlightId{1}, flight::domain::Seat{row, letter}) ? 1 : 0;
+    }
+  }
+  done = true;
+  for (auto& t : readers) t.join();
+
+  EXPECT_EQ(booked, 60);
+  EXPECT_GT(reads.load(), 0);
+  const auto got = repo.get(flight::domain::FlightId{1});
+  ASSERT_TRUE(got.has_value());
+  EXPECT_EQ(got->available_count(), 0u);
+}
+
+TEST(SqliteFileFlightRepository, ReadersDoNotWaitForABlockedWriter) {
+  TempDatabase db;
+  flight::infrastructure::SqliteOptions options;
+  options.path = db.path();
+  options.reader_connections = 2;
+  flight::infrastructure::SqliteFlightRepository repo(options);
+  const flight::domain::FlightId id{1};
+  repo.upsert(flight::domain::Flight(id, flight::domain::AirportCode("WAW"), flight::domain::AirportCode("FRA"),
+                                     std::chrono::system_clock::now(), 10, 6));
+
+  // Another connection holds the database write lock, so the repository's writer stalls inside try_book_seat
+  // (holding its writer mutex, in SQLite's busy handler) until that transaction ends.
+  sqlite3* other = nullptr;
+  ASSERT_EQ(sqlite3_open(db.path().c_str(), &other), SQLITE_OK);
+  ASSERT_EQ(sqlite3_exec(other, "BEGIN IMMEDIATE;", nullptr, nullptr, nullptr), SQLITE_OK);
+
+  std::atomic<bool> writer_done{false};
+  std::thread writer([&] {
+    EXPECT_TRUE(repo.try_book_seat(id, flight::domain::Seat{1, 'A'}));
+    writer_done = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  // Had reads queued behind the writer, they could only finish after it did.
+  for (int i = 0; i < 10; ++i) {
+    const auto got = repo.get(id);
+    ASSERT_TRUE(got.has_value());
+    EXPECT_FALSE(got->is_booked(flight::domain::Seat{1, 'A'}));
+    EXPECT_EQ(repo.search({flight::domain::AirportCode("WAW"), flight::domain::AirportCode("FRA")}).size(), 1u);
+  }
+  EXPECT_FALSE(writer_done.load());
+
+  ASSERT_EQ(sqlite3_exec(other, "COMMIT;", nullptr, nullptr, nullptr), SQLITE_OK);
+  writer.join();
+  sqlite3_close(other);
+  EXPECT_TRUE(repo.get(id)->is_booked(flight::domain::Seat{1, 'A'}));
+}
+
+TEST(SqliteFileFlightRepository, DataSurvivesReopen) {
+  TempDatabase db;
+  flight::infrastructure::FlightRepoConfig config;
+  config.sqlite_file.path = db.path();
+  config.sqlite_file.synchronous = "FULL";
+
+  {
+    auto repo = flight::infrastructure::make_flight_repository(
+        flight::infrastructure::parse_flight_repo_type("sqlite-file"), config);
+    EXPECT_TRUE(repo->durable());
+    EXPECT_FALSE(flight::infrastructure::SqliteFlightRepository().durable());
+    repo->upsert(flight::domain::Flight(flight::domain::FlightId{7}, flight::domain::AirportCode("WAW"),
+                                        flight::domain::AirportCode("CDG"), std::chrono::system_clock::now(), 5, 4));
+    ASSERT_TRUE(repo->try_book_seat(flight::domain::FlightId{7}, flight::domain::Seat{2, 'B'}));
+  }
+
+  flight::infrastructure::SqliteFlightRepository reopened(config.sqlite_file);
+  const auto got = reopened.get(flight::domain::FlightId{7});
+  ASSERT_TRUE(got.has_value());
+  EXPECT_TRUE(got->is_booked(flight::domain::Seat{2, 'B'}));
+}
@@ -6,6 +6,7 @@
 
 #include <chrono>
 #include <future>
+#include <utility>
 
 namespace {
 
@@ -70,3 +71,80 @@ TEST(SqliteFlightRepositoryRegression, GetAfterBookingReturnsBookedSeatState) {
   ASSERT_TRUE(got.has_value());
   EXPECT_TRUE(got->is_booked(flight::domain::Seat{1, 'A'}));
 }
+
+TEST(SqliteFlightRepositoryRegression, SearchSummariesCountBookedSeats) {
+  flight::infrastructure::AtomicIdGenerator ids;
+  flight::infrastructure::SqliteFlightRepository repo(/*in_memory=*/true);
+
+  const auto flight = make_test_flight(ids, "WAW", "FRA");
+  repo.upsert(flight);
+  repo.upsert(make_test_flight(ids, "WAW", "CDG"));
+  ASSERT_TRUE(repo.try_book_seat(flight.id(), flight::domain::Seat{1, 'A'}));
+  ASSERT_TRUE(repo.try_book_seat(flight.id(), flight::domain::Seat{2, 'B'}));
+
+  const auto summaries = repo.search_summaries(
+      {flight::domain::AirportCode("WAW"), flight::domain::AirportCode("FRA")});
+  ASSERT_EQ(summaries.size(), 1u);
+  EXPECT_EQ(summaries.front().id, flight.id());
+  EXPECT_EQ(summaries.front().capacity, 60u);
+  EXPECT_EQ(summaries.front().available, 58u);
+}
+
+TEST(SqliteFlightRepositoryRegression, SearchRebuildsSeatStatePerFlight) {
+  flight::infrastructure::AtomicIdGenerator ids;
+  flight::infrastructure::SqliteFlightRepository repo(/*in_memory=*/true);
+
+  const auto a = make_test_flight(ids, "WAW", "FRA");
+  const auto b = make_test_flight(ids, "WAW", "FRA");
+  const auto c = make_test_flight(ids, "WAW", "FRA");
+  repo.upsert(a);
+  repo.upsert(b);
+  repo.upsert(c);
+  ASSERT_TRUE(repo.try_book_seat(a.id(), flight::domain::Seat{1, 'A'}));
+  ASSERT_TRUE(repo.try_book_seat(a.id(), flight::domain::Seat{2, 'C'}));
+  ASSERT_TRUE(repo.try_book_seat(c.id(), flight::domain::Seat{10, 'F'}));
+
+  const auto results = repo.search({flight::domain::AirportCode("WAW"), flight::domain::AirportCode("FRA")});
+  ASSERT_EQ(results.size(), 3u);
+  EXPECT_EQ(results[0].id(), a.id());
+  EXPECT_EQ(results[0].booked_count(), 2u);
+  EXPECT_TRUE(results[0].is_booked(flight::domain::Seat{2, 'C'}));
+  EXPECT_EQ(results[1].id(), b.id());
+  EXPECT_EQ(results[1].booked_count(), 0u);
+  EXPECT_EQ(results[2].id(), c.id());
+  EXPECT_TRUE(results[2].is_booked(flight::domain::Seat{10, 'F'}));
+
+  EXPECT_FALSE(repo.get(flight::domain::FlightId{999}).has_value());
+}
+
+TEST(SqliteFlightRepositoryRegression, SearchHonoursDepartureWindowAndLimit) {
+  flight::infrastructure::SqliteFlightRepository repo(/*in_memory=*/true);
+
+  const auto base = std::chrono::system_clock::time_point{std::chrono::hours(24 * 20000)};
+  const std::pair<std::uint64_t, int> schedule[] = {{5, 30}, {1, 50}, {4, 30}, {9, 10}, {2, 75}};
+  for (const auto& [id, hours] : schedule) {
+    repo.upsert(flight::domain::Flight(flight::domain::FlightId{id}, flight::domain::AirportCode("WAW"),
+                                       flight::domain::AirportCode("FRA"), base + std::chrono::hours(hours), 10, 6));
+  }
+  ASSERT_TRUE(repo.try_book_seat(flight::domain::FlightId{4}, flight::domain::Seat{1, 'A'}));
+  ASSERT_TRUE(repo.try_book_seat(flight::domain::FlightId{4}, flight::domain::Seat{1, 'B'}));
+
+  flight::application::FlightSearchCriteria c{flight::domain::AirportCode("WAW"), flight::domain::AirportCode("FRA")};
+  c.departure_from = base + std::chrono::hours(24);
+  c.limit = 2;
+
+  // The limit counts flights, not joined seat rows.
+  const auto results = repo.search(c);
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_EQ(results[0].id(), flight::domain::FlightId{4});
+  EXPECT_EQ(results[0].booked_count(), 2u);
+  EXPECT_EQ(results[1].id(), flight::domain::FlightId{5});
+
+  c.departure_to = base + std::chrono::hours(50);
+  c.limit = 0;
+  const auto summaries = repo.search_summaries(c);
+  ASSERT_EQ(summaries.size(), 2u);
+  EXPECT_EQ(summaries[0].id, flight::domain::FlightId{4});
+  EXPECT_EQ(summaries[0].available, 58u);
+  EXPECT_EQ(summaries[1].id, flight::domain::FlightId{5});
+}